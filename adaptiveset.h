@@ -0,0 +1,670 @@
+#ifndef _ADAPTIVESET_H_
+#define _ADAPTIVESET_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "avltree.h"
+#include "flatset.h"
+#include "setops.h"
+
+/* AdaptiveSet
+
+   Bob Burrough, 2021
+
+   A set which changes its representation to suit its size and workload:
+
+   - Inline: up to InlineCapacity items in a sorted array inside the set
+     object itself. No allocation at all.
+   - Tree: past InlineCapacity items, an AVLTree.
+   - Frozen: after Freeze(), a FlatSet, which is the fastest to search
+     and iterate. The next Insert() or Remove() thaws it back to a tree.
+
+   Every migration is a bulk build from the sorted items of the old
+   representation (see AVLTree::InsertSorted() and FlatSet::InsertSorted()),
+   O(N), never a series of single insertions. GetStats() reports the
+   current representation and how many migrations have happened. The
+   three representations share storage in a union, so a set pays for
+   the largest of them rather than all three. */
+
+template<class T, size_t InlineCapacity = 8>
+class AdaptiveSet
+{
+public:
+    enum class Representation { Inline, Tree, Frozen };
+
+    struct Stats
+    {
+        Representation representation;
+        size_t promotions; // Inline to Tree
+        size_t freezes; // Tree to Frozen
+        size_t thaws; // Frozen to Tree
+    };
+
+    AdaptiveSet();
+    virtual ~AdaptiveSet(); // custom destructor (rule of 5)
+    AdaptiveSet(const AdaptiveSet& other) = delete; // AVLTree can't be copied.
+    AdaptiveSet<T, InlineCapacity>& operator=(const AdaptiveSet& other) = delete;
+    AdaptiveSet(AdaptiveSet<T, InlineCapacity>&& other); // move constructor (rule of 5)
+    AdaptiveSet<T, InlineCapacity>& operator=(AdaptiveSet&& other); // move assignment operator (rule of 5)
+
+    // Place an item in the set. O(InlineCapacity) while inline, O(log N) as a tree.
+    void Insert(const T& item);
+
+    // Remove item from the set. O(InlineCapacity) while inline, O(log N) as a tree.
+    void Remove(const T& item);
+
+    // Retrieve item from the set. O(log N)
+    bool Search(const T& item) const;
+
+    // Retrieve the stored item which is equal to the given one, or nullptr. O(log N)
+    template<typename U>
+    const T* Find(const U& item) const;
+
+    // Merge a range sorted in ascending order into the set. O(N + M)
+    template<typename U>
+    void InsertSorted(const U& sortedRange);
+
+    // Create the intersection of this set with any sorted range. See SortedRange::ForEachCommon().
+    template<typename U>
+    AdaptiveSet<T, InlineCapacity> Intersect(const U& other) const;
+
+    /* Move a tree into a FlatSet, for read-mostly use. An inline set is
+       already a sorted array, and is left as it is. O(N) */
+    void Freeze();
+
+    Stats GetStats() const;
+
+    // Returns the number of items in the set. O(1)
+    size_t Size() const;
+
+    // Empties the set, which returns to the inline representation.
+    void Clear();
+
+    /* Consistency check. Returns true if the set
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+protected:
+private:
+    // A sorted array as a range, for bulk building from the inline items.
+    class Span
+    {
+    public:
+        Span(const T* first_, size_t count_) : first(first_), count(count_) {}
+        const T* begin() const { return first; }
+        const T* end() const { return first + count; }
+        size_t Size() const { return count; }
+    private:
+        const T* first;
+        size_t count;
+    };
+
+    T* InlineItems();
+    const T* InlineItems() const;
+    static const AVLTree<T>& EmptyTree(); // For the unused tree iterator of an array iterator.
+    template<typename U>
+    size_t InlinePosition(const U& item) const; // Index of the first inline item not less than item. A binary search.
+    void DestroyInline();
+    void Destroy(); // Ends the lifetime of the current representation's storage.
+    void MoveFrom(AdaptiveSet& other); // This set must be empty and inline.
+    void Promote(); // Inline to Tree
+    void Thaw(); // Frozen to Tree
+
+    Representation representation;
+    size_t inlineSize;
+    union // Only the member for the current representation is alive.
+    {
+        alignas(T) unsigned char inlineStorage[sizeof(T) * InlineCapacity];
+        AVLTree<T> tree;
+        FlatSet<T> frozen;
+    };
+    size_t promotions;
+    size_t freezes;
+    size_t thaws;
+
+    // Iterator declarations
+public:
+    class ConstIterator
+    {
+    public:
+        ConstIterator(const T* pointer_, const T* last_, const AVLTree<T>& tree_); // Over an array.
+        ConstIterator(const typename AVLTree<T>::ConstIterator& treeItr_); // Over a tree.
+        ConstIterator& operator++();
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+        // Advance to the first item which is not less than the given item. O(log D)
+        template<typename U>
+        ConstIterator& Seek(const U& item);
+
+    protected:
+    private:
+        const T* pointer;
+        const T* last;
+        typename AVLTree<T>::ConstIterator treeItr;
+        bool inTree;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+
+/* An AVLTree with a small-buffer optimization: up to N items are kept in a
+   sorted array inside the object, and node storage is used only once they
+   overflow. Insert, Remove, Search, Find, InsertSorted, Size and iteration
+   behave as they do for AVLTree.
+
+   It is an AdaptiveSet, not an AVLTree, so:
+   - The inline array shares storage with the tree, but the object also
+     holds a vtable pointer, the representation, the inline size and
+     AdaptiveSet's counters. On a 64-bit build SmallAVLTree<int> (N = 8) is
+     80 bytes against 24 for AVLTree<int>, whether or not it has spilled.
+   - Intersect() returns an AdaptiveSet<T, N>, not an AVLTree<T>.
+   - There is no Augmentation, Aggregate(), IntersectAll() or
+     IntersectUnsorted().
+   Use it where most sets stay small and allocations cost more than the
+   extra bytes per object. */
+template<class T, size_t N = 8>
+using SmallAVLTree = AdaptiveSet<T, N>;
+
+
+template<class T, size_t InlineCapacity>
+AdaptiveSet<T, InlineCapacity>::AdaptiveSet()
+    : representation(Representation::Inline), inlineSize(0), promotions(0), freezes(0), thaws(0)
+{}
+
+
+template<class T, size_t InlineCapacity>
+AdaptiveSet<T, InlineCapacity>::~AdaptiveSet()
+{
+    Destroy();
+}
+
+
+template<class T, size_t InlineCapacity>
+AdaptiveSet<T, InlineCapacity>::AdaptiveSet(AdaptiveSet<T, InlineCapacity>&& other) // move constructor
+    : representation(Representation::Inline), inlineSize(0), promotions(0), freezes(0), thaws(0)
+{
+    MoveFrom(other);
+}
+
+
+template<class T, size_t InlineCapacity>
+AdaptiveSet<T, InlineCapacity>& AdaptiveSet<T, InlineCapacity>::operator=(AdaptiveSet&& other) // move assignment operator
+{
+    if (this == &other)
+        return *this;
+    Clear();
+    MoveFrom(other);
+    return *this;
+}
+
+
+template<class T, size_t InlineCapacity>
+void AdaptiveSet<T, InlineCapacity>::MoveFrom(AdaptiveSet& other)
+{
+    switch (other.representation)
+    {
+    case Representation::Tree:
+        new (&tree) AVLTree<T>(std::move(other.tree));
+        break;
+    case Representation::Frozen:
+        new (&frozen) FlatSet<T>(std::move(other.frozen));
+        break;
+    default:
+        for (size_t i = 0; i < other.inlineSize; i++)
+            new (InlineItems() + i) T(std::move(other.InlineItems()[i]));
+        inlineSize = other.inlineSize;
+        break;
+    }
+    representation = other.representation;
+    promotions = other.promotions;
+    freezes = other.freezes;
+    thaws = other.thaws;
+    other.Clear();
+}
+
+
+template<class T, size_t InlineCapacity>
+void AdaptiveSet<T, InlineCapacity>::Insert(const T& item)
+{
+    if (representation == Representation::Frozen)
+        Thaw();
+    if (representation == Representation::Tree)
+    {
+        tree.Insert(item);
+        return;
+    }
+
+    size_t position = InlinePosition(item);
+    T* items = InlineItems();
+    if (position < inlineSize && !(item < items[position]))
+        return; // They're equal.
+    if (inlineSize == InlineCapacity)
+    {
+        Promote();
+        tree.Insert(item);
+        return;
+    }
+
+    // Shift the tail up by one, then overwrite the vacated slot.
+    if (position == inlineSize)
+    {
+        new (items + inlineSize) T(item);
+    }
+    else
+    {
+        T copy(item); // item may refer into this set.
+        new (items + inlineSize) T(std::move(items[inlineSize - 1]));
+        for (size_t i = inlineSize - 1; i > position; i--)
+            items[i] = std::move(items[i - 1]);
+        items[position] = std::move(copy);
+    }
+    inlineSize++;
+}
+
+
+template<class T, size_t InlineCapacity>
+void AdaptiveSet<T, InlineCapacity>::Remove(const T& item)
+{
+    if (representation == Representation::Frozen)
+        Thaw();
+    if (representation == Representation::Tree)
+    {
+        tree.Remove(item);
+        return;
+    }
+
+    size_t position = InlinePosition(item);
+    T* items = InlineItems();
+    if (position == inlineSize || item < items[position])
+        return; // The set doesn't contain the specified item.
+    for (size_t i = position + 1; i < inlineSize; i++)
+        items[i - 1] = std::move(items[i]);
+    inlineSize--;
+    items[inlineSize].~T();
+}
+
+
+template<class T, size_t InlineCapacity>
+bool AdaptiveSet<T, InlineCapacity>::Search(const T& item) const
+{
+    return Find(item) != nullptr;
+}
+
+
+template<class T, size_t InlineCapacity>
+template<typename U>
+const T* AdaptiveSet<T, InlineCapacity>::Find(const U& item) const
+{
+    switch (representation)
+    {
+    case Representation::Tree:
+        return tree.Find(item);
+    case Representation::Frozen:
+        return frozen.Find(item);
+    default:
+        break;
+    }
+
+    const T* items = InlineItems();
+    size_t position = InlinePosition(item);
+    return position < inlineSize && !(item < items[position]) ? items + position : nullptr;
+}
+
+
+template<class T, size_t InlineCapacity>
+template<typename U>
+void AdaptiveSet<T, InlineCapacity>::InsertSorted(const U& sortedRange)
+{
+    size_t rangeSize = SortedRange::Size(sortedRange);
+    if (representation == Representation::Inline && rangeSize != SortedRange::UnknownSize && inlineSize + rangeSize <= InlineCapacity)
+    {
+        for (SortedRangeIterator<U> itr = SortedRange::Begin(sortedRange); itr != SortedRange::End(sortedRange); ++itr)
+            Insert(*itr);
+        return;
+    }
+    if (representation == Representation::Inline)
+        Promote();
+    else if (representation == Representation::Frozen)
+        Thaw();
+    tree.InsertSorted(sortedRange);
+}
+
+
+template<class T, size_t InlineCapacity>
+template<typename U>
+AdaptiveSet<T, InlineCapacity> AdaptiveSet<T, InlineCapacity>::Intersect(const U& other) const
+{
+    FlatSet<T> common;
+    SortedRange::ForEachCommon(*this, other, [&common](const T& item)
+    {
+        common.Insert(item); // Arrives in order, so this appends.
+        return true;
+    });
+    AdaptiveSet<T, InlineCapacity> intersection;
+    intersection.InsertSorted(common);
+    return intersection;
+}
+
+
+template<class T, size_t InlineCapacity>
+void AdaptiveSet<T, InlineCapacity>::Freeze()
+{
+    if (representation != Representation::Tree)
+        return;
+    FlatSet<T> items; // Built beside the tree, whose storage it then takes over.
+    items.InsertSorted(tree);
+    tree.~AVLTree<T>();
+    new (&frozen) FlatSet<T>(std::move(items));
+    representation = Representation::Frozen;
+    freezes++;
+}
+
+
+template<class T, size_t InlineCapacity>
+void AdaptiveSet<T, InlineCapacity>::Promote()
+{
+    AVLTree<T> items; // Built beside the inline items, whose storage it then takes over.
+    items.InsertSorted(Span(InlineItems(), inlineSize));
+    DestroyInline();
+    new (&tree) AVLTree<T>(std::move(items));
+    representation = Representation::Tree;
+    promotions++;
+}
+
+
+template<class T, size_t InlineCapacity>
+void AdaptiveSet<T, InlineCapacity>::Thaw()
+{
+    AVLTree<T> items; // Built beside the array, whose storage it then takes over.
+    items.InsertSorted(frozen);
+    frozen.~FlatSet<T>();
+    new (&tree) AVLTree<T>(std::move(items));
+    representation = Representation::Tree;
+    thaws++;
+}
+
+
+template<class T, size_t InlineCapacity>
+typename AdaptiveSet<T, InlineCapacity>::Stats AdaptiveSet<T, InlineCapacity>::GetStats() const
+{
+    Stats stats;
+    stats.representation = representation;
+    stats.promotions = promotions;
+    stats.freezes = freezes;
+    stats.thaws = thaws;
+    return stats;
+}
+
+
+template<class T, size_t InlineCapacity>
+size_t AdaptiveSet<T, InlineCapacity>::Size() const
+{
+    switch (representation)
+    {
+    case Representation::Tree:
+        return tree.Size();
+    case Representation::Frozen:
+        return frozen.Size();
+    default:
+        return inlineSize;
+    }
+}
+
+
+template<class T, size_t InlineCapacity>
+void AdaptiveSet<T, InlineCapacity>::Clear()
+{
+    Destroy();
+    representation = Representation::Inline;
+}
+
+
+template<class T, size_t InlineCapacity>
+T* AdaptiveSet<T, InlineCapacity>::InlineItems()
+{
+    return reinterpret_cast<T*>(inlineStorage);
+}
+
+
+template<class T, size_t InlineCapacity>
+const T* AdaptiveSet<T, InlineCapacity>::InlineItems() const
+{
+    return reinterpret_cast<const T*>(inlineStorage);
+}
+
+
+template<class T, size_t InlineCapacity>
+template<typename U>
+size_t AdaptiveSet<T, InlineCapacity>::InlinePosition(const U& item) const
+{
+    const T* items = InlineItems();
+    size_t position = 0;
+    size_t count = inlineSize;
+    while (count > 0)
+    {
+        size_t half = count / 2;
+        if (items[position + half] < item)
+        {
+            position += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+    return position;
+}
+
+
+template<class T, size_t InlineCapacity>
+void AdaptiveSet<T, InlineCapacity>::DestroyInline()
+{
+    T* items = InlineItems();
+    for (size_t i = 0; i < inlineSize; i++)
+        items[i].~T();
+    inlineSize = 0;
+}
+
+
+template<class T, size_t InlineCapacity>
+void AdaptiveSet<T, InlineCapacity>::Destroy()
+{
+    switch (representation)
+    {
+    case Representation::Tree:
+        tree.~AVLTree<T>();
+        break;
+    case Representation::Frozen:
+        frozen.~FlatSet<T>();
+        break;
+    default:
+        DestroyInline();
+        break;
+    }
+}
+
+
+template<class T, size_t InlineCapacity>
+const AVLTree<T>& AdaptiveSet<T, InlineCapacity>::EmptyTree()
+{
+    static const AVLTree<T> empty;
+    return empty;
+}
+
+
+template<class T, size_t InlineCapacity>
+AdaptiveSet<T, InlineCapacity>::ConstIterator::ConstIterator(const T* pointer_, const T* last_, const AVLTree<T>& tree_)
+    : pointer(pointer_), last(last_), treeItr(tree_, true), inTree(false)
+{}
+
+
+template<class T, size_t InlineCapacity>
+AdaptiveSet<T, InlineCapacity>::ConstIterator::ConstIterator(const typename AVLTree<T>::ConstIterator& treeItr_)
+    : pointer(nullptr), last(nullptr), treeItr(treeItr_), inTree(true)
+{}
+
+
+template<class T, size_t InlineCapacity>
+typename AdaptiveSet<T, InlineCapacity>::ConstIterator& AdaptiveSet<T, InlineCapacity>::ConstIterator::operator++()
+{
+    if (inTree)
+        ++treeItr;
+    else
+        ++pointer;
+    return *this;
+}
+
+
+template<class T, size_t InlineCapacity>
+bool AdaptiveSet<T, InlineCapacity>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    if (inTree != other.inTree)
+        return true;
+    return inTree ? treeItr != other.treeItr : pointer != other.pointer;
+}
+
+
+template<class T, size_t InlineCapacity>
+const T& AdaptiveSet<T, InlineCapacity>::ConstIterator::operator*() const
+{
+    return inTree ? *treeItr : *pointer;
+}
+
+
+template<class T, size_t InlineCapacity>
+template<typename U>
+typename AdaptiveSet<T, InlineCapacity>::ConstIterator& AdaptiveSet<T, InlineCapacity>::ConstIterator::Seek(const U& item)
+{
+    if (inTree)
+    {
+        treeItr.Seek(item);
+        return *this;
+    }
+    // Gallop forward to bracket the item, then binary search the bracket.
+    size_t remaining = last - pointer;
+    size_t step = 1;
+    while (step <= remaining && pointer[step - 1] < item)
+        step *= 2;
+    size_t low = step / 2;
+    size_t high = step <= remaining ? step - 1 : remaining;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (pointer[middle] < item)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    pointer += low;
+    return *this;
+}
+
+
+template<class T, size_t InlineCapacity>
+typename AdaptiveSet<T, InlineCapacity>::ConstIterator AdaptiveSet<T, InlineCapacity>::begin() const
+{
+    switch (representation)
+    {
+    case Representation::Tree:
+        return ConstIterator(tree.begin());
+    case Representation::Frozen:
+        return ConstIterator(frozen.begin(), frozen.end(), EmptyTree());
+    default:
+        return ConstIterator(InlineItems(), InlineItems() + inlineSize, EmptyTree());
+    }
+}
+
+
+template<class T, size_t InlineCapacity>
+typename AdaptiveSet<T, InlineCapacity>::ConstIterator AdaptiveSet<T, InlineCapacity>::end() const
+{
+    switch (representation)
+    {
+    case Representation::Tree:
+        return ConstIterator(tree.end());
+    case Representation::Frozen:
+        return ConstIterator(frozen.end(), frozen.end(), EmptyTree());
+    default:
+        return ConstIterator(InlineItems() + inlineSize, InlineItems() + inlineSize, EmptyTree());
+    }
+}
+
+
+template<class T, size_t InlineCapacity>
+bool AdaptiveSet<T, InlineCapacity>::IsValid() const
+{
+    // Only the current representation is alive; check it.
+    switch (representation)
+    {
+    case Representation::Tree:
+        if (inlineSize != 0 || !tree.IsValid())
+            return false;
+        break;
+    case Representation::Frozen:
+        if (inlineSize != 0 || !frozen.IsValid())
+            return false;
+        break;
+    default:
+        if (inlineSize > InlineCapacity)
+            return false;
+        for (size_t i = 1; i < inlineSize; i++)
+        {
+            if (!(InlineItems()[i - 1] < InlineItems()[i]))
+                return false;
+        }
+        break;
+    }
+    return true;
+}
+
+
+template class AdaptiveSet<int>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -0,0 +1,1146 @@
+#ifndef _ARTSET_H_
+#define _ARTSET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ARTSET_SSE2
+#endif
+
+/* ARTSet
+
+   Bob Burrough, 2021
+
+   Set of byte strings stored in an adaptive radix tree (Leis, Kemper and
+   Neumann, "The Adaptive Radix Tree: ARTful Indexing for Main-Memory
+   Databases", 2013). Each level of the tree consumes one byte of the key,
+   so Search, Insert and Remove cost O(key length) whatever the number of
+   keys, and no comparison ever starts again from the first byte, which is
+   where a tree of strings spends its time when the keys share long
+   prefixes (URLs, paths).
+
+   Inner nodes come in four sizes, each used only while its children fit:
+
+   - Node4 and Node16: sorted arrays of key bytes and children. Node16 is
+     searched with SSE2 where available.
+   - Node48: a 256 entry table of byte to child slot, and 48 children.
+   - Node256: a child for every byte.
+
+   Chains of nodes with a single child are collapsed into a prefix stored
+   in the node below (path compression). Up to MaxPrefixLength bytes of it
+   are kept in the node; longer prefixes are checked against a leaf, which
+   holds the whole key. A key which ends where others continue is kept in
+   the node's terminal slot.
+
+   Iteration is in ascending order of the keys' bytes compared as unsigned
+   values, the same order as std::string's operator<(), so an ARTSet is a
+   sorted range for the trees' Intersect() and InsertSorted(). WithPrefix()
+   iterates over only the keys starting with a given prefix. Nodes don't
+   point to their parents, so ++ descends again from the top of the range
+   to the current key's successor, O(key length), and allocates nothing.
+
+   T may be std::string or anything else with size(), operator[] and
+   operator== which holds bytes. */
+
+template<class T = std::string>
+class ARTSet
+{
+public:
+    ARTSet();
+    virtual ~ARTSet(); // custom destructor (rule of 5)
+    ARTSet(const ARTSet<T>& other) = delete; // copy constructor (rule of 5)
+    ARTSet<T>& operator=(const ARTSet<T>& other) = delete; // copy assignment operator (rule of 5)
+    ARTSet(ARTSet<T>&& other); // move constructor (rule of 5)
+    ARTSet<T>& operator=(ARTSet<T>&& other); // move assignment operator (rule of 5)
+
+    // Place a key in the set. O(key length)
+    void Insert(const T& key);
+
+    // Remove key from the set. O(key length)
+    void Remove(const T& key);
+
+    // Retrieve key from the set. O(key length)
+    bool Search(const T& key) const;
+
+    // Retrieve the stored key which is equal to the given one, or nullptr. O(key length)
+    const T* Find(const T& key) const;
+
+    // Returns the number of keys in the set. O(1)
+    size_t Size() const;
+
+    void Clear();
+
+    /* Consistency check. Returns true if the tree
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+    static const size_t MaxPrefixLength = 8; // Bytes of a compressed path kept in the node itself.
+
+protected:
+private:
+    enum class Kind : uint8_t { Leaf, Node4, Node16, Node48, Node256 };
+
+    class Node
+    {
+    public:
+        Node(Kind kind_) : kind(kind_) {}
+        Kind kind;
+    };
+
+    class Leaf : public Node
+    {
+    public:
+        Leaf(const T& key_) : Node(Kind::Leaf), key(key_) {}
+        T key;
+    };
+
+    class Inner : public Node
+    {
+    public:
+        Inner(Kind kind_) : Node(kind_), count(0), prefixLength(0), terminal(nullptr) {}
+        uint16_t count; // Number of children.
+        uint32_t prefixLength; // Length of the compressed path above this node's children. Destroy(): the next byte to visit.
+        uint8_t prefix[MaxPrefixLength]; // The first bytes of the compressed path.
+        union
+        {
+            Leaf* terminal; // The key which ends at this node, if any.
+            Inner* up; // Destroy() only: the node to return to once this one is deleted.
+        };
+    };
+
+    class Node4 : public Inner
+    {
+    public:
+        Node4() : Inner(Kind::Node4) {}
+        uint8_t keys[4];
+        Node* children[4];
+    };
+
+    class Node16 : public Inner
+    {
+    public:
+        Node16() : Inner(Kind::Node16) {}
+        uint8_t keys[16];
+        Node* children[16];
+    };
+
+    class Node48 : public Inner
+    {
+    public:
+        Node48() : Inner(Kind::Node48) { memset(index, 0, sizeof(index)); memset(children, 0, sizeof(children)); }
+        uint8_t index[256]; // Slot + 1 of the child for each byte, or 0.
+        Node* children[48];
+    };
+
+    class Node256 : public Inner
+    {
+    public:
+        Node256() : Inner(Kind::Node256) { memset(children, 0, sizeof(children)); }
+        Node* children[256];
+    };
+
+    static uint8_t Byte(const T& key, size_t i) { return static_cast<uint8_t>(key[i]); }
+
+    static Node** FindChild(Inner* node, uint8_t byte);
+    static const Node* FindChild(const Inner* node, uint8_t byte);
+
+    // The first child whose byte is not less than from (0 to 256), or nullptr. Sets byte to its byte.
+    static const Node* NextChild(const Inner* node, int from, int& byte);
+
+    // Add a child to the node at ref, replacing the node with a larger one if it's full.
+    static void AddChild(Node** ref, uint8_t byte, Node* child);
+
+    // Remove the child for byte from the node at ref, and replace the node with a smaller one if it's sparse enough.
+    static void RemoveChild(Node** ref, uint8_t byte);
+
+    // Replace the node at ref with its only entry if it has no more than one (child or terminal).
+    static void Collapse(Node** ref);
+
+    static void CopyHeader(Inner* to, const Inner* from);
+    static const Leaf* MinimumLeaf(const Node* node);
+
+    // Set the node's compressed path to key[depth, depth + length).
+    static void SetPrefix(Inner* node, const T& key, size_t depth, size_t length);
+
+    // Length of the common part of the node's compressed path and key[depth, ...).
+    static size_t PrefixMismatch(const Inner* node, const T& key, size_t depth);
+
+    const Leaf* FindLeaf(const T& key) const;
+    static void Destroy(Node* node);
+    static Inner* Enter(Node* node, Inner* up); // Destroy(): delete a leaf, or prepare an inner node for emptying.
+
+    Node* root;
+    size_t size;
+
+    // Iterator declarations
+public:
+    class ConstIterator
+    {
+    public:
+        ConstIterator(const Node* subtree_, size_t depth_); // Positioned at the first key of the subtree, whose path starts at key byte depth_. nullptr is the end.
+        ConstIterator& operator++();
+        bool operator==(const ConstIterator& other) const;
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+    protected:
+    private:
+        const Node* subtree; // The top of the range.
+        size_t depth; // Key bytes above subtree.
+        const Leaf* leaf;
+    };
+
+    // The keys which begin with a given prefix, in ascending order.
+    class PrefixRange
+    {
+    public:
+        PrefixRange(const Node* subtree_, size_t depth_);
+        ConstIterator begin() const;
+        ConstIterator end() const;
+
+    protected:
+    private:
+        const Node* subtree;
+        size_t depth;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+    // Iterate over the keys beginning with prefix. Finding the first costs O(prefix length).
+    PrefixRange WithPrefix(const T& prefix) const;
+};
+
+
+template<class T>
+ARTSet<T>::ARTSet()
+    : root(nullptr), size(0)
+{}
+
+
+template<class T>
+ARTSet<T>::~ARTSet()
+{
+    Clear();
+}
+
+
+template<class T>
+ARTSet<T>::ARTSet(ARTSet<T>&& other)
+    : root(other.root), size(other.size)
+{
+    other.root = nullptr;
+    other.size = 0;
+}
+
+
+template<class T>
+ARTSet<T>& ARTSet<T>::operator=(ARTSet<T>&& other)
+{
+    if (this != &other)
+    {
+        Clear();
+        root = other.root;
+        size = other.size;
+        other.root = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+
+template<class T>
+void ARTSet<T>::Insert(const T& key)
+{
+    Node** ref = &root;
+    size_t depth = 0;
+    for (;;)
+    {
+        Node* node = *ref;
+        if (node == nullptr)
+        {
+            *ref = new Leaf(key);
+            size++;
+            return;
+        }
+
+        if (node->kind == Kind::Leaf)
+        {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            if (leaf->key == key)
+                return; // Duplicate. Ignored.
+
+            // Split the leaf: a new node holds the common part of the two keys as its prefix.
+            size_t common = 0;
+            while (depth + common < key.size() && depth + common < leaf->key.size() && Byte(key, depth + common) == Byte(leaf->key, depth + common))
+                common++;
+            Node4* split = new Node4();
+            SetPrefix(split, key, depth, common);
+            depth += common;
+            Leaf* added = new Leaf(key);
+            Node* splitNode = split;
+            if (depth == leaf->key.size())
+                split->terminal = leaf;
+            else
+                AddChild(&splitNode, Byte(leaf->key, depth), leaf);
+            if (depth == key.size())
+                split->terminal = added;
+            else
+                AddChild(&splitNode, Byte(key, depth), added);
+            *ref = splitNode;
+            size++;
+            return;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        if (inner->prefixLength > 0)
+        {
+            size_t matched = PrefixMismatch(inner, key, depth);
+            if (matched < inner->prefixLength)
+            {
+                // The key leaves the compressed path part way along. Split the path there.
+                const T& path = MinimumLeaf(inner)->key; // Holds the whole path.
+                Node4* split = new Node4();
+                SetPrefix(split, path, depth, matched);
+                uint8_t branch = Byte(path, depth + matched);
+                SetPrefix(inner, path, depth + matched + 1, inner->prefixLength - matched - 1);
+                Node* splitNode = split;
+                AddChild(&splitNode, branch, inner);
+                Leaf* added = new Leaf(key);
+                if (depth + matched == key.size())
+                    split->terminal = added;
+                else
+                    AddChild(&splitNode, Byte(key, depth + matched), added);
+                *ref = splitNode;
+                size++;
+                return;
+            }
+            depth += inner->prefixLength;
+        }
+
+        if (depth == key.size())
+        {
+            if (inner->terminal == nullptr)
+            {
+                inner->terminal = new Leaf(key);
+                size++;
+            }
+            return;
+        }
+
+        Node** child = FindChild(inner, Byte(key, depth));
+        if (child == nullptr)
+        {
+            AddChild(ref, Byte(key, depth), new Leaf(key));
+            size++;
+            return;
+        }
+        ref = child;
+        depth++;
+    }
+}
+
+
+template<class T>
+void ARTSet<T>::Remove(const T& key)
+{
+    Node** ref = &root;
+    size_t depth = 0;
+    while (*ref != nullptr)
+    {
+        Node* node = *ref;
+        if (node->kind == Kind::Leaf)
+        {
+            // Only reached for a leaf at the root. Leaves below are removed from their parent.
+            if (static_cast<Leaf*>(node)->key == key)
+            {
+                delete static_cast<Leaf*>(node);
+                *ref = nullptr;
+                size--;
+            }
+            return;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        if (PrefixMismatch(inner, key, depth) < inner->prefixLength)
+            return; // The set doesn't contain the specified key.
+        depth += inner->prefixLength;
+
+        if (depth == key.size())
+        {
+            if (inner->terminal == nullptr)
+                return;
+            delete inner->terminal;
+            inner->terminal = nullptr;
+            size--;
+            Collapse(ref);
+            return;
+        }
+
+        Node** child = FindChild(inner, Byte(key, depth));
+        if (child == nullptr)
+            return;
+        if ((*child)->kind == Kind::Leaf)
+        {
+            Leaf* leaf = static_cast<Leaf*>(*child);
+            if (!(leaf->key == key))
+                return;
+            delete leaf;
+            RemoveChild(ref, Byte(key, depth));
+            size--;
+            return;
+        }
+        ref = child;
+        depth++;
+    }
+}
+
+
+template<class T>
+bool ARTSet<T>::Search(const T& key) const
+{
+    return FindLeaf(key) != nullptr;
+}
+
+
+template<class T>
+const T* ARTSet<T>::Find(const T& key) const
+{
+    const Leaf* leaf = FindLeaf(key);
+    return leaf ? &leaf->key : nullptr;
+}
+
+
+template<class T>
+const typename ARTSet<T>::Leaf* ARTSet<T>::FindLeaf(const T& key) const
+{
+    const Node* node = root;
+    size_t depth = 0;
+    while (node != nullptr)
+    {
+        if (node->kind == Kind::Leaf)
+        {
+            const Leaf* leaf = static_cast<const Leaf*>(node);
+            return leaf->key == key ? leaf : nullptr;
+        }
+
+        // Check only the stored part of the path. The leaf's full key is compared at the end.
+        const Inner* inner = static_cast<const Inner*>(node);
+        size_t stored = inner->prefixLength < MaxPrefixLength ? inner->prefixLength : MaxPrefixLength;
+        for (size_t i = 0; i < stored; i++)
+        {
+            if (depth + i >= key.size() || Byte(key, depth + i) != inner->prefix[i])
+                return nullptr;
+        }
+        depth += inner->prefixLength;
+
+        if (depth >= key.size())
+            return depth == key.size() && inner->terminal != nullptr && inner->terminal->key == key ? inner->terminal : nullptr;
+        node = FindChild(inner, Byte(key, depth));
+        depth++;
+    }
+    return nullptr;
+}
+
+
+template<class T>
+size_t ARTSet<T>::Size() const
+{
+    return size;
+}
+
+
+template<class T>
+void ARTSet<T>::Clear()
+{
+    if (root != nullptr)
+        Destroy(root);
+    root = nullptr;
+    size = 0;
+}
+
+
+template<class T>
+void ARTSet<T>::Destroy(Node* node)
+{
+    /* Depth first, without a stack. Once an inner node's terminal is deleted its
+       slot holds the node above it, and prefixLength the next byte to visit. */
+    Inner* current = Enter(node, nullptr);
+    while (current != nullptr)
+    {
+        int byte = 0;
+        const Node* child = NextChild(current, current->prefixLength, byte);
+        if (child != nullptr)
+        {
+            current->prefixLength = byte + 1;
+            Inner* inner = Enter(const_cast<Node*>(child), current);
+            if (inner != nullptr)
+                current = inner;
+            continue;
+        }
+
+        Inner* up = current->up;
+        switch (current->kind)
+        {
+        case Kind::Node4: delete static_cast<Node4*>(current); break;
+        case Kind::Node16: delete static_cast<Node16*>(current); break;
+        case Kind::Node48: delete static_cast<Node48*>(current); break;
+        default: delete static_cast<Node256*>(current); break;
+        }
+        current = up;
+    }
+}
+
+
+template<class T>
+typename ARTSet<T>::Inner* ARTSet<T>::Enter(Node* node, Inner* up)
+{
+    if (node->kind == Kind::Leaf)
+    {
+        delete static_cast<Leaf*>(node);
+        return nullptr;
+    }
+    Inner* inner = static_cast<Inner*>(node);
+    delete inner->terminal;
+    inner->up = up;
+    inner->prefixLength = 0;
+    return inner;
+}
+
+
+
+
+template<class T>
+typename ARTSet<T>::Node** ARTSet<T>::FindChild(Inner* node, uint8_t byte)
+{
+    switch (node->kind)
+    {
+    case Kind::Node4:
+        {
+            Node4* node4 = static_cast<Node4*>(node);
+            for (int i = 0; i < node4->count; i++)
+            {
+                if (node4->keys[i] == byte)
+                    return &node4->children[i];
+            }
+            return nullptr;
+        }
+    case Kind::Node16:
+        {
+            Node16* node16 = static_cast<Node16*>(node);
+#ifdef ARTSET_SSE2
+            // Compare all sixteen key bytes at once.
+            __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(node16->keys)));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches)) & ((1u << node16->count) - 1);
+            if (mask == 0)
+                return nullptr;
+            int i = 0;
+            while ((mask & 1) == 0)
+            {
+                mask >>= 1;
+                i++;
+            }
+            return &node16->children[i];
+#else
+            for (int i = 0; i < node16->count; i++)
+            {
+                if (node16->keys[i] == byte)
+                    return &node16->children[i];
+            }
+            return nullptr;
+#endif
+        }
+    case Kind::Node48:
+        {
+            Node48* node48 = static_cast<Node48*>(node);
+            return node48->index[byte] ? &node48->children[node48->index[byte] - 1] : nullptr;
+        }
+    default:
+        {
+            Node256* node256 = static_cast<Node256*>(node);
+            return node256->children[byte] ? &node256->children[byte] : nullptr;
+        }
+    }
+}
+
+
+template<class T>
+const typename ARTSet<T>::Node* ARTSet<T>::FindChild(const Inner* node, uint8_t byte)
+{
+    Node** child = FindChild(const_cast<Inner*>(node), byte);
+    return child ? *child : nullptr;
+}
+
+
+template<class T>
+const typename ARTSet<T>::Node* ARTSet<T>::NextChild(const Inner* node, int from, int& byte)
+{
+    switch (node->kind)
+    {
+    case Kind::Node4:
+    case Kind::Node16:
+        {
+            // Node4 and Node16 differ only in capacity; both keep their keys sorted.
+            const uint8_t* keys = node->kind == Kind::Node4 ? static_cast<const Node4*>(node)->keys : static_cast<const Node16*>(node)->keys;
+            Node* const* children = node->kind == Kind::Node4 ? static_cast<const Node4*>(node)->children : static_cast<const Node16*>(node)->children;
+            for (int i = 0; i < node->count; i++)
+            {
+                if (keys[i] >= from)
+                {
+                    byte = keys[i];
+                    return children[i];
+                }
+            }
+            return nullptr;
+        }
+    case Kind::Node48:
+        {
+            const Node48* node48 = static_cast<const Node48*>(node);
+            for (int i = from; i < 256; i++)
+            {
+                if (node48->index[i])
+                {
+                    byte = i;
+                    return node48->children[node48->index[i] - 1];
+                }
+            }
+            return nullptr;
+        }
+    default:
+        {
+            const Node256* node256 = static_cast<const Node256*>(node);
+            for (int i = from; i < 256; i++)
+            {
+                if (node256->children[i])
+                {
+                    byte = i;
+                    return node256->children[i];
+                }
+            }
+            return nullptr;
+        }
+    }
+}
+
+
+template<class T>
+void ARTSet<T>::CopyHeader(Inner* to, const Inner* from)
+{
+    to->count = from->count;
+    to->prefixLength = from->prefixLength;
+    memcpy(to->prefix, from->prefix, MaxPrefixLength);
+    to->terminal = from->terminal;
+}
+
+
+template<class T>
+void ARTSet<T>::AddChild(Node** ref, uint8_t byte, Node* child)
+{
+    Inner* node = static_cast<Inner*>(*ref);
+    switch (node->kind)
+    {
+    case Kind::Node4:
+    case Kind::Node16:
+        {
+            int capacity = node->kind == Kind::Node4 ? 4 : 16;
+            uint8_t* keys = node->kind == Kind::Node4 ? static_cast<Node4*>(node)->keys : static_cast<Node16*>(node)->keys;
+            Node** children = node->kind == Kind::Node4 ? static_cast<Node4*>(node)->children : static_cast<Node16*>(node)->children;
+            if (node->count < capacity)
+            {
+                int i = node->count;
+                for (; i > 0 && keys[i - 1] > byte; i--)
+                {
+                    keys[i] = keys[i - 1];
+                    children[i] = children[i - 1];
+                }
+                keys[i] = byte;
+                children[i] = child;
+                node->count++;
+                return;
+            }
+            if (node->kind == Kind::Node4)
+            {
+                Node16* grown = new Node16();
+                CopyHeader(grown, node);
+                memcpy(grown->keys, keys, 4);
+                memcpy(grown->children, children, 4 * sizeof(Node*));
+                delete static_cast<Node4*>(node);
+                *ref = grown;
+            }
+            else
+            {
+                Node48* grown = new Node48();
+                CopyHeader(grown, node);
+                for (int i = 0; i < 16; i++)
+                {
+                    grown->index[keys[i]] = static_cast<uint8_t>(i + 1);
+                    grown->children[i] = children[i];
+                }
+                delete static_cast<Node16*>(node);
+                *ref = grown;
+            }
+            AddChild(ref, byte, child);
+            return;
+        }
+    case Kind::Node48:
+        {
+            Node48* node48 = static_cast<Node48*>(node);
+            if (node48->count < 48)
+            {
+                int slot = 0;
+                while (node48->children[slot] != nullptr)
+                    slot++;
+                node48->children[slot] = child;
+                node48->index[byte] = static_cast<uint8_t>(slot + 1);
+                node48->count++;
+                return;
+            }
+            Node256* grown = new Node256();
+            CopyHeader(grown, node48);
+            for (int i = 0; i < 256; i++)
+            {
+                if (node48->index[i])
+                    grown->children[i] = node48->children[node48->index[i] - 1];
+            }
+            delete node48;
+            *ref = grown;
+            AddChild(ref, byte, child);
+            return;
+        }
+    default:
+        {
+            Node256* node256 = static_cast<Node256*>(node);
+            node256->children[byte] = child;
+            node256->count++;
+            return;
+        }
+    }
+}
+
+
+template<class T>
+void ARTSet<T>::RemoveChild(Node** ref, uint8_t byte)
+{
+    Inner* node = static_cast<Inner*>(*ref);
+    switch (node->kind)
+    {
+    case Kind::Node4:
+    case Kind::Node16:
+        {
+            uint8_t* keys = node->kind == Kind::Node4 ? static_cast<Node4*>(node)->keys : static_cast<Node16*>(node)->keys;
+            Node** children = node->kind == Kind::Node4 ? static_cast<Node4*>(node)->children : static_cast<Node16*>(node)->children;
+            int i = 0;
+            while (keys[i] != byte)
+                i++;
+            for (node->count--; i < node->count; i++)
+            {
+                keys[i] = keys[i + 1];
+                children[i] = children[i + 1];
+            }
+            if (node->kind == Kind::Node4)
+            {
+                Collapse(ref);
+                return;
+            }
+            if (node->count > 3)
+                return;
+            Node4* shrunk = new Node4();
+            CopyHeader(shrunk, node);
+            memcpy(shrunk->keys, keys, node->count);
+            memcpy(shrunk->children, children, node->count * sizeof(Node*));
+            delete static_cast<Node16*>(node);
+            *ref = shrunk;
+            return;
+        }
+    case Kind::Node48:
+        {
+            Node48* node48 = static_cast<Node48*>(node);
+            node48->children[node48->index[byte] - 1] = nullptr;
+            node48->index[byte] = 0;
+            node48->count--;
+            if (node48->count > 12)
+                return;
+            Node16* shrunk = new Node16();
+            CopyHeader(shrunk, node48);
+            int count = 0;
+            for (int i = 0; i < 256; i++)
+            {
+                if (node48->index[i])
+                {
+                    shrunk->keys[count] = static_cast<uint8_t>(i);
+                    shrunk->children[count++] = node48->children[node48->index[i] - 1];
+                }
+            }
+            delete node48;
+            *ref = shrunk;
+            return;
+        }
+    default:
+        {
+            Node256* node256 = static_cast<Node256*>(node);
+            node256->children[byte] = nullptr;
+            node256->count--;
+            if (node256->count > 36)
+                return;
+            Node48* shrunk = new Node48();
+            CopyHeader(shrunk, node256);
+            int count = 0;
+            for (int i = 0; i < 256; i++)
+            {
+                if (node256->children[i])
+                {
+                    shrunk->children[count] = node256->children[i];
+                    shrunk->index[i] = static_cast<uint8_t>(++count);
+                }
+            }
+            delete node256;
+            *ref = shrunk;
+            return;
+        }
+    }
+}
+
+
+template<class T>
+void ARTSet<T>::Collapse(Node** ref)
+{
+    Inner* node = static_cast<Inner*>(*ref);
+    if (node->kind != Kind::Node4 || node->count + (node->terminal ? 1 : 0) > 1)
+        return;
+    Node4* node4 = static_cast<Node4*>(node);
+    if (node4->count == 0)
+    {
+        *ref = node4->terminal; // May be nullptr.
+        delete node4;
+        return;
+    }
+
+    Node* child = node4->children[0];
+    if (child->kind != Kind::Leaf)
+    {
+        // Prepend this node's path and the child's byte to the child's path.
+        Inner* inner = static_cast<Inner*>(child);
+        size_t length = node4->prefixLength + 1 + inner->prefixLength;
+        uint8_t prefix[MaxPrefixLength];
+        size_t stored = 0;
+        for (size_t i = 0; i < node4->prefixLength && stored < MaxPrefixLength; i++)
+            prefix[stored++] = node4->prefix[i];
+        if (stored < MaxPrefixLength)
+            prefix[stored++] = node4->keys[0];
+        for (size_t i = 0; i < inner->prefixLength && stored < MaxPrefixLength; i++)
+            prefix[stored++] = inner->prefix[i];
+        memcpy(inner->prefix, prefix, stored);
+        inner->prefixLength = static_cast<uint32_t>(length);
+    }
+    *ref = child;
+    delete node4;
+}
+
+
+template<class T>
+const typename ARTSet<T>::Leaf* ARTSet<T>::MinimumLeaf(const Node* node)
+{
+    while (node->kind != Kind::Leaf)
+    {
+        const Inner* inner = static_cast<const Inner*>(node);
+        if (inner->terminal != nullptr)
+            return inner->terminal;
+        int byte = 0;
+        node = NextChild(inner, 0, byte);
+    }
+    return static_cast<const Leaf*>(node);
+}
+
+
+template<class T>
+void ARTSet<T>::SetPrefix(Inner* node, const T& key, size_t depth, size_t length)
+{
+    node->prefixLength = static_cast<uint32_t>(length);
+    for (size_t i = 0; i < length && i < MaxPrefixLength; i++)
+        node->prefix[i] = Byte(key, depth + i);
+}
+
+
+template<class T>
+size_t ARTSet<T>::PrefixMismatch(const Inner* node, const T& key, size_t depth)
+{
+    size_t i = 0;
+    for (; i < node->prefixLength && i < MaxPrefixLength; i++)
+    {
+        if (depth + i >= key.size() || Byte(key, depth + i) != node->prefix[i])
+            return i;
+    }
+    if (i == node->prefixLength)
+        return i;
+
+    // The rest of the path isn't stored in the node. Every key below shares it, so read it from one.
+    const T& path = MinimumLeaf(node)->key;
+    for (; i < node->prefixLength; i++)
+    {
+        if (depth + i >= key.size() || Byte(key, depth + i) != Byte(path, depth + i))
+            return i;
+    }
+    return i;
+}
+
+
+template<class T>
+bool ARTSet<T>::IsValid() const
+{
+    if (root == nullptr)
+        return size == 0;
+
+    // Check the structure of each node, and that the stored paths agree with the keys below them.
+    struct Pending
+    {
+        const Node* node;
+        size_t depth;
+    };
+    std::vector<Pending> pending(1, Pending{ root, 0 });
+    size_t leaves = 0;
+    while (!pending.empty())
+    {
+        Pending visit = pending.back();
+        pending.pop_back();
+        if (visit.node->kind == Kind::Leaf)
+        {
+            const Leaf* leaf = static_cast<const Leaf*>(visit.node);
+            if (leaf->key.size() < visit.depth || FindLeaf(leaf->key) != leaf)
+                return false;
+            leaves++;
+            continue;
+        }
+
+        const Inner* inner = static_cast<const Inner*>(visit.node);
+        size_t entries = inner->count + (inner->terminal ? 1 : 0);
+        switch (inner->kind)
+        {
+        case Kind::Node4: if (entries < 2 || inner->count > 4) return false; break;
+        case Kind::Node16: if (inner->count < 4 || inner->count > 16) return false; break;
+        case Kind::Node48: if (inner->count < 13 || inner->count > 48) return false; break;
+        default: if (inner->count < 37 || inner->count > 256) return false; break;
+        }
+
+        const T& path = MinimumLeaf(inner)->key;
+        size_t end = visit.depth + inner->prefixLength;
+        if (path.size() < end)
+            return false;
+        for (size_t i = 0; i < inner->prefixLength && i < MaxPrefixLength; i++)
+        {
+            if (inner->prefix[i] != Byte(path, visit.depth + i))
+                return false;
+        }
+        if (inner->terminal != nullptr)
+        {
+            if (inner->terminal->key.size() != end || FindLeaf(inner->terminal->key) != inner->terminal)
+                return false;
+            leaves++;
+        }
+
+        int byte = 0;
+        int previous = -1;
+        size_t children = 0;
+        for (const Node* child = NextChild(inner, 0, byte); child != nullptr; child = NextChild(inner, byte + 1, byte))
+        {
+            if (byte <= previous)
+                return false; // Node4 and Node16 keys must be sorted.
+            previous = byte;
+            children++;
+            pending.push_back(Pending{ child, end + 1 });
+        }
+        if (children != inner->count)
+            return false;
+    }
+    if (leaves != size)
+        return false;
+
+    // Keys must come out of iteration in ascending order.
+    ConstIterator itr = begin();
+    if (itr == end())
+        return false;
+    const T* previous = &*itr;
+    for (++itr; itr != end(); ++itr)
+    {
+        if (!(*previous < *itr))
+            return false;
+        previous = &*itr;
+    }
+    return true;
+}
+
+
+template<class T>
+typename ARTSet<T>::ConstIterator ARTSet<T>::begin() const
+{
+    return ConstIterator(root, 0);
+}
+
+
+template<class T>
+typename ARTSet<T>::ConstIterator ARTSet<T>::end() const
+{
+    return ConstIterator(nullptr, 0);
+}
+
+
+template<class T>
+typename ARTSet<T>::PrefixRange ARTSet<T>::WithPrefix(const T& prefix) const
+{
+    const Node* node = root;
+    size_t depth = 0;
+    while (node != nullptr && node->kind != Kind::Leaf)
+    {
+        const Inner* inner = static_cast<const Inner*>(node);
+        if (prefix.size() <= depth + inner->prefixLength)
+            break; // The prefix ends within this node's path, so every key below may match.
+        depth += inner->prefixLength;
+        node = FindChild(inner, Byte(prefix, depth));
+        depth++;
+    }
+    if (node == nullptr)
+        return PrefixRange(nullptr, 0);
+
+    // Every key below shares the path to here, which was only checked at the branches. Check it in full with one of them.
+    const T& key = MinimumLeaf(node)->key;
+    if (key.size() < prefix.size())
+        return PrefixRange(nullptr, 0);
+    for (size_t i = 0; i < prefix.size(); i++)
+    {
+        if (Byte(key, i) != Byte(prefix, i))
+            return PrefixRange(nullptr, 0);
+    }
+    return PrefixRange(node, depth);
+}
+
+
+template<class T>
+ARTSet<T>::PrefixRange::PrefixRange(const Node* subtree_, size_t depth_)
+    : subtree(subtree_), depth(depth_)
+{}
+
+
+template<class T>
+typename ARTSet<T>::ConstIterator ARTSet<T>::PrefixRange::begin() const
+{
+    return ConstIterator(subtree, depth);
+}
+
+
+template<class T>
+typename ARTSet<T>::ConstIterator ARTSet<T>::PrefixRange::end() const
+{
+    return ConstIterator(nullptr, 0);
+}
+
+
+template<class T>
+ARTSet<T>::ConstIterator::ConstIterator(const Node* subtree_, size_t depth_)
+    : subtree(subtree_), depth(depth_), leaf(subtree_ != nullptr ? MinimumLeaf(subtree_) : nullptr)
+{}
+
+
+template<class T>
+typename ARTSet<T>::ConstIterator& ARTSet<T>::ConstIterator::operator++()
+{
+    /* Follow the current key down from the top of the range. The successor is the
+       least key under the last branch passed which leads to greater bytes. */
+    const T& key = leaf->key;
+    const Node* node = subtree;
+    const Node* successor = nullptr;
+    size_t i = depth;
+    while (node->kind != Kind::Leaf)
+    {
+        const Inner* inner = static_cast<const Inner*>(node);
+        i += inner->prefixLength;
+        int byte = 0;
+        if (i == key.size())
+        {
+            // The key is this node's terminal, which precedes all its children.
+            const Node* first = NextChild(inner, 0, byte);
+            if (first != nullptr)
+                successor = first;
+            break;
+        }
+        const Node* next = NextChild(inner, Byte(key, i) + 1, byte);
+        if (next != nullptr)
+            successor = next;
+        node = FindChild(inner, Byte(key, i));
+        i++;
+    }
+    leaf = successor != nullptr ? MinimumLeaf(successor) : nullptr;
+    return *this;
+}
+
+
+template<class T>
+bool ARTSet<T>::ConstIterator::operator==(const ConstIterator& other) const
+{
+    return leaf == other.leaf;
+}
+
+
+template<class T>
+bool ARTSet<T>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return leaf != other.leaf;
+}
+
+
+template<class T>
+const T& ARTSet<T>::ConstIterator::operator*() const
+{
+    return leaf->key;
+}
+
+
+template class ARTSet<std::string>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef _AUGMENTATION_H_
+#define _AUGMENTATION_H_
+
+#include <limits>
+
+/* Tree augmentation
+
+   Bob Burrough, 2021
+
+   Policies for augmenting the nodes of AVLTree and RBTree with an aggregate
+   of their subtrees, e.g. AVLTree<int, SumAugmentation<int>>. The tree keeps
+   each node's aggregate up to date through insertion, removal, and
+   rotation, and answers Aggregate(lo, hi) over any range of items in
+   O(log N).
+
+   A policy is a monoid over values computed from the items:
+
+       struct MaxTimestamp
+       {
+           typedef long long Value;
+           static Value Identity();                                // combining with this changes nothing
+           static Value Lift(const Event& item);                   // the value of a single item
+           static Value Combine(const Value& a, const Value& b);   // must be associative
+       };
+
+   Combine() need not be commutative. Values are always combined in the
+   order of the items they came from. */
+
+// The default. Nodes carry no aggregate, and cost nothing extra.
+struct NoAugmentation
+{
+    struct Value {};
+};
+
+
+// Storage for a node's aggregate. Tree nodes derive from this, so that NoAugmentation takes no space.
+template<class Augmentation>
+class SubtreeAggregate
+{
+public:
+    typename Augmentation::Value aggregate;
+};
+
+template<>
+class SubtreeAggregate<NoAugmentation>
+{
+};
+
+
+// Sum of the items. T must support operator+() and value initialization to zero.
+template<class T>
+struct SumAugmentation
+{
+    typedef T Value;
+    static Value Identity() { return Value(); }
+    static Value Lift(const T& item) { return item; }
+    static Value Combine(const Value& a, const Value& b) { return a + b; }
+};
+
+
+// Smallest item. Identity is the largest value of T, so an empty range yields that.
+template<class T>
+struct MinAugmentation
+{
+    typedef T Value;
+    static Value Identity() { return std::numeric_limits<T>::max(); }
+    static Value Lift(const T& item) { return item; }
+    static Value Combine(const Value& a, const Value& b) { return b < a ? b : a; }
+};
+
+
+// Largest item. Identity is the lowest value of T, so an empty range yields that.
+template<class T>
+struct MaxAugmentation
+{
+    typedef T Value;
+    static Value Identity() { return std::numeric_limits<T>::lowest(); }
+    static Value Lift(const T& item) { return item; }
+    static Value Combine(const Value& a, const Value& b) { return a < b ? b : a; }
+};
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
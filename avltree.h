@@ -1,1160 +1,1655 @@
-#ifndef _AVLTREE_H_
-#define _AVLTREE_H_
-
-
-/*  AVL tree
-
-    Bob Burrough, 2021
-
-    Single-header implementation of height-balanced binary search tree. Provides
-    O(log N) insertion, search, and delete. Does not use recursion and does not
-    allocate extra memory during iteration. The type stored in the tree must have
-    a meaningful operator==() and operator<() to facilitate storage in and
-    retrieval from the tree.
-
-    Differs from the Morris traversal edition in that each node has a pointer to
-    its parent, and the tree remains unmodified during traversal. To understand
-    which tree to select for your project:
-
-                                        Aborted    Complete          Memory
-                        Insert  Search  Traversal  Traversal         Usage
-                        ------  ------  ---------  ---------         -----
-    RBTree<T>            fast    slow     fast       fast     3 ptrs + 1 enum per node
-    RBTreeMorris<T>      slow    slow    slowest     slow             TBD
-    AVLTree<T>           fast    fast    fastest     fast     3 ptrs + 1 int per node
-    AVLTreeMorris<T>     slow    fast     slow       slow     2 ptrs + 1 int per node
-
-    Note, if you are so memory constrained that you are considering using
-    AVLTreeMorris<T>, make sure your compiler is configured for proper padding
-    and alignment to benefit from AVLTreeMorris<T>'s smaller node sizes. */
-
-template<class T>
-class AVLTree
-{
-public:
-    AVLTree();
-    virtual ~AVLTree(); // custom destructor (rule of 5)
-    //AVLTree(const AVLTree<T>& other); // copy constructor (rule of 5)
-    //AVLTree<T>& operator=(const AVLTree<T>& other); // copy assignment operator (rule of 5)
-    AVLTree(AVLTree<T>&& other); // move constructor (rule of 5)
-    AVLTree<T>& operator=(AVLTree<T>&& other); // move assignment operator (rule of 5)
-
-        /* TODO: AVLTree currently violates rule of 5. It has a custom destructor and move constructor, but does
-           not implement copy, copy-assignment, or move-assignment.
-           https://en.cppreference.com/w/cpp/language/rule_of_three#:~:text=Rule%20of%20five */
-
-    // Place an item in the tree. Complexity is O(log N).
-    void Insert(const T& item);
-
-    // Remove item from the tree. Complexity is O(log N).
-    void Remove(const T& item);
-
-    // Retrieve item from the tree. Complexity os O(log N).
-    bool Search(const T& item) const;
-
-    void Clear();
-
-    template<typename U>
-    AVLTree<T> Intersect(const U& other) const;
-
-    /* Consistency check. Returns true if the tree
-       is internally consistent. Otherwise, false. */
-    bool IsValid() const;
-
-protected:
-private:
-    class Node
-    {
-    public:
-        Node(const T& item_);
-        virtual ~Node() = default;
-
-        friend class AVLTree<T>;
-
-    protected:
-    private:
-        Node() = delete; // item must be provided
-        T item;
-        int balanceFactor;
-        Node* left;
-        Node* right;
-        Node* parent;
-
-        Node* RightRotate(); 
-        Node* LeftRotate(); 
-        Node* DoubleRightRotate();
-        Node* DoubleLeftRotate(); 
-        Node* Balance(); // Rebalances the node such that the balanceFactor becomes -1, 0, or +1.
-        unsigned int CalculateHeight() const; // For validation only.
-
-        // These are provided simply to avoid including additional headers.
-        template<class U> static const U& max(const U& a, const U& b) { return a < b ? b : a; }
-        template<class U> static const U& min(const U& a, const U& b) { return a < b ? a : b; }
-    };
-
-
-    Node* root;
-
-    
-    // Iterator declarations
-public:
-    class ConstIterator  // inorder iterator
-    {
-    public:
-        ConstIterator(const AVLTree<T>& tree_);
-        ConstIterator(const AVLTree<T>& tree_, bool end); // This constructor creates an empty iterator which is equal to end().
-        virtual ~ConstIterator();
-        /* TODO: ConstIterator currently violates rule of 5 becaues it has custom destructor but
-           no custom copy, copy-assignment, or move-assignment operators. */
-
-        ConstIterator& operator++();
-        bool operator!=(const ConstIterator& other) const;
-        const T& operator*() const;
-
-        friend class AVLTree<T>; // For access to GetNode() member function below.
-
-    protected:
-    private:
-        ConstIterator() = delete;
-        const Node* GetNode() const;
-        const AVLTree<T>& tree;
-        Node* current;
-    };    
-    ConstIterator begin() const; 
-    ConstIterator end() const;
-
-
-    class ConstPostorder // adaptor for postorder iteration
-    {
-    public:
-        ConstPostorder(const AVLTree<T>& tree);
-        virtual ~ConstPostorder();
-
-        class Iterator
-        {
-        public:
-            Iterator(const AVLTree& tree_);
-            Iterator(const AVLTree& tree_, bool end);
-            virtual ~Iterator();
-            /* TODO: ConstIterator currently violates rule of 5 becaues it has custom destructor but
-               no custom copy, move, copy-assignment, or move-assignment operators. */
-
-            Iterator& operator++();
-            bool operator!=(const Iterator& other) const;
-            const T& operator*() const;
-
-            friend class AVLTree<T>; // For access to GetNode() member function below.
-
-        protected:
-        private:
-            Iterator() = delete;
-            const Node* GetNode() const; // This is used for (eg) destruction of the tree.
-            const AVLTree<T>& tree;
-            Node* current;
-            Node* next;
-            bool downwardPhase;
-        };
-        Iterator begin() const;
-        Iterator end() const;
-
-    protected:
-    private:
-        ConstPostorder() = delete;
-        const AVLTree<T>& tree;
-    };
-};
-
-
-
-template<class T>
-AVLTree<T>::AVLTree()
-    : root(nullptr)
-{}
-
-
-template<class T>
-AVLTree<T>::~AVLTree() // custom destructor (rule of 5)
-{
-    for (typename ConstPostorder::Iterator itr = ConstPostorder(*this).begin(); itr != ConstPostorder(*this).end(); ++itr)
-        delete itr.GetNode();
-}
-
-
-template<class T>
-void AVLTree<T>::Clear()
-{
-    for (typename ConstPostorder::Iterator itr = ConstPostorder(*this).begin(); itr != ConstPostorder(*this).end(); ++itr)
-        delete itr.GetNode();
-    root = nullptr;
-}
-
-
-template<class T>
-AVLTree<T>::AVLTree(AVLTree&& other) // move constructor (rule of 5)
-    : root(nullptr)
-{
-    root = other.root;
-    other.root = nullptr;
-}
-
-
-#if 0
-template<class T>
-AVLTree<T>::AVLTree(const AVLTree<T>& other) // copy constructor (rule of 5)
-    : root(nullptr)
-{
-#warning This implementation is incomplete.
-
-}
-
-
-template<class T>
-AVLTree<T>& AVLTree<T>::operator=(const AVLTree<T>& other) // copy assignment operator (rule of 5)
-{
-#warning This implementation is incomplete.
-    Clear();
-    
-    // Construct new elements which are copies of the elements in other.
-    // Don't call Insert(). Insert does way more than is necessary. We just need to duplicate the structure
-    // that exists in other.
-    Node* current = other.root;
-    while (current != nullptr)
-    {
-        Node* node = new Node(current->item);
-        if (current == other.root)
-            root = node;
-
-
-    }
-} 
-#endif
-
-
-template<class T>
-AVLTree<T>& AVLTree<T>::operator=(AVLTree<T>&& other) // move assignment operator (rule of 5)
-{
-    Clear();
-    root = other.root;
-    other.root = nullptr;
-    return *this;
-}
-
-
-
-template<class T>
-void AVLTree<T>::Insert(const T& item)
-{
-    // TODO: defaultIterator has been eliminated. We still should be able to use some sort of a flag to ensure that no traversal pointers remain outstanding.
-    Node* node = new Node(item);
-    Node* current(root);
-    Node* previous(nullptr);
-    Node* balancePoint(nullptr);
-    Node* balancePointPredecessor(nullptr);
-    Node* balanceFactorUpdateHead(root);
-    if (current == nullptr)
-    {
-        root = node;
-        return;
-    }
-
-    while (1) // TODO: This is ugly.
-    {
-        if (item < current->item)
-        {
-            if (current->balanceFactor > 0)
-            {
-                balanceFactorUpdateHead = current;
-                if (balancePoint != nullptr)
-                    balancePoint = current;
-            }
-
-            if (current->left == nullptr)
-            {
-                current->left = node;
-                node->parent = current;
-                break;
-            }
-            else
-            {
-            /*  We're stepping down the tree. If the current node is perfectly balanced,
-                then no rotation is required, because it will still be +/- 1 levels.
-
-                If we step down a shorter path, no balance is required. Nothing we can do
-                will unbalance the tree. We can forget about any previously tracked
-                balancePoint.
-
-                If we step down a longer path, then rotation might be needed. Also, we
-                can forget all prior nodes. */
-
-                if (current->balanceFactor < 0)
-                {
-                    // We're going down the longer side.
-                    balancePointPredecessor = previous;
-                    balancePoint = current;
-                }
-                else if (current->balanceFactor > 0)
-                {
-                    // We're going down the shorter side.
-                    balancePointPredecessor = nullptr;
-                    balancePoint = nullptr;
-                }
-                previous = current;
-                current = current->left;
-            }
-        }
-        else if (item > current->item)
-        {
-            if (current->balanceFactor < 0)
-            {
-                balanceFactorUpdateHead = current;
-                if(balancePoint != nullptr)
-                    balancePoint = current;
-            }
-
-            if (current->right == nullptr)
-            {
-                current->right = node;
-                node->parent = current;
-                break;
-            }
-            else
-            {
-                if (current->balanceFactor > 0)
-                {
-                    // We're going down the longer side.
-                    balancePointPredecessor = previous;
-                    balancePoint = current;
-                }
-                else if (current->balanceFactor < 0)
-                {
-                    // We're going down the shorter side.
-                    balancePointPredecessor = nullptr;
-                    balancePoint = nullptr;
-                }
-                previous = current;
-                current = current->right;
-            }
-        }
-        else
-        {
-            // They're equal.
-            balancePoint = nullptr;
-            balanceFactorUpdateHead = nullptr;
-            delete node;
-            break;
-        }
-    }
-
-    /* If balancePoint is set, we do not want to update balanceFactor's
-       *above* that node, because we would have to pull those updates
-       back out after Balance() takes place. */
-    if (balancePoint != nullptr)
-        balanceFactorUpdateHead = balancePoint;
-        /* This is incorrectly pulling the balanceFactorUpdateHead *upward*.
-           However, I believe the problem is that balancePoint should *not*
-           be 0.1f. In fact, there should be no balancePoint at all. */
-    if (balanceFactorUpdateHead != nullptr)
-    {
-        // Update balance factors.
-        do
-        {
-            if (item < balanceFactorUpdateHead->item)
-            {
-                balanceFactorUpdateHead->balanceFactor--;
-                balanceFactorUpdateHead = balanceFactorUpdateHead->left;
-            }
-            else
-            {
-                balanceFactorUpdateHead->balanceFactor++;
-                balanceFactorUpdateHead = balanceFactorUpdateHead->right;
-            }
-        } while (balanceFactorUpdateHead != node);
-    }
-
-    if (balancePoint != nullptr) 
-    {
-        Node* substituteNode = balancePoint->Balance(); 
-        if (root == balancePoint)
-            root = substituteNode;            
-
-        if (balancePointPredecessor != nullptr)
-        {
-            substituteNode->parent = balancePointPredecessor;
-            if (balancePointPredecessor->left == balancePoint)
-                balancePointPredecessor->left = substituteNode;
-            else
-                balancePointPredecessor->right = substituteNode;
-        }
-    }
-}
- 
-
-/* A precondition for Balance is that the balanceFactor of this node
-   and its immediate descendants must be accurate (obviously). Also,
-   this node must have a balanceFactor of 2 or -2. */
-template<class T>
-typename AVLTree<T>::Node* AVLTree<T>::Node::Balance()
-{
-    Node *w(nullptr), *p(nullptr);
-    if (balanceFactor == -2) 
-    {
-        w = left;
-        if (w->balanceFactor == 1)
-            p = DoubleRightRotate();
-        else
-            p = RightRotate();
-    }
-    else if (balanceFactor == 2)
-    {
-        w = right;
-        if (w->balanceFactor == -1)
-            p = DoubleLeftRotate();
-        else
-            p = LeftRotate();
-    }
-    return p;
-}
-
-
-/* For validation only. Do not use for any other purpose.
-   Calculates the height of a tree by walking all descendant
-   nodes. */
-template<class T>
-unsigned int AVLTree<T>::Node::CalculateHeight() const
-{
-    const Node* current = this;
-    unsigned int currentHeight = 0;
-    unsigned int maxHeight = 0;
-
-    while (current->left != nullptr) // descend leftward as far as possible
-    {
-        currentHeight++;
-        current = current->left;
-    }
-
-    while (current != nullptr && current != parent)
-    {
-        if (currentHeight > maxHeight)
-            maxHeight = currentHeight;
-
-        if (current->right != nullptr) // descend rightward one step
-        {
-            current = current->right;
-            currentHeight++;
-
-            while (current->left != nullptr) // descend leftward as far as possible
-            {
-                current = current->left;
-                currentHeight++;
-            }
-        }
-        else
-        {
-            // ascend, skipping any previously visited nodes
-            while (current->parent != nullptr && current->parent->right == current && current != this)
-            {
-                current = current->parent;
-                currentHeight--;
-            }
-
-            current = current->parent;
-            currentHeight--;
-        }
-    }
-    return maxHeight;
-}
-
-
-template<class T>
-void AVLTree<T>::Remove(const T& item)
-{
-    Node* current(root);
-    Node* balancePoint(nullptr);
-    Node* balanceUpdateHead(root);
-
-    while (current != nullptr)
-    {
-        if (current->item == item)
-            break;
-
-        if (current->balanceFactor == 0) // shortening of the below here will not cause shortening above here
-            balanceUpdateHead = current;
-
-        if (item < current->item)
-        {
-
-            current = current->left;
-        }
-        else
-        {
-            current = current->right;
-        }
-    }
-    if (current == nullptr)
-        return; // The tree doesn't contain the specified item.
-
-    if (current->left == nullptr && current->right == nullptr)
-    {
-        // We're removing a bottom-most node.
-        if (current == root)
-            root = nullptr;          
-        else if (current->parent->left == current)
-        {
-            balancePoint = current->parent;
-            current->parent->balanceFactor++;
-            current->parent->left = nullptr;
-        }
-        else
-        {
-            balancePoint = current->parent;
-            current->parent->balanceFactor--;
-            current->parent->right = nullptr;
-        }
-        if (current->parent != nullptr && current->parent->balanceFactor == 0)
-        {
-            // current's tree is shorter
-            Node* predecessor = current->parent;
-            do
-            {
-                if (predecessor->parent == nullptr)
-                    break;
-
-                if (predecessor->parent->left == predecessor)
-                {
-                    predecessor->parent->balanceFactor++;
-                    if (predecessor->parent->balanceFactor == 1)
-                        break;
-                }
-                else
-                {
-                    predecessor->parent->balanceFactor--;
-                    if (predecessor->parent->balanceFactor == -1)
-                        break;
-                }
-                predecessor = predecessor->parent;
-            } while (1);
-        }
-    }
-    else if (current->left != nullptr && current->right == nullptr)
-    {
-        // The current node has only one child, which is on the left.
-        if (current == root)
-        {
-            root = current->left;
-            current->left->parent = nullptr;
-        }
-        else if (current->parent->left == current)
-        {
-            current->parent->left = current->left;
-            balancePoint = current->parent;
-            current->parent->balanceFactor++;
-            current->left->parent = current->parent;
-        }
-        else
-        {
-            current->parent->right = current->left;
-            balancePoint = current->parent;
-            current->parent->balanceFactor--;
-            current->left->parent = current->parent;
-        }
-        if (current->parent != nullptr && current->parent->balanceFactor == 0)
-        {
-            // current's tree is shorter
-            Node* predecessor = current->parent;
-            do
-            {
-                if (predecessor->parent == nullptr)
-                    break;
-
-                if (predecessor->parent->left == predecessor)
-                {
-                    predecessor->parent->balanceFactor++;
-                    if (predecessor->parent->balanceFactor == 1)
-                        break;
-                }
-                else
-                {
-                    predecessor->parent->balanceFactor--;
-                    if (predecessor->parent->balanceFactor == -1)
-                        break;
-                }
-                predecessor = predecessor->parent;
-            } while (1);
-        }
-    }
-    else if (current->left == nullptr && current->right != nullptr)
-    {
-        // The current node has only one child, which is on the right.
-        if (current == root)
-        {
-            root = current->right;
-            current->right->parent = nullptr;
-        }
-        else if (current->parent->left == current)
-        {
-            current->parent->left = current->right;
-            balancePoint = current->parent;
-            current->parent->balanceFactor++;
-            current->right->parent = current->parent;
-        }
-        else
-        {
-            current->parent->right = current->right;
-            balancePoint = current->parent;
-            current->parent->balanceFactor--;
-            current->right->parent = current->parent;
-        }
-        if (current->parent != nullptr && current->parent->balanceFactor == 0)
-        {
-            // current's tree is shorter
-            Node* predecessor = current->parent;
-            do
-            {
-                if (predecessor->parent == nullptr)
-                    break;
-
-                if (predecessor->parent->left == predecessor)
-                {
-                    predecessor->parent->balanceFactor++;
-                    if (predecessor->parent->balanceFactor == 1)
-                        break;
-                }
-                else
-                {
-                    predecessor->parent->balanceFactor--;
-                    if (predecessor->parent->balanceFactor == -1)
-                        break;
-                }
-                predecessor = predecessor->parent;
-            } while (1);
-        }
-    }
-    else
-    {
-        // current has both left and right children
-        Node* replacement = current->right;
-        bool replacementIncludesBottomMost = true;
-        // At this point, it is definitionally true that replacement includes bottom most.
-        while (replacement->left != nullptr)   // traverse to the minimum value in the right subtree
-        {
-            // We're going downward to the left.
-            if (replacement->balanceFactor >= 0)
-                replacementIncludesBottomMost = false;
-
-            replacement = replacement->left;
-        }
-
-        if (replacementIncludesBottomMost)
-        {
-            current->balanceFactor--;
-            /* At this point, this shortening could theoretically
-               cascade all the way up the tree to the root.
-               I suspect this is also true during the balancing
-               procedure below. 
-               
-               Is it definitionally true that if current's balanceFactor
-               has changed, that every balanceFactor above me should
-               also change? Answer: no. Because if current->balanceFactor
-               became -1, then current's height will not have changed.
-               However, we can be certain that if current's balanceFactor
-               became zero, that current's height has changed.
-               
-               Actually...I suspect this should happen at replacement instead
-               of at current. */
-
-            if (current->balanceFactor >= 0)
-            {
-                // current's tree is shorter
-                Node* predecessor = current;
-                do
-                {
-                    if (predecessor->parent == nullptr)
-                        break;
-
-                    if (predecessor->parent->left == predecessor)
-                    {
-                        predecessor->parent->balanceFactor++;
-                        if (predecessor->parent->balanceFactor == 1)
-                            break;
-                    }
-                    else
-                    {
-                        predecessor->parent->balanceFactor--;
-                        if (predecessor->parent->balanceFactor == -1)
-                            break;
-                    }
-                    predecessor = predecessor->parent;
-                } while (1);
-            }
-        }
-
-        replacement->left = current->left;
-        current->left->parent = replacement;
-        replacement->balanceFactor = current->balanceFactor;
-        balancePoint = replacement;
-
-        if (replacement->parent != current)
-        {
-            replacement->parent->left = replacement->right;
-            replacement->parent->balanceFactor++;
-            balancePoint = replacement->parent;
-            replacement->right = current->right;
-            current->right->parent = replacement;
-        }
-
-        if (current == root)
-        {
-            root = replacement;
-            replacement->parent = nullptr;
-        }
-        else if (current->parent->left == current)
-        {
-            current->parent->left = replacement;
-            replacement->parent = current->parent;
-        }
-        else
-        {
-            current->parent->right = replacement;
-            replacement->parent = current->parent;
-        }
-    }
-
-    delete current;
-
-    while (balancePoint != nullptr)
-    {
-        if (balancePoint->balanceFactor == -2 || balancePoint->balanceFactor == 2)
-        {
-            Node* balancePointPredecessor = balancePoint->parent;
-
-            Node* substituteNode = balancePoint->Balance();
-            if (root == balancePoint)
-                root = substituteNode;
-
-            if (balancePointPredecessor != nullptr)
-            {
-                substituteNode->parent = balancePointPredecessor;
-                if (balancePointPredecessor->left == balancePoint)
-                {
-                    balancePointPredecessor->left = substituteNode;
-                    balancePointPredecessor->balanceFactor++;
-                }
-                else
-                {
-                    balancePointPredecessor->right = substituteNode;
-                    balancePointPredecessor->balanceFactor--;
-                }
-
-                if (balancePointPredecessor->balanceFactor == 0)
-                {
-                    // current's tree is shorter
-                    Node* predecessor = balancePointPredecessor;
-                    do
-                    {
-                        if (predecessor->parent == nullptr)
-                            break;
-
-                        if (predecessor->parent->left == predecessor)
-                        {
-                            predecessor->parent->balanceFactor++;
-                            if (predecessor->parent->balanceFactor == 1)
-                                break;
-                        }
-                        else
-
-                        {
-                            predecessor->parent->balanceFactor--;
-                            if (predecessor->parent->balanceFactor == -1)
-                                break;
-                        }
-                        predecessor = predecessor->parent;
-                    } while (1);
-                }
-            }
-
-            balancePoint = balancePointPredecessor;
-        }
-        else
-            break;
-    }
-}
-
-
-template<class T>
-bool AVLTree<T>::Search(const T& item) const
-{
-    Node* current(root);
-    while (current != nullptr)
-    {
-        if (current->item == item)
-            return true;
-
-        if (item < current->item)
-            current = current->left;
-        else
-            current = current->right;
-    }
-    return false;
-}
-
-
-template<class T>
-AVLTree<T>::Node::Node(const T& item_)
-    : item(item_), balanceFactor(0), left(nullptr), right(nullptr), parent(nullptr)
-{}
-
-
-template<class T>
-typename AVLTree<T>::Node* AVLTree<T>::Node::RightRotate()
-{
-    Node* q(left);
-    if (q == nullptr) // Shouldn't happen, but we guard against it here anyway.
-        return nullptr;     
-    this->left = q->right;
-    if(q->right != nullptr)
-        q->right->parent = this;
-    q->right = this;
-    q->parent = this->parent;
-    parent = q;
-    int newBalanceThis = balanceFactor + 1 - min(q->balanceFactor, 0);
-    int newBalanceQ = q->balanceFactor + 1 + max(newBalanceThis, 0);
-    this->balanceFactor = newBalanceThis;
-    q->balanceFactor = newBalanceQ;
-    return q;
-}
-
-
-template<class T>
-typename AVLTree<T>::Node* AVLTree<T>::Node::LeftRotate()
-{
-    Node* q(right);
-    if (q == nullptr) // Shouldn't happen, but we guard against it here anyway.
-        return nullptr;
-    this->right = q->left;
-    if(q->left != nullptr)
-        q->left->parent = this;
-    q->left = this;
-    q->parent = this->parent;
-    parent = q;
-    int newBalanceThis = balanceFactor - 1 - max(q->balanceFactor, 0);
-    int newBalanceQ = q->balanceFactor - 1 + min(newBalanceThis, 0);
-    this->balanceFactor = newBalanceThis;
-    q->balanceFactor = newBalanceQ;
-    return q;
-}
-
-
-template<class T>
-typename AVLTree<T>::Node* AVLTree<T>::Node::DoubleRightRotate()
-{
-    if (left == nullptr)  // Shouldn't happen, but we guard against it here anyway.
-        return nullptr;
-    left = left->LeftRotate();
-    return RightRotate();
-}
-
-
-template<class T>
-typename AVLTree<T>::Node* AVLTree<T>::Node::DoubleLeftRotate()
-{
-    if (right == nullptr)
-        return nullptr;
-    right = right->RightRotate();
-    return LeftRotate();
-}
-
-
-template<class T>
-bool AVLTree<T>::IsValid() const
-{
-    /* - Balance factors of all nodes are -1, 0, or 1.
-       - Verify balance factors by calculating heights at all nodes.
-    */
-    for (ConstIterator itr = begin(); itr != end(); ++itr)
-    {
-        const Node* n = itr.GetNode();
-        if (n->balanceFactor != -1 && n->balanceFactor != 0 && n->balanceFactor != 1)
-            return false;
-
-        unsigned int leftHeight = n->left != nullptr ? (1 + n->left->CalculateHeight()) : 0;
-        unsigned int rightHeight = n->right != nullptr ? (1 + n->right->CalculateHeight()) : 0;
-        int calculatedBalanceFactor = rightHeight - leftHeight;
-        if (n->balanceFactor != calculatedBalanceFactor)
-            return false;
-    }
-    return true;
-}
-
-
-template<class T>
-AVLTree<T>::ConstIterator::ConstIterator(const AVLTree<T>& tree_)
-    : tree(tree_), current(tree_.root)
-{
-    if (tree_.root == nullptr)
-        return;
-
-    while (current->left != nullptr)
-        current = current->left;
-}
-
-
-template<class T>
-AVLTree<T>::ConstIterator::ConstIterator(const AVLTree<T>& tree_, bool end)
-    : tree(tree_), current(nullptr)
-{
-    end = true; // TODO: Reconsider the constructors for end() iterators.
-}
-
-
-template<class T>
-AVLTree<T>::ConstIterator::~ConstIterator()
-{}
-
-
-template<class T>
-typename AVLTree<T>::ConstIterator& AVLTree<T>::ConstIterator::operator++()
-{
-    if (current->right != nullptr)
-    {
-        current = current->right;
-        while (current->left != nullptr)
-            current = current->left;
-    }
-    else
-    {
-        while (current->parent != nullptr && current->parent->right == current)
-            current = current->parent;
-
-        current = current->parent;
-    }
-
-    return *this;
-}
-
-
-template<class T>
-bool AVLTree<T>::ConstIterator::operator!=(const ConstIterator& other) const
-{
-    return current != other.current;
-}
-
-
-template<class T>
-const T& AVLTree<T>::ConstIterator::operator*() const
-{
-    return current->item;
-}
-
-
-template<class T>
-const typename AVLTree<T>::Node* AVLTree<T>::ConstIterator::GetNode() const
-{
-    return current;
-}
-
-
-template<class T>
-typename AVLTree<T>::ConstIterator AVLTree<T>::begin() const
-{    
-    return ConstIterator(*this);
-}
-
-
-template<class T>
-typename AVLTree<T>::ConstIterator AVLTree<T>::end() const
-{
-    return ConstIterator(*this, true);
-}
-
-
-
-template<class T>
-AVLTree<T>::ConstPostorder::ConstPostorder(const AVLTree<T>& tree_)
-    : tree(tree_)
-{}
-
-
-template<class T>
-AVLTree<T>::ConstPostorder::~ConstPostorder() {}
-
-
-template<class T>
-AVLTree<T>::ConstPostorder::Iterator::~Iterator()
-{}
-
-
-template<class T>
-AVLTree<T>::ConstPostorder::Iterator::Iterator(const AVLTree& tree_)
-    : tree(tree_), current(nullptr), next(tree_.root), downwardPhase(true)
-{
-    if (next == nullptr)
-        return;
-
-    while (next->left != nullptr) // descend leftward as far as possible
-        next = next->left;
-
-    operator++();
-}
-
-
-template<class T>
-AVLTree<T>::ConstPostorder::Iterator::Iterator(const AVLTree& tree_, bool end)
-    : tree(tree_), current(nullptr), next(nullptr), downwardPhase(true)
-{
-    end = true; // TODO: Reconsider the constructors for end() iterators.
-}
-
-
-template<class T>
-typename AVLTree<T>::ConstPostorder::Iterator& AVLTree<T>::ConstPostorder::Iterator::operator++()
-{
-    if (next == nullptr)
-        current = nullptr; // We're at the end.
-
-    while (next != nullptr)
-    {
-        if (downwardPhase)
-        {
-            if (next->right != nullptr)
-            {
-                next = next->right;
-                while (next->left != nullptr)
-                    next = next->left;
-            }
-            else
-            {
-                downwardPhase = false;
-            }
-        }
-        else
-        {
-            if (next->parent != nullptr && next->parent->right == next)
-            {
-                // stay in the upward phase
-            }
-            else
-            {
-                downwardPhase = true;
-            }
-
-            // visit
-            current = next;
-            next = next->parent;
-            break;
-        }
-    }
-    return *this;
-}
-
-
-template<class T>
-bool AVLTree<T>::ConstPostorder::Iterator::operator!=(const Iterator& other) const
-{
-    return !(current == other.current && next == other.next && downwardPhase == other.downwardPhase);
-}
-
-
-template<class T>
-const T& AVLTree<T>::ConstPostorder::Iterator::operator*() const
-{
-    return current->item;
-}
-
-
-template<class T>
-const typename AVLTree<T>::Node* AVLTree<T>::ConstPostorder::Iterator::GetNode() const
-{
-    return current;
-}
-
-
-template<class T>
-typename AVLTree<T>::ConstPostorder::Iterator AVLTree<T>::ConstPostorder::begin() const
-{
-    return Iterator(tree);
-}
-
-
-template<class T>
-typename AVLTree<T>::ConstPostorder::Iterator AVLTree<T>::ConstPostorder::end() const
-{
-    return Iterator(tree, true);
-}
-
-
-template<typename T>
-template<typename U>
-AVLTree<T> AVLTree<T>::Intersect(const U& other) const
-{
-    ConstIterator left = begin();
-    typename U::ConstIterator right = other.begin();
-    AVLTree<T> intersectionTree;
-    while (left != end() && right != other.end())
-    {
-        if (*left == *right)
-        {
-            intersectionTree.Insert(*left);
-            ++left;
-            ++right;
-        }
-        else if (*left < *right)
-            ++left;
-        else
-            ++right;
-    }
-    return intersectionTree;
-}
-/* There's a design problem with the Intersect() method. Currently it accepts
-   type U, which we assume is another tree type (either AVLTree or RBTree).
-   However, a more flexible design would accept intersections with other
-   container types such as array, vector, or list.  The way this algorithm
-   is written, it assumes that the containers are sorted. In the case of a
-   tree, this is true. However, if this code were to be given an array
-   or list, that might not be true. */
-
-
-template class AVLTree<int>; // To force compilation of the template, for compile-time validation.
-
-/*
-------------------------------------------------------------------------------
-This software is available under 2 licenses -- choose whichever you prefer.
-------------------------------------------------------------------------------
-ALTERNATIVE A - MIT License
-Copyright (c) 2021 Bobby G. Burrough
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-------------------------------------------------------------------------------
-ALTERNATIVE B - Public Domain (www.unlicense.org)
-This is free and unencumbered software released into the public domain.
-Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
-software, either in source code form or as a compiled binary, for any purpose,
-commercial or non-commercial, and by any means.
-In jurisdictions that recognize copyright laws, the author or authors of this
-software dedicate any and all copyright interest in the software to the public
-domain. We make this dedication for the benefit of the public at large and to
-the detriment of our heirs and successors. We intend this dedication to be an
-overt act of relinquishment in perpetuity of all present and future rights to
-this software under copyright law.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
-ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
-WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-------------------------------------------------------------------------------
-*/
-
+#ifndef _AVLTREE_H_
+#define _AVLTREE_H_
+
+#include <initializer_list>
+#include <type_traits>
+#include "augmentation.h"
+#include "setops.h"
+
+/*  AVL tree
+
+    Bob Burrough, 2021
+
+    Single-header implementation of height-balanced binary search tree. Provides
+    O(log N) insertion, search, and delete. Does not use recursion and does not
+    allocate extra memory during iteration. The type stored in the tree must have
+    a meaningful operator==() and operator<() to facilitate storage in and
+    retrieval from the tree.
+
+    Differs from the Morris traversal edition in that each node has a pointer to
+    its parent, and the tree remains unmodified during traversal. To understand
+    which tree to select for your project:
+
+                                        Aborted    Complete          Memory
+                        Insert  Search  Traversal  Traversal         Usage
+                        ------  ------  ---------  ---------         -----
+    RBTree<T>            fast    slow     fast       fast     3 ptrs + 1 enum per node
+    RBTreeMorris<T>      slow    slow    slowest     slow             TBD
+    AVLTree<T>           fast    fast    fastest     fast     3 ptrs + 1 int per node
+    AVLTreeMorris<T>     slow    fast     slow       slow     2 ptrs + 1 int per node
+
+    Note, if you are so memory constrained that you are considering using
+    AVLTreeMorris<T>, make sure your compiler is configured for proper padding
+    and alignment to benefit from AVLTreeMorris<T>'s smaller node sizes. */
+
+template<class T> class IntervalTree; // For access to the nodes. See intervaltree.h.
+
+template<class T, class Augmentation = NoAugmentation>
+class AVLTree
+{
+public:
+    AVLTree();
+    virtual ~AVLTree(); // custom destructor (rule of 5)
+    //AVLTree(const AVLTree<T, Augmentation>& other); // copy constructor (rule of 5)
+    //AVLTree<T, Augmentation>& operator=(const AVLTree<T, Augmentation>& other); // copy assignment operator (rule of 5)
+    AVLTree(AVLTree<T, Augmentation>&& other); // move constructor (rule of 5)
+    AVLTree<T, Augmentation>& operator=(AVLTree<T, Augmentation>&& other); // move assignment operator (rule of 5)
+
+        /* TODO: AVLTree currently violates rule of 5. It has a custom destructor and move constructor, but does
+           not implement copy, copy-assignment, or move-assignment.
+           https://en.cppreference.com/w/cpp/language/rule_of_three#:~:text=Rule%20of%20five */
+
+    // Place an item in the tree. Complexity is O(log N).
+    void Insert(const T& item);
+
+    // Remove item from the tree. Complexity is O(log N).
+    void Remove(const T& item);
+
+    // Retrieve item from the tree. Complexity os O(log N).
+    bool Search(const T& item) const;
+
+    /* Retrieve the stored item which is equal to the given one, or nullptr.
+       The argument may be of any type comparable with T, e.g. a key when T
+       is a Pair. Complexity is O(log N). */
+    template<typename U>
+    const T* Find(const U& item) const;
+
+    // Returns the number of items in the tree. O(1)
+    size_t Size() const;
+
+    void Clear();
+
+    /* Create the intersection of this tree with any sorted range (another
+       tree, a sorted List, an array, etc.). Complexity is O(N + M) when the
+       two are of similar size, and O(M log(N/M)) when one is much smaller.
+       For arithmetic T, similar sized inputs are compared a block at a time.
+       See SortedRange::ForEachCommonBlocked(). */
+    template<typename U>
+    AVLTree<T, Augmentation> Intersect(const U& other) const;
+
+    /* Create the intersection of several trees at once, e.g.
+       IntersectAll({ &a, &b, &c }). No intermediate trees are built. The
+       smallest tree is walked, and each of the others seeks forward to the
+       current candidate. When one of them leaps past the candidate, the
+       smallest tree seeks forward to meet it. */
+    static AVLTree<T, Augmentation> IntersectAll(std::initializer_list<const AVLTree<T, Augmentation>*> trees);
+
+    /* Place every item of a sorted range (another tree, a sorted List, an
+       array, etc.) in the tree. The existing nodes and the new items are
+       merged into one sorted chain, which is then rebalanced in a single
+       pass, for O(N + M) rather than O(M log(N + M)). A handful of items
+       going into a large tree are inserted one at a time instead. */
+    template<typename U>
+    void InsertSorted(const U& sortedRange);
+
+    /* Create the intersection of this tree with an unsorted range, such as
+       an unsorted List. Depending on the sizes of the two, this either looks
+       up each element of other in the tree, or goes through a temporary
+       hash set. See SortedRange::ForEachCommonUnsorted(). */
+    template<typename U>
+    AVLTree<T, Augmentation> IntersectUnsorted(const U& other) const;
+
+
+    /* Combine the values of every item x with lo <= x <= hi, in order,
+       using the tree's Augmentation (see augmentation.h). Only the nodes on
+       the paths to lo and hi are visited, so complexity is O(log N). */
+    template<typename U>
+    typename Augmentation::Value Aggregate(const U& lo, const U& hi) const;
+
+    // The aggregate of every item in the tree. O(1)
+    template<class A = Augmentation>
+    typename A::Value Aggregate() const;
+
+    /* Consistency check. Returns true if the tree
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+    template<class U> friend class IntervalTree;
+
+protected:
+private:
+    class Node : public SubtreeAggregate<Augmentation>
+    {
+    public:
+        Node(const T& item_);
+        virtual ~Node() = default;
+
+        friend class AVLTree<T, Augmentation>;
+        template<class U> friend class IntervalTree;
+
+    protected:
+    private:
+        Node() = delete; // item must be provided
+        T item;
+        int balanceFactor;
+        Node* left;
+        Node* right;
+        Node* parent;
+
+        Node* RightRotate(); 
+        Node* LeftRotate(); 
+        Node* DoubleRightRotate();
+        Node* DoubleLeftRotate(); 
+        Node* Balance(); // Rebalances the node such that the balanceFactor becomes -1, 0, or +1.
+        unsigned int CalculateHeight() const; // For validation only.
+
+        // Finger search. Returns the first node at or after from whose item is not less than the given item.
+        template<typename U> static Node* Seek(Node* from, const U& item);
+
+        // These are provided simply to avoid including additional headers.
+        template<class U> static const U& max(const U& a, const U& b) { return a < b ? b : a; }
+        template<class U> static const U& min(const U& a, const U& b) { return a < b ? a : b; }
+    };
+
+
+    Node* root;
+    size_t size;
+
+    /* Bulk construction. Nodes are gathered in sorted order into a vine (a
+       degenerate tree linked through the right pointers), which is then
+       balanced in place with the Day-Stout-Warren algorithm. This is O(N)
+       and, like traversal, uses neither recursion nor extra memory. */
+    class Vine
+    {
+    public:
+        Vine();
+        void Append(Node* node); // Overwrites the node's links.
+        Node* head;
+        Node* tail;
+        size_t count;
+    };
+    bool InsertNode(Node* node); // Links the node into the tree. Returns false, leaving it unlinked, if an equal item is already present.
+    void Detach(Node* node); // Unlinks the node from the tree and rebalances, without deleting it.
+    template<typename U> Node* FindNode(const U& item) const;
+
+    // Aggregate maintenance. These compile to nothing for NoAugmentation.
+    typedef std::integral_constant<bool, !std::is_same<Augmentation, NoAugmentation>::value> IsAugmented;
+    static void UpdateAggregate(Node* node) { UpdateAggregate(node, IsAugmented()); } // From the node's item and its children's aggregates.
+    template<class A = Augmentation> static void UpdateAggregate(Node* node, std::true_type);
+    static void UpdateAggregate(Node*, std::false_type) {}
+    static void UpdateAggregatesToRoot(Node* node) { UpdateAggregatesToRoot(node, IsAugmented()); } // The node and each of its ancestors.
+    template<class A = Augmentation> static void UpdateAggregatesToRoot(Node* node, std::true_type);
+    static void UpdateAggregatesToRoot(Node*, std::false_type) {}
+
+    void BuildFromVine(const Vine& vine); // The tree must be empty.
+    static Node* TreeToVine(Node* root); // Flattens the tree with right rotations. Parent pointers are left stale.
+    static void Compress(Node** link, size_t count); // Left rotates every other node of a vine, count times.
+    template<typename Visitor>
+    static void ForEachNodePostorder(Node* root, Visitor visitor); // visitor(node, depth). For bulk construction only.
+
+
+    // Node handle declarations
+public:
+    /* Owning handle to a node which has been taken out of a tree with
+       Extract(). The node can be placed in another tree of the same type
+       with Insert(NodeHandle&&), without allocating memory or copying the
+       item. If the handle still holds the node when it is destroyed, the
+       node is deleted. */
+    class NodeHandle
+    {
+    public:
+        NodeHandle(); // Creates an empty handle.
+        NodeHandle(NodeHandle&& other);
+        NodeHandle& operator=(NodeHandle&& other);
+        virtual ~NodeHandle();
+
+        bool Empty() const;
+
+        /* The item held by the handle. It may be modified, since it isn't in
+           a tree, e.g. to change the key before inserting it elsewhere. */
+        T& Item() const;
+
+        friend class AVLTree<T, Augmentation>;
+
+    protected:
+    private:
+        NodeHandle(Node* node_);
+        NodeHandle(const NodeHandle&) = delete;
+        NodeHandle& operator=(const NodeHandle&) = delete;
+        Node* node;
+    };
+
+    /* Take an item out of the tree without destroying it. Returns an empty
+       handle if the tree doesn't contain the item. Complexity is O(log N). */
+    NodeHandle Extract(const T& item);
+
+    /* Place the node held by the handle in the tree. No memory is allocated
+       and the item is not copied. Returns true, and leaves the handle empty,
+       on success. If an equal item is already present, returns false, and
+       the handle keeps the node. Complexity is O(log N). */
+    bool Insert(NodeHandle&& handle);
+
+    /* Move every node of other into this tree, except for those whose items
+       are already present here, which remain in other. No memory is
+       allocated and no items are copied. Both trees are flattened, merged,
+       and rebuilt in O(N + M), or if other is small, its nodes are inserted
+       one at a time. */
+    void Merge(AVLTree<T, Augmentation>& other);
+
+    
+    // Iterator declarations
+public:
+    class ConstIterator  // inorder iterator
+    {
+    public:
+        ConstIterator(const AVLTree<T, Augmentation>& tree_);
+        ConstIterator(const AVLTree<T, Augmentation>& tree_, bool end); // This constructor creates an empty iterator which is equal to end().
+        virtual ~ConstIterator();
+        /* TODO: ConstIterator currently violates rule of 5 becaues it has custom destructor but
+           no custom copy, copy-assignment, or move-assignment operators. */
+
+        ConstIterator& operator++();
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+        /* Advance to the first item which is not less than the given item.
+           Complexity is O(log D), where D is the distance travelled. */
+        template<typename U>
+        ConstIterator& Seek(const U& item);
+
+        friend class AVLTree<T, Augmentation>; // For access to GetNode() member function below.
+
+    protected:
+    private:
+        ConstIterator() = delete;
+        ConstIterator(const AVLTree<T, Augmentation>& tree_, Node* current_); // Positioned at the given node.
+        const Node* GetNode() const;
+        const AVLTree<T, Augmentation>& tree;
+        Node* current;
+    };    
+    ConstIterator begin() const; 
+    ConstIterator end() const;
+
+    // Returns an iterator to the first item which is not less than the given item. Complexity is O(log N).
+    template<typename U>
+    ConstIterator LowerBound(const U& item) const;
+
+
+    class ConstPostorder // adaptor for postorder iteration
+    {
+    public:
+        ConstPostorder(const AVLTree<T, Augmentation>& tree);
+        virtual ~ConstPostorder();
+
+        class Iterator
+        {
+        public:
+            Iterator(const AVLTree& tree_);
+            Iterator(const AVLTree& tree_, bool end);
+            virtual ~Iterator();
+            /* TODO: ConstIterator currently violates rule of 5 becaues it has custom destructor but
+               no custom copy, move, copy-assignment, or move-assignment operators. */
+
+            Iterator& operator++();
+            bool operator!=(const Iterator& other) const;
+            const T& operator*() const;
+
+            friend class AVLTree<T, Augmentation>; // For access to GetNode() member function below.
+
+        protected:
+        private:
+            Iterator() = delete;
+            const Node* GetNode() const; // This is used for (eg) destruction of the tree.
+            const AVLTree<T, Augmentation>& tree;
+            Node* current;
+            Node* next;
+            bool downwardPhase;
+        };
+        Iterator begin() const;
+        Iterator end() const;
+
+    protected:
+    private:
+        ConstPostorder() = delete;
+        const AVLTree<T, Augmentation>& tree;
+    };
+};
+
+
+/* A tree of key/value Pairs, ordered by key. Use Find(key) to retrieve a
+   value, and MergeJoin() and friends (setops.h) to combine maps. */
+template<class KeyType, class ValueType> class Pair;
+template<class KeyType, class ValueType>
+using AVLMap = AVLTree<Pair<KeyType, ValueType>>;
+
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::AVLTree()
+    : root(nullptr), size(0)
+{}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::~AVLTree() // custom destructor (rule of 5)
+{
+    for (typename ConstPostorder::Iterator itr = ConstPostorder(*this).begin(); itr != ConstPostorder(*this).end(); ++itr)
+        delete itr.GetNode();
+}
+
+
+template<class T, class Augmentation>
+void AVLTree<T, Augmentation>::Clear()
+{
+    for (typename ConstPostorder::Iterator itr = ConstPostorder(*this).begin(); itr != ConstPostorder(*this).end(); ++itr)
+        delete itr.GetNode();
+    root = nullptr;
+    size = 0;
+}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::AVLTree(AVLTree&& other) // move constructor (rule of 5)
+    : root(nullptr), size(0)
+{
+    root = other.root;
+    size = other.size;
+    other.root = nullptr;
+    other.size = 0;
+}
+
+
+#if 0
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::AVLTree(const AVLTree<T, Augmentation>& other) // copy constructor (rule of 5)
+    : root(nullptr)
+{
+#warning This implementation is incomplete.
+
+}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>& AVLTree<T, Augmentation>::operator=(const AVLTree<T, Augmentation>& other) // copy assignment operator (rule of 5)
+{
+#warning This implementation is incomplete.
+    Clear();
+    
+    // Construct new elements which are copies of the elements in other.
+    // Don't call Insert(). Insert does way more than is necessary. We just need to duplicate the structure
+    // that exists in other.
+    Node* current = other.root;
+    while (current != nullptr)
+    {
+        Node* node = new Node(current->item);
+        if (current == other.root)
+            root = node;
+
+
+    }
+} 
+#endif
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>& AVLTree<T, Augmentation>::operator=(AVLTree<T, Augmentation>&& other) // move assignment operator (rule of 5)
+{
+    Clear();
+    root = other.root;
+    size = other.size;
+    other.root = nullptr;
+    other.size = 0;
+    return *this;
+}
+
+
+
+template<class T, class Augmentation>
+void AVLTree<T, Augmentation>::Insert(const T& item)
+{
+    // TODO: defaultIterator has been eliminated. We still should be able to use some sort of a flag to ensure that no traversal pointers remain outstanding.
+    Node* node = new Node(item);
+    if (!InsertNode(node))
+        delete node; // They're equal.
+}
+
+
+template<class T, class Augmentation>
+bool AVLTree<T, Augmentation>::InsertNode(Node* node)
+{
+    node->balanceFactor = 0;
+    node->left = nullptr;
+    node->right = nullptr;
+    node->parent = nullptr;
+
+    Node* current(root);
+    Node* previous(nullptr);
+    while (current != nullptr)
+    {
+        previous = current;
+        if (node->item < current->item)
+            current = current->left;
+        else if (current->item < node->item)
+            current = current->right;
+        else
+            return false; // They're equal.
+    }
+
+    size++;
+    node->parent = previous;
+    if (previous == nullptr)
+    {
+        root = node;
+        UpdateAggregate(node);
+        return true;
+    }
+    if (node->item < previous->item)
+        previous->left = node;
+    else
+        previous->right = node;
+    UpdateAggregatesToRoot(node); // Rotations below keep the aggregates of the nodes they move.
+
+    /* Walk back up, updating balance factors. The walk stops at the first
+       node whose height is unchanged (it became perfectly balanced), or at
+       the first node which needs rotating. After an insertion, a single
+       rotation restores the subtree's original height, so nothing above it
+       changes. */
+    Node* child = node;
+    Node* balancePoint = previous;
+    while (balancePoint != nullptr)
+    {
+        if (balancePoint->left == child)
+            balancePoint->balanceFactor--;
+        else
+            balancePoint->balanceFactor++;
+
+        if (balancePoint->balanceFactor == 0)
+            break;
+
+        if (balancePoint->balanceFactor == -2 || balancePoint->balanceFactor == 2)
+        {
+            Node* balancePointPredecessor = balancePoint->parent;
+            Node* substituteNode = balancePoint->Balance();
+            if (balancePointPredecessor == nullptr)
+                root = substituteNode;
+            else if (balancePointPredecessor->left == balancePoint)
+                balancePointPredecessor->left = substituteNode;
+            else
+                balancePointPredecessor->right = substituteNode;
+            break;
+        }
+
+        child = balancePoint;
+        balancePoint = balancePoint->parent;
+    }
+    return true;
+}
+ 
+
+/* A precondition for Balance is that the balanceFactor of this node
+   and its immediate descendants must be accurate (obviously). Also,
+   this node must have a balanceFactor of 2 or -2. */
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::Node* AVLTree<T, Augmentation>::Node::Balance()
+{
+    Node *w(nullptr), *p(nullptr);
+    if (balanceFactor == -2) 
+    {
+        w = left;
+        if (w->balanceFactor == 1)
+            p = DoubleRightRotate();
+        else
+            p = RightRotate();
+    }
+    else if (balanceFactor == 2)
+    {
+        w = right;
+        if (w->balanceFactor == -1)
+            p = DoubleLeftRotate();
+        else
+            p = LeftRotate();
+    }
+    return p;
+}
+
+
+/* For validation only. Do not use for any other purpose.
+   Calculates the height of a tree by walking all descendant
+   nodes. */
+template<class T, class Augmentation>
+unsigned int AVLTree<T, Augmentation>::Node::CalculateHeight() const
+{
+    const Node* current = this;
+    unsigned int currentHeight = 0;
+    unsigned int maxHeight = 0;
+
+    while (current->left != nullptr) // descend leftward as far as possible
+    {
+        currentHeight++;
+        current = current->left;
+    }
+
+    while (current != nullptr && current != parent)
+    {
+        if (currentHeight > maxHeight)
+            maxHeight = currentHeight;
+
+        if (current->right != nullptr) // descend rightward one step
+        {
+            current = current->right;
+            currentHeight++;
+
+            while (current->left != nullptr) // descend leftward as far as possible
+            {
+                current = current->left;
+                currentHeight++;
+            }
+        }
+        else
+        {
+            // ascend, skipping any previously visited nodes
+            while (current->parent != nullptr && current->parent->right == current && current != this)
+            {
+                current = current->parent;
+                currentHeight--;
+            }
+
+            current = current->parent;
+            currentHeight--;
+        }
+    }
+    return maxHeight;
+}
+
+
+template<class T, class Augmentation>
+void AVLTree<T, Augmentation>::Remove(const T& item)
+{
+    Node* current = FindNode(item);
+    if (current == nullptr)
+        return; // The tree doesn't contain the specified item.
+    Detach(current);
+    delete current;
+}
+
+
+template<class T, class Augmentation>
+void AVLTree<T, Augmentation>::Detach(Node* current)
+{
+    size--;
+
+    if (current->left != nullptr && current->right != nullptr)
+    {
+        /* current has both left and right children. Swap it with the minimum
+           node of its right subtree (its successor), which has no left child.
+           The nodes themselves are swapped rather than their items, so that
+           an extracted node keeps its item. */
+        Node* replacement = current->right;
+        while (replacement->left != nullptr)
+            replacement = replacement->left;
+
+        Node* parent = current->parent;
+        Node* replacementRight = replacement->right;
+        if (replacement == current->right)
+        {
+            replacement->right = current;
+            current->parent = replacement;
+        }
+        else
+        {
+            replacement->right = current->right;
+            replacement->right->parent = replacement;
+            replacement->parent->left = current;
+            current->parent = replacement->parent;
+        }
+        replacement->left = current->left;
+        replacement->left->parent = replacement;
+        replacement->parent = parent;
+        if (parent == nullptr)
+            root = replacement;
+        else if (parent->left == current)
+            parent->left = replacement;
+        else
+            parent->right = replacement;
+
+        current->left = nullptr;
+        current->right = replacementRight;
+        if (replacementRight != nullptr)
+            replacementRight->parent = current;
+
+        int balanceFactor = current->balanceFactor;
+        current->balanceFactor = replacement->balanceFactor;
+        replacement->balanceFactor = balanceFactor;
+    }
+
+    // current now has at most one child, which takes its place.
+    Node* child = current->left != nullptr ? current->left : current->right;
+    Node* balancePoint = current->parent;
+    if (child != nullptr)
+        child->parent = balancePoint;
+    if (balancePoint == nullptr)
+    {
+        root = child;
+        return;
+    }
+
+    bool shortenedLeft = balancePoint->left == current;
+    if (shortenedLeft)
+        balancePoint->left = child;
+    else
+        balancePoint->right = child;
+    UpdateAggregatesToRoot(balancePoint);
+
+    /* Walk back up, updating balance factors, for as long as the subtree
+       below has become shorter. A node which was perfectly balanced keeps
+       its height and ends the walk. A rotation may or may not restore the
+       height of its subtree, so the walk continues above it if not. */
+    while (balancePoint != nullptr)
+    {
+        if (shortenedLeft)
+            balancePoint->balanceFactor++;
+        else
+            balancePoint->balanceFactor--;
+
+        if (balancePoint->balanceFactor == 1 || balancePoint->balanceFactor == -1)
+            break;
+
+        if (balancePoint->balanceFactor == 2 || balancePoint->balanceFactor == -2)
+        {
+            Node* balancePointPredecessor = balancePoint->parent;
+            Node* substituteNode = balancePoint->Balance();
+            if (balancePointPredecessor == nullptr)
+                root = substituteNode;
+            else if (balancePointPredecessor->left == balancePoint)
+                balancePointPredecessor->left = substituteNode;
+            else
+                balancePointPredecessor->right = substituteNode;
+
+            if (substituteNode->balanceFactor != 0)
+                break; // The subtree is as tall as before.
+            balancePoint = substituteNode;
+        }
+
+        Node* parent = balancePoint->parent;
+        if (parent != nullptr)
+            shortenedLeft = parent->left == balancePoint;
+        balancePoint = parent;
+    }
+}
+
+
+template<class T, class Augmentation>
+bool AVLTree<T, Augmentation>::Search(const T& item) const
+{
+    Node* current(root);
+    while (current != nullptr)
+    {
+        if (current->item == item)
+            return true;
+
+        if (item < current->item)
+            current = current->left;
+        else
+            current = current->right;
+    }
+    return false;
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+const T* AVLTree<T, Augmentation>::Find(const U& item) const
+{
+    Node* node = FindNode(item);
+    return node != nullptr ? &node->item : nullptr;
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+typename AVLTree<T, Augmentation>::Node* AVLTree<T, Augmentation>::FindNode(const U& item) const
+{
+    Node* current(root);
+    while (current != nullptr)
+    {
+        if (current->item < item)
+            current = current->right;
+        else if (item < current->item)
+            current = current->left;
+        else
+            return current;
+    }
+    return nullptr;
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::NodeHandle AVLTree<T, Augmentation>::Extract(const T& item)
+{
+    Node* node = FindNode(item);
+    if (node == nullptr)
+        return NodeHandle();
+    Detach(node);
+    node->left = nullptr;
+    node->right = nullptr;
+    node->parent = nullptr;
+    return NodeHandle(node);
+}
+
+
+template<class T, class Augmentation>
+bool AVLTree<T, Augmentation>::Insert(NodeHandle&& handle)
+{
+    if (handle.node == nullptr || !InsertNode(handle.node))
+        return false;
+    handle.node = nullptr;
+    return true;
+}
+
+
+template<class T, class Augmentation>
+void AVLTree<T, Augmentation>::Merge(AVLTree<T, Augmentation>& other)
+{
+    if (&other == this || other.root == nullptr)
+        return;
+
+    Node* incoming = TreeToVine(other.root);
+    other.root = nullptr;
+    size_t otherSize = other.size;
+    other.size = 0;
+    Vine leftover; // nodes whose items are already present
+
+    size_t depth = 1; // approximately log2 of size, the cost of an InsertNode()
+    for (size_t remaining = size; remaining > 1; remaining /= 2)
+        depth++;
+    if (otherSize * depth < size)
+    {
+        while (incoming != nullptr)
+        {
+            Node* next = incoming->right;
+            if (!InsertNode(incoming))
+                leftover.Append(incoming);
+            incoming = next;
+        }
+        other.BuildFromVine(leftover);
+        return;
+    }
+
+    Node* existing = TreeToVine(root);
+    root = nullptr;
+    size = 0;
+    Vine merged;
+    while (existing != nullptr || incoming != nullptr)
+    {
+        if (incoming != nullptr && (existing == nullptr || incoming->item < existing->item))
+        {
+            Node* next = incoming->right;
+            merged.Append(incoming);
+            incoming = next;
+        }
+        else
+        {
+            if (incoming != nullptr && incoming->item == existing->item)
+            {
+                Node* next = incoming->right;
+                leftover.Append(incoming);
+                incoming = next;
+            }
+            Node* next = existing->right;
+            merged.Append(existing);
+            existing = next;
+        }
+    }
+    BuildFromVine(merged);
+    other.BuildFromVine(leftover);
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+typename AVLTree<T, Augmentation>::ConstIterator AVLTree<T, Augmentation>::LowerBound(const U& item) const
+{
+    Node* current(root);
+    Node* candidate(nullptr);
+    while (current != nullptr)
+    {
+        if (current->item < item)
+            current = current->right;
+        else
+        {
+            candidate = current;
+            current = current->left;
+        }
+    }
+    return ConstIterator(*this, candidate);
+}
+
+
+template<class T, class Augmentation>
+size_t AVLTree<T, Augmentation>::Size() const
+{
+    return size;
+}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::Node::Node(const T& item_)
+    : item(item_), balanceFactor(0), left(nullptr), right(nullptr), parent(nullptr)
+{}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::Node* AVLTree<T, Augmentation>::Node::RightRotate()
+{
+    Node* q(left);
+    if (q == nullptr) // Shouldn't happen, but we guard against it here anyway.
+        return nullptr;     
+    this->left = q->right;
+    if(q->right != nullptr)
+        q->right->parent = this;
+    q->right = this;
+    q->parent = this->parent;
+    parent = q;
+    int newBalanceThis = balanceFactor + 1 - min(q->balanceFactor, 0);
+    int newBalanceQ = q->balanceFactor + 1 + max(newBalanceThis, 0);
+    this->balanceFactor = newBalanceThis;
+    q->balanceFactor = newBalanceQ;
+    UpdateAggregate(this);
+    UpdateAggregate(q);
+    return q;
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::Node* AVLTree<T, Augmentation>::Node::LeftRotate()
+{
+    Node* q(right);
+    if (q == nullptr) // Shouldn't happen, but we guard against it here anyway.
+        return nullptr;
+    this->right = q->left;
+    if(q->left != nullptr)
+        q->left->parent = this;
+    q->left = this;
+    q->parent = this->parent;
+    parent = q;
+    int newBalanceThis = balanceFactor - 1 - max(q->balanceFactor, 0);
+    int newBalanceQ = q->balanceFactor - 1 + min(newBalanceThis, 0);
+    this->balanceFactor = newBalanceThis;
+    q->balanceFactor = newBalanceQ;
+    UpdateAggregate(this);
+    UpdateAggregate(q);
+    return q;
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::Node* AVLTree<T, Augmentation>::Node::DoubleRightRotate()
+{
+    if (left == nullptr)  // Shouldn't happen, but we guard against it here anyway.
+        return nullptr;
+    left = left->LeftRotate();
+    return RightRotate();
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::Node* AVLTree<T, Augmentation>::Node::DoubleLeftRotate()
+{
+    if (right == nullptr)
+        return nullptr;
+    right = right->RightRotate();
+    return LeftRotate();
+}
+
+
+/* Rather than starting over from the root, climb only as far as is needed
+   to bracket the item, then descend. Walking forward through a tree this
+   way costs O(log D) per call, where D is the distance travelled, which is
+   what makes seeking through a large tree cheaper than stepping. */
+template<class T, class Augmentation>
+template<typename U>
+typename AVLTree<T, Augmentation>::Node* AVLTree<T, Augmentation>::Node::Seek(Node* from, const U& item)
+{
+    if (from == nullptr || !(from->item < item))
+        return from;
+
+    Node* current = from; // current->item < item
+    while (1)
+    {
+        // Find the nearest ancestor which follows current in order.
+        Node* successor = current;
+        while (successor->parent != nullptr && successor->parent->right == successor)
+            successor = successor->parent;
+        successor = successor->parent;
+
+        if (successor == nullptr || !(successor->item < item))
+        {
+            // The item lies within current's right subtree, or else it's the successor.
+            Node* candidate = successor;
+            Node* descendant = current->right;
+            while (descendant != nullptr)
+            {
+                if (descendant->item < item)
+                    descendant = descendant->right;
+                else
+                {
+                    candidate = descendant;
+                    descendant = descendant->left;
+                }
+            }
+            return candidate;
+        }
+
+        // Everything in current's right subtree precedes the successor, so skip all of it.
+        current = successor;
+    }
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+typename Augmentation::Value AVLTree<T, Augmentation>::Aggregate(const U& lo, const U& hi) const
+{
+    // Find the topmost node in the range, where the paths to lo and hi split.
+    Node* split(root);
+    while (split != nullptr && (split->item < lo || hi < split->item))
+        split = split->item < lo ? split->right : split->left;
+    if (split == nullptr)
+        return Augmentation::Identity();
+
+    /* Follow the path to lo. Wherever it goes left, the node and its right
+       subtree are in range, and follow everything collected further down. */
+    typename Augmentation::Value lower = Augmentation::Identity();
+    for (Node* current = split->left; current != nullptr;)
+    {
+        if (current->item < lo)
+            current = current->right;
+        else
+        {
+            typename Augmentation::Value above = Augmentation::Lift(current->item);
+            if (current->right != nullptr)
+                above = Augmentation::Combine(above, current->right->aggregate);
+            lower = Augmentation::Combine(above, lower);
+            current = current->left;
+        }
+    }
+
+    // Likewise for hi, mirrored.
+    typename Augmentation::Value upper = Augmentation::Identity();
+    for (Node* current = split->right; current != nullptr;)
+    {
+        if (hi < current->item)
+            current = current->left;
+        else
+        {
+            typename Augmentation::Value below = Augmentation::Lift(current->item);
+            if (current->left != nullptr)
+                below = Augmentation::Combine(current->left->aggregate, below);
+            upper = Augmentation::Combine(upper, below);
+            current = current->right;
+        }
+    }
+
+    return Augmentation::Combine(Augmentation::Combine(lower, Augmentation::Lift(split->item)), upper);
+}
+
+
+template<class T, class Augmentation>
+template<class A>
+typename A::Value AVLTree<T, Augmentation>::Aggregate() const
+{
+    return root != nullptr ? root->aggregate : Augmentation::Identity();
+}
+
+
+template<class T, class Augmentation>
+template<class A>
+void AVLTree<T, Augmentation>::UpdateAggregate(Node* node, std::true_type)
+{
+    typename Augmentation::Value aggregate = Augmentation::Lift(node->item);
+    if (node->left != nullptr)
+        aggregate = Augmentation::Combine(node->left->aggregate, aggregate);
+    if (node->right != nullptr)
+        aggregate = Augmentation::Combine(aggregate, node->right->aggregate);
+    node->aggregate = aggregate;
+}
+
+
+template<class T, class Augmentation>
+template<class A>
+void AVLTree<T, Augmentation>::UpdateAggregatesToRoot(Node* node, std::true_type)
+{
+    for (; node != nullptr; node = node->parent)
+        UpdateAggregate(node, std::true_type());
+}
+
+
+template<class T, class Augmentation>
+bool AVLTree<T, Augmentation>::IsValid() const
+{
+    /* - Balance factors of all nodes are -1, 0, or 1.
+       - Verify balance factors by calculating heights at all nodes.
+       - The number of nodes matches the recorded size.
+       - Each child points back to its parent.
+    */
+    size_t nodeCount = 0;
+    for (ConstIterator itr = begin(); itr != end(); ++itr)
+    {
+        nodeCount++;
+        const Node* n = itr.GetNode();
+        if ((n->left != nullptr && n->left->parent != n) || (n->right != nullptr && n->right->parent != n))
+            return false;
+        if (n->balanceFactor != -1 && n->balanceFactor != 0 && n->balanceFactor != 1)
+            return false;
+
+        unsigned int leftHeight = n->left != nullptr ? (1 + n->left->CalculateHeight()) : 0;
+        unsigned int rightHeight = n->right != nullptr ? (1 + n->right->CalculateHeight()) : 0;
+        int calculatedBalanceFactor = rightHeight - leftHeight;
+        if (n->balanceFactor != calculatedBalanceFactor)
+            return false;
+    }
+    return nodeCount == size;
+}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::NodeHandle::NodeHandle()
+    : node(nullptr)
+{}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::NodeHandle::NodeHandle(Node* node_)
+    : node(node_)
+{}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::NodeHandle::NodeHandle(NodeHandle&& other)
+    : node(other.node)
+{
+    other.node = nullptr;
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::NodeHandle& AVLTree<T, Augmentation>::NodeHandle::operator=(NodeHandle&& other)
+{
+    if (this != &other)
+    {
+        delete node;
+        node = other.node;
+        other.node = nullptr;
+    }
+    return *this;
+}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::NodeHandle::~NodeHandle()
+{
+    delete node;
+}
+
+
+template<class T, class Augmentation>
+bool AVLTree<T, Augmentation>::NodeHandle::Empty() const
+{
+    return node == nullptr;
+}
+
+
+template<class T, class Augmentation>
+T& AVLTree<T, Augmentation>::NodeHandle::Item() const
+{
+    return node->item;
+}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::ConstIterator::ConstIterator(const AVLTree<T, Augmentation>& tree_)
+    : tree(tree_), current(tree_.root)
+{
+    if (tree_.root == nullptr)
+        return;
+
+    while (current->left != nullptr)
+        current = current->left;
+}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::ConstIterator::ConstIterator(const AVLTree<T, Augmentation>& tree_, bool end)
+    : tree(tree_), current(nullptr)
+{
+    end = true; // TODO: Reconsider the constructors for end() iterators.
+}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::ConstIterator::ConstIterator(const AVLTree<T, Augmentation>& tree_, Node* current_)
+    : tree(tree_), current(current_)
+{}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::ConstIterator::~ConstIterator()
+{}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::ConstIterator& AVLTree<T, Augmentation>::ConstIterator::operator++()
+{
+    if (current->right != nullptr)
+    {
+        current = current->right;
+        while (current->left != nullptr)
+            current = current->left;
+    }
+    else
+    {
+        while (current->parent != nullptr && current->parent->right == current)
+            current = current->parent;
+
+        current = current->parent;
+    }
+
+    return *this;
+}
+
+
+template<class T, class Augmentation>
+bool AVLTree<T, Augmentation>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return current != other.current;
+}
+
+
+template<class T, class Augmentation>
+const T& AVLTree<T, Augmentation>::ConstIterator::operator*() const
+{
+    return current->item;
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+typename AVLTree<T, Augmentation>::ConstIterator& AVLTree<T, Augmentation>::ConstIterator::Seek(const U& item)
+{
+    current = Node::Seek(current, item);
+    return *this;
+}
+
+
+template<class T, class Augmentation>
+const typename AVLTree<T, Augmentation>::Node* AVLTree<T, Augmentation>::ConstIterator::GetNode() const
+{
+    return current;
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::ConstIterator AVLTree<T, Augmentation>::begin() const
+{    
+    return ConstIterator(*this);
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::ConstIterator AVLTree<T, Augmentation>::end() const
+{
+    return ConstIterator(*this, true);
+}
+
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::ConstPostorder::ConstPostorder(const AVLTree<T, Augmentation>& tree_)
+    : tree(tree_)
+{}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::ConstPostorder::~ConstPostorder() {}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::ConstPostorder::Iterator::~Iterator()
+{}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::ConstPostorder::Iterator::Iterator(const AVLTree& tree_)
+    : tree(tree_), current(nullptr), next(tree_.root), downwardPhase(true)
+{
+    if (next == nullptr)
+        return;
+
+    while (next->left != nullptr) // descend leftward as far as possible
+        next = next->left;
+
+    operator++();
+}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::ConstPostorder::Iterator::Iterator(const AVLTree& tree_, bool end)
+    : tree(tree_), current(nullptr), next(nullptr), downwardPhase(true)
+{
+    end = true; // TODO: Reconsider the constructors for end() iterators.
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::ConstPostorder::Iterator& AVLTree<T, Augmentation>::ConstPostorder::Iterator::operator++()
+{
+    if (next == nullptr)
+        current = nullptr; // We're at the end.
+
+    while (next != nullptr)
+    {
+        if (downwardPhase)
+        {
+            if (next->right != nullptr)
+            {
+                next = next->right;
+                while (next->left != nullptr)
+                    next = next->left;
+            }
+            else
+            {
+                downwardPhase = false;
+            }
+        }
+        else
+        {
+            if (next->parent != nullptr && next->parent->right == next)
+            {
+                // stay in the upward phase
+            }
+            else
+            {
+                downwardPhase = true;
+            }
+
+            // visit
+            current = next;
+            next = next->parent;
+            break;
+        }
+    }
+    return *this;
+}
+
+
+template<class T, class Augmentation>
+bool AVLTree<T, Augmentation>::ConstPostorder::Iterator::operator!=(const Iterator& other) const
+{
+    return !(current == other.current && next == other.next && downwardPhase == other.downwardPhase);
+}
+
+
+template<class T, class Augmentation>
+const T& AVLTree<T, Augmentation>::ConstPostorder::Iterator::operator*() const
+{
+    return current->item;
+}
+
+
+template<class T, class Augmentation>
+const typename AVLTree<T, Augmentation>::Node* AVLTree<T, Augmentation>::ConstPostorder::Iterator::GetNode() const
+{
+    return current;
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::ConstPostorder::Iterator AVLTree<T, Augmentation>::ConstPostorder::begin() const
+{
+    return Iterator(tree);
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::ConstPostorder::Iterator AVLTree<T, Augmentation>::ConstPostorder::end() const
+{
+    return Iterator(tree, true);
+}
+
+
+template<typename T, class Augmentation>
+template<typename U>
+AVLTree<T, Augmentation> AVLTree<T, Augmentation>::Intersect(const U& other) const
+{
+    AVLTree<T, Augmentation> intersectionTree;
+    Vine vine;
+    SortedRange::ForEachCommonBlocked(*this, other, [&vine](const T& item)
+    {
+        vine.Append(new Node(item));
+        return true;
+    });
+    intersectionTree.BuildFromVine(vine);
+    return intersectionTree;
+}
+
+
+template<typename T, class Augmentation>
+template<typename U>
+AVLTree<T, Augmentation> AVLTree<T, Augmentation>::IntersectUnsorted(const U& other) const
+{
+    AVLTree<T, Augmentation> intersectionTree;
+    Vine vine;
+    SortedRange::ForEachCommonUnsorted(*this, other, [&vine](const T& item)
+    {
+        vine.Append(new Node(item));
+        return true;
+    });
+    intersectionTree.BuildFromVine(vine);
+    return intersectionTree;
+}
+/* Intersect() accepts any range which is sorted in ascending order. The
+   trees are sorted by definition. Arrays and Lists are only sorted if the
+   caller has made them so. */
+
+
+template<typename T, class Augmentation>
+AVLTree<T, Augmentation> AVLTree<T, Augmentation>::IntersectAll(std::initializer_list<const AVLTree<T, Augmentation>*> trees)
+{
+    AVLTree<T, Augmentation> intersectionTree;
+    size_t count = trees.size();
+    if (count == 0)
+        return intersectionTree;
+
+    // Order the trees from smallest to largest. There are only a handful, so insertion sort is fine.
+    const AVLTree<T, Augmentation>** sorted = new const AVLTree<T, Augmentation>*[count];
+    Node** cursors = new Node*[count];
+    size_t sortedCount = 0;
+    for (const AVLTree<T, Augmentation>* tree : trees)
+    {
+        size_t i = sortedCount++;
+        while (i > 0 && tree->size < sorted[i - 1]->size)
+        {
+            sorted[i] = sorted[i - 1];
+            i--;
+        }
+        sorted[i] = tree;
+    }
+
+    Vine vine;
+    bool exhausted = false;
+    for (size_t i = 0; i < count; i++)
+    {
+        cursors[i] = sorted[i]->begin().current;
+        if (cursors[i] == nullptr)
+            exhausted = true;
+    }
+
+    while (!exhausted)
+    {
+        const T& candidate = cursors[0]->item;
+        size_t i = 1;
+        for (; i < count; i++)
+        {
+            cursors[i] = Node::Seek(cursors[i], candidate);
+            if (cursors[i] == nullptr)
+                exhausted = true;
+            if (exhausted || candidate < cursors[i]->item)
+                break; // leapt past the candidate, so it can't be in the intersection
+        }
+        if (exhausted)
+            break;
+
+        if (i == count)
+        {
+            // Every tree contains the candidate.
+            vine.Append(new Node(candidate));
+            ConstIterator next(*sorted[0], cursors[0]);
+            ++next;
+            cursors[0] = next.current;
+        }
+        else
+            cursors[0] = Node::Seek(cursors[0], cursors[i]->item);
+
+        exhausted = cursors[0] == nullptr;
+    }
+
+    delete[] cursors;
+    delete[] sorted;
+    intersectionTree.BuildFromVine(vine);
+    return intersectionTree;
+}
+
+
+template<class T, class Augmentation>
+AVLTree<T, Augmentation>::Vine::Vine()
+    : head(nullptr), tail(nullptr), count(0)
+{}
+
+
+template<class T, class Augmentation>
+void AVLTree<T, Augmentation>::Vine::Append(Node* node)
+{
+    node->left = nullptr;
+    node->right = nullptr;
+    node->parent = tail;
+    if (tail != nullptr)
+        tail->right = node;
+    else
+        head = node;
+    tail = node;
+    count++;
+}
+
+
+template<class T, class Augmentation>
+typename AVLTree<T, Augmentation>::Node* AVLTree<T, Augmentation>::TreeToVine(Node* root)
+{
+    Node* head = root;
+    Node** link = &head;
+    while (*link != nullptr)
+    {
+        Node* node = *link;
+        if (node->left != nullptr)
+        {
+            // Rotate right, lifting the left child into the vine.
+            Node* left = node->left;
+            node->left = left->right;
+            left->right = node;
+            *link = left;
+        }
+        else
+            link = &node->right;
+    }
+    return head;
+}
+
+
+template<class T, class Augmentation>
+void AVLTree<T, Augmentation>::Compress(Node** link, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        Node* child = *link;
+        Node* grandchild = child->right;
+        *link = grandchild;
+        grandchild->parent = child->parent;
+        child->right = grandchild->left;
+        if (child->right != nullptr)
+            child->right->parent = child;
+        grandchild->left = child;
+        child->parent = grandchild;
+        link = &grandchild->right;
+    }
+}
+
+
+template<class T, class Augmentation>
+template<typename Visitor>
+void AVLTree<T, Augmentation>::ForEachNodePostorder(Node* root, Visitor visitor)
+{
+    if (root == nullptr)
+        return;
+
+    Node* current = root;
+    size_t depth = 0;
+    while (current->left != nullptr || current->right != nullptr) // descend to the first node in postorder
+    {
+        current = current->left != nullptr ? current->left : current->right;
+        depth++;
+    }
+
+    while (1)
+    {
+        visitor(current, depth);
+        if (current == root)
+            break;
+
+        Node* parent = current->parent;
+        if (parent->left == current && parent->right != nullptr)
+        {
+            current = parent->right;
+            while (current->left != nullptr || current->right != nullptr)
+            {
+                current = current->left != nullptr ? current->left : current->right;
+                depth++;
+            }
+        }
+        else
+        {
+            current = parent;
+            depth--;
+        }
+    }
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+void AVLTree<T, Augmentation>::InsertSorted(const U& sortedRange)
+{
+    size_t rangeSize = SortedRange::Size(sortedRange);
+    if (rangeSize == 0)
+        return;
+    if (rangeSize != SortedRange::UnknownSize)
+    {
+        size_t depth = 1; // approximately log2 of size, the cost of an Insert()
+        for (size_t remaining = size; remaining > 1; remaining /= 2)
+            depth++;
+        if (rangeSize * depth < size)
+        {
+            for (SortedRangeIterator<U> itr = SortedRange::Begin(sortedRange); itr != SortedRange::End(sortedRange); ++itr)
+                Insert(*itr);
+            return;
+        }
+    }
+
+    Node* existing = TreeToVine(root);
+    root = nullptr;
+    size = 0;
+    Vine merged;
+    SortedRangeIterator<U> itr = SortedRange::Begin(sortedRange);
+    SortedRangeIterator<U> end = SortedRange::End(sortedRange);
+    while (existing != nullptr || itr != end)
+    {
+        if (itr != end && (existing == nullptr || *itr < existing->item))
+        {
+            if (merged.tail == nullptr || merged.tail->item < *itr) // skips duplicates
+                merged.Append(new Node(*itr));
+            ++itr;
+        }
+        else
+        {
+            if (itr != end && *itr == existing->item)
+                ++itr; // already in the tree
+            Node* next = existing->right;
+            merged.Append(existing);
+            existing = next;
+        }
+    }
+    BuildFromVine(merged);
+}
+
+
+template<class T, class Augmentation>
+void AVLTree<T, Augmentation>::BuildFromVine(const Vine& vine)
+{
+    root = vine.head;
+    size = vine.count;
+    if (root == nullptr)
+        return;
+
+    /* The first pass of rotations moves the nodes which don't fit in a
+       perfect tree down to the bottom level. Each pass after that halves
+       the length of the vine. */
+    size_t perfect = 1; // largest 2^k - 1 which doesn't exceed size
+    while (perfect * 2 + 1 <= size)
+        perfect = perfect * 2 + 1;
+    Compress(&root, size - perfect);
+    for (size_t count = perfect / 2; count > 0; count /= 2)
+        Compress(&root, count);
+
+    /* Children are visited before their parents, so heights can be worked
+       out on the way up. A node's balance factor depends on the heights of
+       its children, which are needed again by its parent, so both are
+       packed into balanceFactor (height << 2 | balanceFactor + 1) and then
+       unpacked in a second pass. */
+    ForEachNodePostorder(root, [](Node* node, size_t)
+    {
+        int leftHeight = node->left != nullptr ? (node->left->balanceFactor >> 2) : 0;
+        int rightHeight = node->right != nullptr ? (node->right->balanceFactor >> 2) : 0;
+        node->balanceFactor = ((Node::max(leftHeight, rightHeight) + 1) << 2) | (rightHeight - leftHeight + 1);
+    });
+    ForEachNodePostorder(root, [](Node* node, size_t)
+    {
+        node->balanceFactor = (node->balanceFactor & 3) - 1;
+        UpdateAggregate(node);
+    });
+}
+
+
+template class AVLTree<int>; // To force compilation of the template, for compile-time validation.
+template class AVLTree<int, SumAugmentation<int>>;
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
 #endif
\ No newline at end of file
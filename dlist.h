@@ -0,0 +1,600 @@
+#ifndef _DLIST_H_
+#define _DLIST_H_
+
+#include <cstddef>
+#include <initializer_list>
+
+/* DList
+
+   Bob Burrough, 2021
+
+   Implementation of a doubly-linked list. Each node links to both of its
+   neighbors, so an item can be erased or moved given only an iterator to
+   it, without walking the list to find its predecessor, and the list can be
+   walked in either direction. Iterators stay valid until their own item is
+   erased, which lets them serve as handles, e.g. for LRU bookkeeping. */
+
+
+template<class T>
+class DList
+{
+public:
+    class ConstIterator;
+    class ConstReverseIterator;
+
+    DList();
+    DList(std::initializer_list<T> l); // initialize DList with a static array of values
+    virtual ~DList(); // custom destructor (rule of 5)
+    DList(const DList& other); // copy constructor (rule of 5)
+    DList<T>& operator=(const DList& other); // copy assignment operator (rule of 5)
+    DList(DList<T>&& other); // move constructor (rule of 5)
+    DList<T>& operator=(DList&& other); // move assignment operator (rule of 5)
+
+    // Insert an item at the front of the list, and return an iterator to it. O(1)
+    ConstIterator Insert(const T& item);
+
+    // Append an item to the end of the list, and return an iterator to it. O(1)
+    ConstIterator Append(const T& item);
+
+    // Insert an item before position, which may be end(), and return an iterator to it. O(1)
+    ConstIterator InsertBefore(const ConstIterator& position, const T& item);
+
+    // Remove the item at position, and return an iterator to the item which followed it. O(1)
+    ConstIterator Erase(const ConstIterator& position);
+
+    // Remove the item at the front or back of the list, if there is one. O(1)
+    void PopFront();
+    void PopBack();
+
+    // Move the item at position to the front or back of the list. Iterators remain valid. O(1)
+    void MoveToFront(const ConstIterator& position);
+    void MoveToBack(const ConstIterator& position);
+
+    // The first and last items. The list must not be empty. O(1)
+    T& Front();
+    const T& Front() const;
+    T& Back();
+    const T& Back() const;
+
+    // Reverses the list. O(n)
+    void Reverse();
+
+    // returns true if the list contains no elements
+    bool IsEmpty() const;
+
+    // returns the number of elements contained in the list
+    size_t Size() const;
+
+    // empties the list of all elements
+    void Clear();
+
+    /* Consistency check. Returns true if the list
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+protected:
+private:
+    class Node
+    {
+    public:
+        Node(const T& item_);
+
+        friend class DList<T>;
+
+    protected:
+    private:
+        Node() = delete; // An item is required to instantiate a node.
+        Node* prev;
+        Node* next;
+        T item;
+    };
+
+    void Link(Node* node, Node* before); // Links an unlinked node in front of before, or at the end if before is nullptr.
+    void Unlink(Node* node);
+
+    Node* head;
+    Node* tail;
+    size_t size;
+
+    // Iterator declarations
+public:
+    class ConstIterator
+    {
+    public:
+        ConstIterator();
+        ConstIterator(Node* start);
+        ConstIterator& operator++();
+        bool operator==(const ConstIterator& other) const;
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+        friend class DList<T>;
+
+    protected:
+    private:
+        Node* current;
+    };
+
+    class ConstReverseIterator
+    {
+    public:
+        ConstReverseIterator();
+        ConstReverseIterator(Node* start);
+        ConstReverseIterator& operator++();
+        bool operator==(const ConstReverseIterator& other) const;
+        bool operator!=(const ConstReverseIterator& other) const;
+        const T& operator*() const;
+
+    protected:
+    private:
+        Node* current;
+    };
+
+    // The items from back to front, e.g. for (const T& item : list.Reversed())
+    class ReverseRange
+    {
+    public:
+        ReverseRange(Node* start) : first(start) {}
+        ConstReverseIterator begin() const { return ConstReverseIterator(first); }
+        ConstReverseIterator end() const { return ConstReverseIterator(nullptr); }
+    private:
+        Node* first;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    ConstReverseIterator rbegin() const;
+    ConstReverseIterator rend() const;
+    ReverseRange Reversed() const;
+};
+
+
+template<class T>
+DList<T>::DList()
+    : head(nullptr), tail(nullptr), size(0)
+{}
+
+
+template<class T>
+DList<T>::DList(std::initializer_list<T> l)
+    : head(nullptr), tail(nullptr), size(0)
+{
+    for (const auto& x : l)
+        Append(x);
+}
+
+
+template<class T>
+DList<T>::~DList()
+{
+    Clear();
+}
+
+
+template<class T>
+void DList<T>::Clear()
+{
+    Node* current = head;
+    while (current != nullptr)
+    {
+        Node* next = current->next;
+        delete current;
+        current = next;
+    }
+    head = nullptr;
+    tail = nullptr;
+    size = 0;
+}
+
+
+template<class T>
+DList<T>::DList(const DList<T>& other) // copy constructor
+    : head(nullptr), tail(nullptr), size(0)
+{
+    for (const T& item : other)
+        Append(item);
+}
+
+
+template<class T>
+DList<T>& DList<T>::operator=(const DList& other) // copy assignment operator
+{
+    if (this == &other)
+        return *this;
+    Clear();
+    for (const T& item : other)
+        Append(item);
+    return *this;
+}
+
+
+template<class T>
+DList<T>::DList(DList<T>&& other) // move constructor
+    : head(other.head), tail(other.tail), size(other.size)
+{
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+}
+
+
+template<class T>
+DList<T>& DList<T>::operator=(DList&& other) // move assignment operator
+{
+    Clear();
+    head = other.head;
+    tail = other.tail;
+    size = other.size;
+
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+
+    return *this;
+}
+
+
+template<class T>
+void DList<T>::Link(Node* node, Node* before)
+{
+    Node* after = before != nullptr ? before->prev : tail;
+    node->prev = after;
+    node->next = before;
+    if (after != nullptr)
+        after->next = node;
+    else
+        head = node;
+    if (before != nullptr)
+        before->prev = node;
+    else
+        tail = node;
+}
+
+
+template<class T>
+void DList<T>::Unlink(Node* node)
+{
+    if (node->prev != nullptr)
+        node->prev->next = node->next;
+    else
+        head = node->next;
+    if (node->next != nullptr)
+        node->next->prev = node->prev;
+    else
+        tail = node->prev;
+    node->prev = nullptr;
+    node->next = nullptr;
+}
+
+
+template<class T>
+typename DList<T>::ConstIterator DList<T>::Insert(const T& item)
+{
+    return InsertBefore(begin(), item);
+}
+
+
+template<class T>
+typename DList<T>::ConstIterator DList<T>::Append(const T& item)
+{
+    return InsertBefore(end(), item);
+}
+
+
+template<class T>
+typename DList<T>::ConstIterator DList<T>::InsertBefore(const ConstIterator& position, const T& item)
+{
+    Node* node = new Node(item);
+    Link(node, position.current);
+    size++;
+    return ConstIterator(node);
+}
+
+
+template<class T>
+typename DList<T>::ConstIterator DList<T>::Erase(const ConstIterator& position)
+{
+    Node* node = position.current;
+    Node* next = node->next;
+    Unlink(node);
+    delete node;
+    size--;
+    return ConstIterator(next);
+}
+
+
+template<class T>
+void DList<T>::PopFront()
+{
+    if (head != nullptr)
+        Erase(begin());
+}
+
+
+template<class T>
+void DList<T>::PopBack()
+{
+    if (tail != nullptr)
+        Erase(ConstIterator(tail));
+}
+
+
+template<class T>
+void DList<T>::MoveToFront(const ConstIterator& position)
+{
+    Node* node = position.current;
+    if (node == head)
+        return;
+    Unlink(node);
+    Link(node, head);
+}
+
+
+template<class T>
+void DList<T>::MoveToBack(const ConstIterator& position)
+{
+    Node* node = position.current;
+    if (node == tail)
+        return;
+    Unlink(node);
+    Link(node, nullptr);
+}
+
+
+template<class T>
+T& DList<T>::Front()
+{
+    return head->item;
+}
+
+
+template<class T>
+const T& DList<T>::Front() const
+{
+    return head->item;
+}
+
+
+template<class T>
+T& DList<T>::Back()
+{
+    return tail->item;
+}
+
+
+template<class T>
+const T& DList<T>::Back() const
+{
+    return tail->item;
+}
+
+
+template<class T>
+void DList<T>::Reverse()
+{
+    Node* current = head;
+    while (current != nullptr)
+    {
+        Node* next = current->next;
+        current->next = current->prev;
+        current->prev = next;
+        current = next;
+    }
+    Node* temp = head;
+    head = tail;
+    tail = temp;
+}
+
+
+template<class T>
+bool DList<T>::IsEmpty() const
+{
+    return size == 0;
+}
+
+
+template<class T>
+size_t DList<T>::Size() const
+{
+    return size;
+}
+
+
+template<class T>
+DList<T>::Node::Node(const T& item_)
+    : prev(nullptr), next(nullptr), item(item_)
+{}
+
+
+template<class T>
+DList<T>::ConstIterator::ConstIterator() // This also happens to be equivalent to DList<T>::end()
+    : current(nullptr)
+{}
+
+
+template<class T>
+DList<T>::ConstIterator::ConstIterator(Node* start)
+    : current(start)
+{}
+
+
+template<class T>
+typename DList<T>::ConstIterator& DList<T>::ConstIterator::operator++()
+{
+    current = current->next;
+    return *this;
+}
+
+
+template<class T>
+bool DList<T>::ConstIterator::operator==(const ConstIterator& other) const
+{
+    return current == other.current;
+}
+
+
+template<class T>
+bool DList<T>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return current != other.current;
+}
+
+
+template<class T>
+const T& DList<T>::ConstIterator::operator*() const
+{
+    return current->item;
+}
+
+
+template<class T>
+DList<T>::ConstReverseIterator::ConstReverseIterator() // This also happens to be equivalent to DList<T>::rend()
+    : current(nullptr)
+{}
+
+
+template<class T>
+DList<T>::ConstReverseIterator::ConstReverseIterator(Node* start)
+    : current(start)
+{}
+
+
+template<class T>
+typename DList<T>::ConstReverseIterator& DList<T>::ConstReverseIterator::operator++()
+{
+    current = current->prev;
+    return *this;
+}
+
+
+template<class T>
+bool DList<T>::ConstReverseIterator::operator==(const ConstReverseIterator& other) const
+{
+    return current == other.current;
+}
+
+
+template<class T>
+bool DList<T>::ConstReverseIterator::operator!=(const ConstReverseIterator& other) const
+{
+    return current != other.current;
+}
+
+
+template<class T>
+const T& DList<T>::ConstReverseIterator::operator*() const
+{
+    return current->item;
+}
+
+
+template<class T>
+typename DList<T>::ConstIterator DList<T>::begin() const
+{
+    return ConstIterator(head);
+}
+
+
+template<class T>
+typename DList<T>::ConstIterator DList<T>::end() const
+{
+    return ConstIterator(nullptr);
+}
+
+
+template<class T>
+typename DList<T>::ConstReverseIterator DList<T>::rbegin() const
+{
+    return ConstReverseIterator(tail);
+}
+
+
+template<class T>
+typename DList<T>::ConstReverseIterator DList<T>::rend() const
+{
+    return ConstReverseIterator(nullptr);
+}
+
+
+template<class T>
+typename DList<T>::ReverseRange DList<T>::Reversed() const
+{
+    return ReverseRange(tail);
+}
+
+
+template<class T>
+bool DList<T>::IsValid() const
+{
+    if (head != nullptr && tail == nullptr)
+        return false;
+    if (head == nullptr && tail != nullptr)
+        return false;
+    if (head != nullptr && head->prev != nullptr)
+        return false;
+
+    size_t elementCount(0);
+    Node* current = head;
+    while (current != nullptr)
+    {
+        elementCount++;
+        if (elementCount > size)
+            return false; // Too many elements, or a cycle.
+        if (current->next == nullptr && tail != current)
+            return false;
+        if (current->next != nullptr && current->next->prev != current)
+            return false;
+        current = current->next;
+    }
+    if (Size() != elementCount)
+        return false;
+
+    return true;
+}
+
+
+template class DList<int>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -0,0 +1,446 @@
+#ifndef _FLATSET_H_
+#define _FLATSET_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "setops.h"
+
+/* FlatSet
+
+   Bob Burrough, 2021
+
+   A set kept as a sorted, contiguous array. It shares the interface of
+   AVLTree and RBTree, but Search() is a binary search over adjacent
+   memory, and iteration is a pointer increment, so for read-mostly sets of
+   moderate size it is much faster than any node-based tree. The price is
+   that Insert() and Remove() move every later item, O(N). Insert many
+   items at once with InsertSorted(), which merges them in O(N + M).
+
+   The iterators are plain pointers, so a FlatSet is a random access sorted
+   range: the trees' Intersect() accepts one, and seeks through it by
+   galloping. */
+
+template<class T>
+class FlatSet
+{
+public:
+    typedef const T* ConstIterator;
+
+    FlatSet();
+    virtual ~FlatSet(); // custom destructor (rule of 5)
+    FlatSet(const FlatSet& other); // copy constructor (rule of 5)
+    FlatSet<T>& operator=(const FlatSet& other); // copy assignment operator (rule of 5)
+    FlatSet(FlatSet<T>&& other); // move constructor (rule of 5)
+    FlatSet<T>& operator=(FlatSet&& other); // move assignment operator (rule of 5)
+
+    // Place an item in the set. Complexity is O(log N) to find its place, plus O(N) to make room.
+    void Insert(const T& item);
+
+    // Remove item from the set. Complexity is O(log N) to find it, plus O(N) to close the gap.
+    void Remove(const T& item);
+
+    // Retrieve item from the set. Complexity is O(log N).
+    bool Search(const T& item) const;
+
+    /* Retrieve the stored item which is equal to the given one, or nullptr.
+       The argument may be of any type comparable with T. O(log N) */
+    template<typename U>
+    const T* Find(const U& item) const;
+
+    // Returns the first item which is not less than the given one, or end(). O(log N)
+    template<typename U>
+    ConstIterator LowerBound(const U& item) const;
+
+    /* Merge a range sorted in ascending order into the set, in a single
+       pass. Items already present are skipped. O(N + M) */
+    template<typename U>
+    void InsertSorted(const U& sortedRange);
+
+    /* Create the intersection of this set with any sorted range (a tree,
+       another FlatSet, a sorted List, an array, etc.). See
+       SortedRange::ForEachCommon(). */
+    template<typename U>
+    FlatSet<T> Intersect(const U& other) const;
+
+    // Make room for at least capacity items, so that inserting up to that many doesn't reallocate.
+    void Reserve(size_t capacity);
+
+    // Returns the number of items in the set. O(1)
+    size_t Size() const;
+
+    void Clear();
+
+    /* Consistency check. Returns true if the set
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+protected:
+private:
+    // Appends an item known to follow every item in the set.
+    void AppendUnchecked(const T& item);
+
+    // Moves the items into new storage of the given capacity.
+    void Reallocate(size_t newCapacity);
+
+    static T* Allocate(size_t count);
+    static void Destroy(T* storage, size_t count);
+
+    T* items;
+    size_t size;
+    size_t capacity;
+};
+
+
+template<class T>
+FlatSet<T>::FlatSet()
+    : items(nullptr), size(0), capacity(0)
+{}
+
+
+template<class T>
+FlatSet<T>::~FlatSet()
+{
+    Destroy(items, size);
+}
+
+
+template<class T>
+FlatSet<T>::FlatSet(const FlatSet<T>& other) // copy constructor
+    : items(nullptr), size(0), capacity(0)
+{
+    Reserve(other.size);
+    for (const T& item : other)
+        AppendUnchecked(item);
+}
+
+
+template<class T>
+FlatSet<T>& FlatSet<T>::operator=(const FlatSet& other) // copy assignment operator
+{
+    if (this == &other)
+        return *this;
+    Clear();
+    Reserve(other.size);
+    for (const T& item : other)
+        AppendUnchecked(item);
+    return *this;
+}
+
+
+template<class T>
+FlatSet<T>::FlatSet(FlatSet<T>&& other) // move constructor
+    : items(other.items), size(other.size), capacity(other.capacity)
+{
+    other.items = nullptr;
+    other.size = 0;
+    other.capacity = 0;
+}
+
+
+template<class T>
+FlatSet<T>& FlatSet<T>::operator=(FlatSet&& other) // move assignment operator
+{
+    Destroy(items, size);
+    items = other.items;
+    size = other.size;
+    capacity = other.capacity;
+
+    other.items = nullptr;
+    other.size = 0;
+    other.capacity = 0;
+
+    return *this;
+}
+
+
+template<class T>
+void FlatSet<T>::Insert(const T& item)
+{
+    size_t position = LowerBound(item) - items;
+    if (position < size && !(item < items[position]))
+        return; // They're equal.
+
+    if (size == capacity)
+    {
+        // Reallocate, leaving a gap at position.
+        size_t newCapacity = capacity > 0 ? capacity * 2 : 4;
+        T* newItems = Allocate(newCapacity);
+        for (size_t i = 0; i < position; i++)
+            new (newItems + i) T(std::move(items[i]));
+        new (newItems + position) T(item);
+        for (size_t i = position; i < size; i++)
+            new (newItems + i + 1) T(std::move(items[i]));
+        Destroy(items, size);
+        items = newItems;
+        capacity = newCapacity;
+        size++;
+        return;
+    }
+
+    if (position == size)
+    {
+        new (items + size) T(item);
+        size++;
+        return;
+    }
+
+    // Shift the tail up by one, then overwrite the vacated slot.
+    T copy(item); // item may refer into this set.
+    new (items + size) T(std::move(items[size - 1]));
+    for (size_t i = size - 1; i > position; i--)
+        items[i] = std::move(items[i - 1]);
+    items[position] = std::move(copy);
+    size++;
+}
+
+
+template<class T>
+void FlatSet<T>::Remove(const T& item)
+{
+    size_t position = LowerBound(item) - items;
+    if (position == size || item < items[position])
+        return; // The set doesn't contain the specified item.
+    for (size_t i = position + 1; i < size; i++)
+        items[i - 1] = std::move(items[i]);
+    size--;
+    items[size].~T();
+}
+
+
+template<class T>
+bool FlatSet<T>::Search(const T& item) const
+{
+    return Find(item) != nullptr;
+}
+
+
+template<class T>
+template<typename U>
+const T* FlatSet<T>::Find(const U& item) const
+{
+    ConstIterator found = LowerBound(item);
+    if (found == end() || item < *found)
+        return nullptr;
+    return found;
+}
+
+
+template<class T>
+template<typename U>
+typename FlatSet<T>::ConstIterator FlatSet<T>::LowerBound(const U& item) const
+{
+    // Halve the candidate range until it's empty. first is then the lower bound.
+    const T* first = items;
+    size_t count = size;
+    while (count > 0)
+    {
+        size_t half = count / 2;
+        if (first[half] < item)
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+    return first;
+}
+
+
+template<class T>
+template<typename U>
+void FlatSet<T>::InsertSorted(const U& sortedRange)
+{
+    size_t rangeSize = SortedRange::Size(sortedRange);
+    if (rangeSize == SortedRange::UnknownSize)
+    {
+        rangeSize = 0;
+        for (SortedRangeIterator<U> itr = SortedRange::Begin(sortedRange); itr != SortedRange::End(sortedRange); ++itr)
+            rangeSize++;
+    }
+    if (rangeSize == 0)
+        return;
+
+    // Merge into new storage, skipping duplicates from either side.
+    FlatSet<T> merged;
+    merged.Reserve(size + rangeSize);
+    size_t i = 0;
+    SortedRangeIterator<U> itr = SortedRange::Begin(sortedRange);
+    SortedRangeIterator<U> end = SortedRange::End(sortedRange);
+    while (i < size || itr != end)
+    {
+        const T* next;
+        if (!(itr != end) || (i < size && items[i] < *itr)) // Tree iterators only provide !=.
+            next = &items[i++];
+        else if (i < size && !(*itr < items[i]))
+        {
+            next = &items[i++]; // Equal. Keep the existing item.
+            ++itr;
+        }
+        else
+        {
+            next = &*itr;
+            ++itr;
+        }
+        if (merged.size == 0 || merged.items[merged.size - 1] < *next)
+            merged.AppendUnchecked(*next);
+    }
+    *this = std::move(merged);
+}
+
+
+template<class T>
+template<typename U>
+FlatSet<T> FlatSet<T>::Intersect(const U& other) const
+{
+    FlatSet<T> intersection;
+    SortedRange::ForEachCommon(*this, other, [&intersection](const T& item)
+    {
+        intersection.AppendUnchecked(item);
+        return true;
+    });
+    return intersection;
+}
+
+
+template<class T>
+void FlatSet<T>::Reserve(size_t newCapacity)
+{
+    if (newCapacity > capacity)
+        Reallocate(newCapacity);
+}
+
+
+template<class T>
+void FlatSet<T>::AppendUnchecked(const T& item)
+{
+    if (size == capacity)
+        Reallocate(capacity > 0 ? capacity * 2 : 4);
+    new (items + size) T(item);
+    size++;
+}
+
+
+template<class T>
+void FlatSet<T>::Reallocate(size_t newCapacity)
+{
+    T* newItems = Allocate(newCapacity);
+    for (size_t i = 0; i < size; i++)
+        new (newItems + i) T(std::move(items[i]));
+    Destroy(items, size);
+    items = newItems;
+    capacity = newCapacity;
+}
+
+
+template<class T>
+T* FlatSet<T>::Allocate(size_t count)
+{
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+}
+
+
+template<class T>
+void FlatSet<T>::Destroy(T* storage, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        storage[i].~T();
+    ::operator delete(storage);
+}
+
+
+template<class T>
+size_t FlatSet<T>::Size() const
+{
+    return size;
+}
+
+
+template<class T>
+void FlatSet<T>::Clear()
+{
+    for (size_t i = 0; i < size; i++)
+        items[i].~T();
+    size = 0;
+}
+
+
+template<class T>
+typename FlatSet<T>::ConstIterator FlatSet<T>::begin() const
+{
+    return items;
+}
+
+
+template<class T>
+typename FlatSet<T>::ConstIterator FlatSet<T>::end() const
+{
+    return items + size;
+}
+
+
+template<class T>
+bool FlatSet<T>::IsValid() const
+{
+    if (size > capacity || (capacity > 0 && items == nullptr))
+        return false;
+    for (size_t i = 1; i < size; i++)
+    {
+        if (!(items[i - 1] < items[i]))
+            return false;
+    }
+    return true;
+}
+
+
+template class FlatSet<int>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -0,0 +1,340 @@
+#ifndef _INTERVALTREE_H_
+#define _INTERVALTREE_H_
+
+#include <limits>
+#include "avltree.h"
+
+/* Interval tree
+
+   Bob Burrough, 2021
+
+   Store closed intervals [low, high] and find those which overlap a given
+   interval or contain a given point. Built on AVLTree, ordered by low
+   endpoint, and augmented with the largest high endpoint of each subtree.
+   A search skips every subtree whose largest high endpoint falls short of
+   the query, and everything to the right of an interval which starts past
+   it.
+
+   Like the trees, iteration uses no recursion and allocates no memory.
+   Overlapping intervals are reported in ascending order. */
+
+template<class T>
+class Interval
+{
+public:
+    Interval(const T& low_, const T& high_);
+    T low;
+    T high;
+
+    bool Overlaps(const T& otherLow, const T& otherHigh) const;
+
+    // Ordered by low endpoint, then by high endpoint.
+    bool operator<(const Interval<T>& other) const;
+    bool operator>(const Interval<T>& other) const;
+    bool operator==(const Interval<T>& other) const;
+    bool operator!=(const Interval<T>& other) const;
+private:
+    Interval() = delete;
+};
+
+
+// Augmentation which keeps the largest high endpoint of each subtree. See augmentation.h.
+template<class T>
+struct MaxEndpointAugmentation
+{
+    typedef T Value;
+    static Value Identity() { return std::numeric_limits<T>::lowest(); }
+    static Value Lift(const Interval<T>& item) { return item.high; }
+    static Value Combine(const Value& a, const Value& b) { return a < b ? b : a; }
+};
+
+
+template<class T>
+class IntervalTree : public AVLTree<Interval<T>, MaxEndpointAugmentation<T>>
+{
+    typedef AVLTree<Interval<T>, MaxEndpointAugmentation<T>> Base;
+    typedef typename Base::Node Node;
+
+public:
+    using Base::Insert;
+    using Base::Remove;
+
+    // Place the interval [low, high] in the tree. Complexity is O(log N).
+    void Insert(const T& low, const T& high);
+
+    // Remove the interval [low, high] from the tree. Complexity is O(log N).
+    void Remove(const T& low, const T& high);
+
+    class OverlapRange;
+
+    /* Returns a range over the intervals which overlap [low, high], for use
+       in a range-based for loop. Each interval reported costs O(log N) at
+       most, and subtrees which can't hold a match are never entered. */
+    OverlapRange Overlapping(const T& low, const T& high) const;
+
+    // Returns a range over the intervals which contain the point.
+    OverlapRange Stabbing(const T& point) const;
+
+    class ConstOverlapIterator
+    {
+    public:
+        ConstOverlapIterator(); // This constructor creates an empty iterator which is equal to end().
+
+        ConstOverlapIterator& operator++();
+        bool operator!=(const ConstOverlapIterator& other) const;
+        const Interval<T>& operator*() const;
+
+        friend class IntervalTree<T>;
+
+    protected:
+    private:
+        ConstOverlapIterator(const Node* root, const T& low_, const T& high_);
+        bool Viable(const Node* node) const; // Whether node's subtree might hold a match.
+        const Node* Leftmost(const Node* node) const; // First viable node of a viable subtree, in order.
+        void Step(); // Advance to the next viable node, in order.
+        void Settle(); // Advance until current overlaps, or the search is over.
+        const Node* current;
+        T low;
+        T high;
+    };
+
+    class OverlapRange
+    {
+    public:
+        OverlapRange(const ConstOverlapIterator& first_);
+        ConstOverlapIterator begin() const;
+        ConstOverlapIterator end() const;
+
+    protected:
+    private:
+        OverlapRange() = delete;
+        ConstOverlapIterator first;
+    };
+};
+
+
+template<class T>
+Interval<T>::Interval(const T& low_, const T& high_)
+    : low(low_), high(high_)
+{}
+
+
+template<class T>
+bool Interval<T>::Overlaps(const T& otherLow, const T& otherHigh) const
+{
+    return !(otherHigh < low) && !(high < otherLow);
+}
+
+
+template<class T>
+bool Interval<T>::operator<(const Interval<T>& other) const
+{
+    return low < other.low || (!(other.low < low) && high < other.high);
+}
+
+
+template<class T>
+bool Interval<T>::operator>(const Interval<T>& other) const
+{
+    return other < *this;
+}
+
+
+template<class T>
+bool Interval<T>::operator==(const Interval<T>& other) const
+{
+    return low == other.low && high == other.high;
+}
+
+
+template<class T>
+bool Interval<T>::operator!=(const Interval<T>& other) const
+{
+    return !(*this == other);
+}
+
+
+template<class T>
+void IntervalTree<T>::Insert(const T& low, const T& high)
+{
+    Base::Insert(Interval<T>(low, high));
+}
+
+
+template<class T>
+void IntervalTree<T>::Remove(const T& low, const T& high)
+{
+    Base::Remove(Interval<T>(low, high));
+}
+
+
+template<class T>
+typename IntervalTree<T>::OverlapRange IntervalTree<T>::Overlapping(const T& low, const T& high) const
+{
+    return OverlapRange(ConstOverlapIterator(this->root, low, high));
+}
+
+
+template<class T>
+typename IntervalTree<T>::OverlapRange IntervalTree<T>::Stabbing(const T& point) const
+{
+    return Overlapping(point, point);
+}
+
+
+template<class T>
+IntervalTree<T>::ConstOverlapIterator::ConstOverlapIterator()
+    : current(nullptr), low(), high()
+{}
+
+
+template<class T>
+IntervalTree<T>::ConstOverlapIterator::ConstOverlapIterator(const Node* root, const T& low_, const T& high_)
+    : current(nullptr), low(low_), high(high_)
+{
+    if (Viable(root))
+    {
+        current = Leftmost(root);
+        Settle();
+    }
+}
+
+
+template<class T>
+bool IntervalTree<T>::ConstOverlapIterator::Viable(const Node* node) const
+{
+    return node != nullptr && !(node->aggregate < low);
+}
+
+
+template<class T>
+const typename IntervalTree<T>::Node* IntervalTree<T>::ConstOverlapIterator::Leftmost(const Node* node) const
+{
+    while (Viable(node->left))
+        node = node->left;
+    return node;
+}
+
+
+template<class T>
+void IntervalTree<T>::ConstOverlapIterator::Settle()
+{
+    while (current != nullptr)
+    {
+        if (high < current->item.low)
+        {
+            // This interval, and every one after it, starts past the query.
+            current = nullptr;
+            return;
+        }
+        if (!(current->item.high < low))
+            return; // overlaps
+        Step();
+    }
+}
+
+
+/* Ancestors reached by climbing out of a left subtree contain that subtree,
+   so they're viable too. Only right subtrees need checking. */
+template<class T>
+void IntervalTree<T>::ConstOverlapIterator::Step()
+{
+    if (Viable(current->right))
+        current = Leftmost(current->right);
+    else
+    {
+        while (current->parent != nullptr && current->parent->right == current)
+            current = current->parent;
+        current = current->parent;
+    }
+}
+
+
+template<class T>
+typename IntervalTree<T>::ConstOverlapIterator& IntervalTree<T>::ConstOverlapIterator::operator++()
+{
+    Step();
+    Settle();
+    return *this;
+}
+
+
+template<class T>
+bool IntervalTree<T>::ConstOverlapIterator::operator!=(const ConstOverlapIterator& other) const
+{
+    return current != other.current;
+}
+
+
+template<class T>
+const Interval<T>& IntervalTree<T>::ConstOverlapIterator::operator*() const
+{
+    return current->item;
+}
+
+
+template<class T>
+IntervalTree<T>::OverlapRange::OverlapRange(const ConstOverlapIterator& first_)
+    : first(first_)
+{}
+
+
+template<class T>
+typename IntervalTree<T>::ConstOverlapIterator IntervalTree<T>::OverlapRange::begin() const
+{
+    return first;
+}
+
+
+template<class T>
+typename IntervalTree<T>::ConstOverlapIterator IntervalTree<T>::OverlapRange::end() const
+{
+    return ConstOverlapIterator();
+}
+
+
+template class IntervalTree<int>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -0,0 +1,628 @@
+#ifndef _INTRUSIVEAVLTREE_H_
+#define _INTRUSIVEAVLTREE_H_
+
+#include <cstddef>
+
+/* IntrusiveAVLTree
+
+   Bob Burrough, 2021
+
+   Implementation of an intrusive AVL tree. The tree links objects owned by
+   the caller through an AVLHook member of the object, which holds the
+   child and parent links and the balance factor:
+
+       struct Connection
+       {
+           int id;
+           string name;
+           AVLHook<Connection> byId;
+           AVLHook<Connection> byName;
+       };
+       IntrusiveAVLTree<Connection, &Connection::byId, ById> ids;
+       IntrusiveAVLTree<Connection, &Connection::byName, ByName> names;
+
+   Insert() and Remove() never allocate, and Remove() needs no search, since
+   the object's hook records its place in the tree. The optional Compare
+   orders the objects, by operator< if not given, so that each hook of an
+   object can index it by a different key. The caller must keep an object
+   alive, unmoved and with its key unchanged while it's linked. */
+
+
+template<class T>
+class AVLHook
+{
+public:
+    AVLHook() : left(nullptr), right(nullptr), parent(nullptr), balanceFactor(0) {}
+    AVLHook(const AVLHook&) : left(nullptr), right(nullptr), parent(nullptr), balanceFactor(0) {} // A copy of an object isn't linked anywhere.
+    AVLHook& operator=(const AVLHook&) { return *this; } // Nor does assignment change the links.
+
+    template<class U, AVLHook<U> U::*Hook, class Compare> friend class IntrusiveAVLTree;
+
+protected:
+private:
+    T* left;
+    T* right;
+    T* parent;
+    int balanceFactor;
+};
+
+
+// The default ordering of an IntrusiveAVLTree. Also compares objects with keys, for Find().
+struct IntrusiveLess
+{
+    template<class L, class R>
+    bool operator()(const L& lhs, const R& rhs) const { return lhs < rhs; }
+};
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare = IntrusiveLess>
+class IntrusiveAVLTree
+{
+public:
+    IntrusiveAVLTree(Compare compare_ = Compare());
+    IntrusiveAVLTree(const IntrusiveAVLTree& other) = delete; // An object can only be linked into one tree per hook.
+    IntrusiveAVLTree<T, Hook, Compare>& operator=(const IntrusiveAVLTree& other) = delete;
+
+    /* Link an object into the tree. Returns false, leaving the object
+       unlinked, if an equal object is already present. O(log N) */
+    bool Insert(T& item);
+
+    // Unlink an object, which must be in this tree. O(log N)
+    void Remove(T& item);
+
+    /* Returns the object equal to the given key, or nullptr. The key may be
+       of any type which Compare can compare with T in both orders. O(log N) */
+    template<typename U>
+    T* Find(const U& key) const;
+
+    // returns true if the tree contains no elements
+    bool IsEmpty() const;
+
+    // returns the number of elements contained in the tree
+    size_t Size() const;
+
+    // Unlinks every object. The objects themselves, including their hooks, are untouched. O(1)
+    void Clear();
+
+    /* Consistency check. Returns true if the tree
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+protected:
+private:
+    static AVLHook<T>& HookOf(T* item) { return item->*Hook; }
+
+    static T* RightRotate(T* node);
+    static T* LeftRotate(T* node);
+    static T* Balance(T* node); // Rebalances the node such that the balanceFactor becomes -1, 0, or +1.
+
+    void ReplaceChild(T* parent, T* child, T* replacement);
+    static int Height(const T* node); // For validation only. Walks the parent links rather than recursing.
+
+    Compare compare;
+    T* root;
+    size_t size;
+
+    // Iterator declarations
+public:
+    class ConstIterator
+    {
+    public:
+        ConstIterator();
+        ConstIterator(T* start);
+        ConstIterator& operator++();
+        bool operator==(const ConstIterator& other) const;
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+    protected:
+    private:
+        T* current;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+IntrusiveAVLTree<T, Hook, Compare>::IntrusiveAVLTree(Compare compare_)
+    : compare(compare_), root(nullptr), size(0)
+{}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+bool IntrusiveAVLTree<T, Hook, Compare>::Insert(T& item)
+{
+    T* current(root);
+    T* previous(nullptr);
+    bool left = false;
+    while (current != nullptr)
+    {
+        previous = current;
+        left = compare(item, *current);
+        if (left)
+            current = HookOf(current).left;
+        else if (compare(*current, item))
+            current = HookOf(current).right;
+        else
+            return false; // They're equal.
+    }
+
+    AVLHook<T>& hook = HookOf(&item);
+    hook.left = nullptr;
+    hook.right = nullptr;
+    hook.parent = previous;
+    hook.balanceFactor = 0;
+    size++;
+    if (previous == nullptr)
+    {
+        root = &item;
+        return true;
+    }
+    if (left)
+        HookOf(previous).left = &item;
+    else
+        HookOf(previous).right = &item;
+
+    /* Walk back up, updating balance factors, until a node's height is
+       unchanged or a rotation restores it. See AVLTree::InsertNode(). */
+    T* child = &item;
+    T* balancePoint = previous;
+    while (balancePoint != nullptr)
+    {
+        AVLHook<T>& balanceHook = HookOf(balancePoint);
+        if (balanceHook.left == child)
+            balanceHook.balanceFactor--;
+        else
+            balanceHook.balanceFactor++;
+
+        if (balanceHook.balanceFactor == 0)
+            break;
+
+        if (balanceHook.balanceFactor == -2 || balanceHook.balanceFactor == 2)
+        {
+            T* balancePointPredecessor = balanceHook.parent;
+            ReplaceChild(balancePointPredecessor, balancePoint, Balance(balancePoint));
+            break;
+        }
+
+        child = balancePoint;
+        balancePoint = balanceHook.parent;
+    }
+    return true;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+void IntrusiveAVLTree<T, Hook, Compare>::Remove(T& item)
+{
+    size--;
+    T* current = &item;
+
+    if (HookOf(current).left != nullptr && HookOf(current).right != nullptr)
+    {
+        /* current has both left and right children. Swap its place in the
+           tree with its successor, which has no left child. See
+           AVLTree::Detach(). */
+        T* replacement = HookOf(current).right;
+        while (HookOf(replacement).left != nullptr)
+            replacement = HookOf(replacement).left;
+
+        AVLHook<T>& currentHook = HookOf(current);
+        AVLHook<T>& replacementHook = HookOf(replacement);
+        T* parent = currentHook.parent;
+        T* replacementRight = replacementHook.right;
+        if (replacement == currentHook.right)
+        {
+            replacementHook.right = current;
+            currentHook.parent = replacement;
+        }
+        else
+        {
+            replacementHook.right = currentHook.right;
+            HookOf(replacementHook.right).parent = replacement;
+            HookOf(replacementHook.parent).left = current;
+            currentHook.parent = replacementHook.parent;
+        }
+        replacementHook.left = currentHook.left;
+        HookOf(replacementHook.left).parent = replacement;
+        replacementHook.parent = parent;
+        ReplaceChild(parent, current, replacement);
+
+        currentHook.left = nullptr;
+        currentHook.right = replacementRight;
+        if (replacementRight != nullptr)
+            HookOf(replacementRight).parent = current;
+
+        int balanceFactor = currentHook.balanceFactor;
+        currentHook.balanceFactor = replacementHook.balanceFactor;
+        replacementHook.balanceFactor = balanceFactor;
+    }
+
+    // current now has at most one child, which takes its place.
+    AVLHook<T>& currentHook = HookOf(current);
+    T* child = currentHook.left != nullptr ? currentHook.left : currentHook.right;
+    T* balancePoint = currentHook.parent;
+    if (child != nullptr)
+        HookOf(child).parent = balancePoint;
+    currentHook.left = nullptr;
+    currentHook.right = nullptr;
+    currentHook.parent = nullptr;
+    if (balancePoint == nullptr)
+    {
+        root = child;
+        return;
+    }
+
+    bool shortenedLeft = HookOf(balancePoint).left == current;
+    if (shortenedLeft)
+        HookOf(balancePoint).left = child;
+    else
+        HookOf(balancePoint).right = child;
+
+    // Walk back up for as long as the subtree below has become shorter.
+    while (balancePoint != nullptr)
+    {
+        if (shortenedLeft)
+            HookOf(balancePoint).balanceFactor++;
+        else
+            HookOf(balancePoint).balanceFactor--;
+
+        int balanceFactor = HookOf(balancePoint).balanceFactor;
+        if (balanceFactor == 1 || balanceFactor == -1)
+            break;
+
+        if (balanceFactor == 2 || balanceFactor == -2)
+        {
+            T* balancePointPredecessor = HookOf(balancePoint).parent;
+            T* substituteNode = Balance(balancePoint);
+            ReplaceChild(balancePointPredecessor, balancePoint, substituteNode);
+
+            if (HookOf(substituteNode).balanceFactor != 0)
+                break; // The subtree is as tall as before.
+            balancePoint = substituteNode;
+        }
+
+        T* parent = HookOf(balancePoint).parent;
+        if (parent != nullptr)
+            shortenedLeft = HookOf(parent).left == balancePoint;
+        balancePoint = parent;
+    }
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+void IntrusiveAVLTree<T, Hook, Compare>::ReplaceChild(T* parent, T* child, T* replacement)
+{
+    if (parent == nullptr)
+        root = replacement;
+    else if (HookOf(parent).left == child)
+        HookOf(parent).left = replacement;
+    else
+        HookOf(parent).right = replacement;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+T* IntrusiveAVLTree<T, Hook, Compare>::RightRotate(T* node)
+{
+    AVLHook<T>& hook = HookOf(node);
+    T* q(hook.left);
+    AVLHook<T>& qHook = HookOf(q);
+    hook.left = qHook.right;
+    if (qHook.right != nullptr)
+        HookOf(qHook.right).parent = node;
+    qHook.right = node;
+    qHook.parent = hook.parent;
+    hook.parent = q;
+    int newBalanceThis = hook.balanceFactor + 1 - (qHook.balanceFactor < 0 ? qHook.balanceFactor : 0);
+    int newBalanceQ = qHook.balanceFactor + 1 + (newBalanceThis > 0 ? newBalanceThis : 0);
+    hook.balanceFactor = newBalanceThis;
+    qHook.balanceFactor = newBalanceQ;
+    return q;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+T* IntrusiveAVLTree<T, Hook, Compare>::LeftRotate(T* node)
+{
+    AVLHook<T>& hook = HookOf(node);
+    T* q(hook.right);
+    AVLHook<T>& qHook = HookOf(q);
+    hook.right = qHook.left;
+    if (qHook.left != nullptr)
+        HookOf(qHook.left).parent = node;
+    qHook.left = node;
+    qHook.parent = hook.parent;
+    hook.parent = q;
+    int newBalanceThis = hook.balanceFactor - 1 - (qHook.balanceFactor > 0 ? qHook.balanceFactor : 0);
+    int newBalanceQ = qHook.balanceFactor - 1 + (newBalanceThis < 0 ? newBalanceThis : 0);
+    hook.balanceFactor = newBalanceThis;
+    qHook.balanceFactor = newBalanceQ;
+    return q;
+}
+
+
+/* A precondition for Balance is that the balanceFactor of the node
+   and its immediate descendants must be accurate, and that the node
+   has a balanceFactor of 2 or -2. Returns the subtree's new root. */
+template<class T, AVLHook<T> T::*Hook, class Compare>
+T* IntrusiveAVLTree<T, Hook, Compare>::Balance(T* node)
+{
+    AVLHook<T>& hook = HookOf(node);
+    if (hook.balanceFactor == -2)
+    {
+        if (HookOf(hook.left).balanceFactor == 1)
+            hook.left = LeftRotate(hook.left);
+        return RightRotate(node);
+    }
+    if (HookOf(hook.right).balanceFactor == -1)
+        hook.right = RightRotate(hook.right);
+    return LeftRotate(node);
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+template<typename U>
+T* IntrusiveAVLTree<T, Hook, Compare>::Find(const U& key) const
+{
+    T* current(root);
+    while (current != nullptr)
+    {
+        if (compare(*current, key))
+            current = HookOf(current).right;
+        else if (compare(key, *current))
+            current = HookOf(current).left;
+        else
+            return current;
+    }
+    return nullptr;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+bool IntrusiveAVLTree<T, Hook, Compare>::IsEmpty() const
+{
+    return size == 0;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+size_t IntrusiveAVLTree<T, Hook, Compare>::Size() const
+{
+    return size;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+void IntrusiveAVLTree<T, Hook, Compare>::Clear()
+{
+    root = nullptr;
+    size = 0;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+IntrusiveAVLTree<T, Hook, Compare>::ConstIterator::ConstIterator() // This also happens to be equivalent to IntrusiveAVLTree::end()
+    : current(nullptr)
+{}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+IntrusiveAVLTree<T, Hook, Compare>::ConstIterator::ConstIterator(T* start)
+    : current(start)
+{
+    if (current == nullptr)
+        return;
+    while (HookOf(current).left != nullptr)
+        current = HookOf(current).left;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+typename IntrusiveAVLTree<T, Hook, Compare>::ConstIterator& IntrusiveAVLTree<T, Hook, Compare>::ConstIterator::operator++()
+{
+    if (HookOf(current).right != nullptr)
+    {
+        current = HookOf(current).right;
+        while (HookOf(current).left != nullptr)
+            current = HookOf(current).left;
+        return *this;
+    }
+    // Ascend past every ancestor whose right subtree we're leaving.
+    T* child = current;
+    current = HookOf(current).parent;
+    while (current != nullptr && HookOf(current).right == child)
+    {
+        child = current;
+        current = HookOf(current).parent;
+    }
+    return *this;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+bool IntrusiveAVLTree<T, Hook, Compare>::ConstIterator::operator==(const ConstIterator& other) const
+{
+    return current == other.current;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+bool IntrusiveAVLTree<T, Hook, Compare>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return current != other.current;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+const T& IntrusiveAVLTree<T, Hook, Compare>::ConstIterator::operator*() const
+{
+    return *current;
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+typename IntrusiveAVLTree<T, Hook, Compare>::ConstIterator IntrusiveAVLTree<T, Hook, Compare>::begin() const
+{
+    return ConstIterator(root);
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+typename IntrusiveAVLTree<T, Hook, Compare>::ConstIterator IntrusiveAVLTree<T, Hook, Compare>::end() const
+{
+    return ConstIterator(nullptr);
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+int IntrusiveAVLTree<T, Hook, Compare>::Height(const T* node)
+{
+    if (node == nullptr)
+        return 0;
+    const T* current = node;
+    int currentHeight = 1;
+    int maxHeight = 0;
+
+    while ((current->*Hook).left != nullptr) // descend leftward as far as possible
+    {
+        current = (current->*Hook).left;
+        currentHeight++;
+    }
+
+    for (;;)
+    {
+        if (currentHeight > maxHeight)
+            maxHeight = currentHeight;
+
+        if ((current->*Hook).right != nullptr) // descend rightward one step
+        {
+            current = (current->*Hook).right;
+            currentHeight++;
+
+            while ((current->*Hook).left != nullptr) // descend leftward as far as possible
+            {
+                current = (current->*Hook).left;
+                currentHeight++;
+            }
+        }
+        else
+        {
+            // ascend, skipping any previously visited nodes
+            while (current != node && ((current->*Hook).parent->*Hook).right == current)
+            {
+                current = (current->*Hook).parent;
+                currentHeight--;
+            }
+            if (current == node)
+                return maxHeight;
+            current = (current->*Hook).parent;
+            currentHeight--;
+        }
+    }
+}
+
+
+template<class T, AVLHook<T> T::*Hook, class Compare>
+bool IntrusiveAVLTree<T, Hook, Compare>::IsValid() const
+{
+    if (root != nullptr && (root->*Hook).parent != nullptr)
+        return false;
+
+    /* Walk the tree in order. Each child's parent link is checked before
+       descending to it, so every ascent follows a checked link. */
+    size_t elementCount = 0;
+    const T* previous = nullptr;
+    const T* current = root;
+    while (current != nullptr && (current->*Hook).left != nullptr)
+    {
+        if (((current->*Hook).left->*Hook).parent != current)
+            return false;
+        current = (current->*Hook).left;
+    }
+    while (current != nullptr)
+    {
+        const AVLHook<T>& hook = current->*Hook;
+        if (previous != nullptr && !compare(*previous, *current))
+            return false; // In order, every item must be strictly greater than the last.
+        if (hook.balanceFactor < -1 || hook.balanceFactor > 1 || Height(hook.right) - Height(hook.left) != hook.balanceFactor)
+            return false;
+        previous = current;
+        elementCount++;
+
+        if (hook.right != nullptr)
+        {
+            if ((hook.right->*Hook).parent != current)
+                return false;
+            current = hook.right;
+            while ((current->*Hook).left != nullptr)
+            {
+                if (((current->*Hook).left->*Hook).parent != current)
+                    return false;
+                current = (current->*Hook).left;
+            }
+        }
+        else
+        {
+            while ((current->*Hook).parent != nullptr && ((current->*Hook).parent->*Hook).right == current)
+                current = (current->*Hook).parent;
+            current = (current->*Hook).parent;
+        }
+    }
+    return elementCount == size;
+}
+
+
+struct IntrusiveAVLTreeExample
+{
+    int value;
+    AVLHook<IntrusiveAVLTreeExample> hook;
+    bool operator<(const IntrusiveAVLTreeExample& other) const { return value < other.value; }
+};
+template class IntrusiveAVLTree<IntrusiveAVLTreeExample, &IntrusiveAVLTreeExample::hook>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
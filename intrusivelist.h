@@ -0,0 +1,397 @@
+#ifndef _INTRUSIVELIST_H_
+#define _INTRUSIVELIST_H_
+
+#include <cstddef>
+
+/* IntrusiveList
+
+   Bob Burrough, 2021
+
+   Implementation of an intrusive singly-linked list. Rather than copying
+   items into nodes of its own, the list links objects owned by the caller
+   through a ListHook member of the object, named by the second template
+   parameter:
+
+       struct Connection
+       {
+           ListHook<Connection> byAge;
+           ...
+       };
+       IntrusiveList<Connection, &Connection::byAge> connections;
+
+   Nothing is allocated or copied. An object with several hooks can be in
+   several lists (or trees, see intrusiveavltree.h) at once, but only in one
+   list per hook. The caller must keep an object alive, and not move it,
+   while it's linked. */
+
+
+template<class T>
+class ListHook
+{
+public:
+    ListHook() : next(nullptr) {}
+    ListHook(const ListHook&) : next(nullptr) {} // A copy of an object isn't linked anywhere.
+    ListHook& operator=(const ListHook&) { return *this; } // Nor does assignment change the links.
+
+    template<class U, ListHook<U> U::*Hook> friend class IntrusiveList;
+
+protected:
+private:
+    T* next;
+};
+
+
+template<class T, ListHook<T> T::*Hook>
+class IntrusiveList
+{
+public:
+    IntrusiveList();
+    IntrusiveList(const IntrusiveList& other) = delete; // An object can only be linked into one list per hook.
+    IntrusiveList<T, Hook>& operator=(const IntrusiveList& other) = delete;
+    IntrusiveList(IntrusiveList<T, Hook>&& other);
+    IntrusiveList<T, Hook>& operator=(IntrusiveList&& other);
+
+    // Link an object at the front of the list. O(1)
+    void Insert(T& item);
+
+    // Link an object at the end of the list. O(1)
+    void Append(T& item);
+
+    // Unlink the object at the front of the list, if there is one. O(1)
+    void PopFront();
+
+    // Unlink an object. Returns false if it isn't in the list. O(n)
+    bool Remove(T& item);
+
+    // The first and last objects. The list must not be empty. O(1)
+    T& Front() const;
+    T& Back() const;
+
+    // Reverses the list. O(n)
+    void Reverse();
+
+    // returns true if the list contains no elements
+    bool IsEmpty() const;
+
+    // returns the number of elements contained in the list
+    size_t Size() const;
+
+    // Unlinks every object. The objects themselves are untouched. O(1)
+    void Clear();
+
+    /* Consistency check. Returns true if the list
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+protected:
+private:
+    static T*& Next(T* item) { return (item->*Hook).next; }
+
+    T* head;
+    T* tail;
+    size_t size;
+
+    // Iterator declarations
+public:
+    class ConstIterator
+    {
+    public:
+        ConstIterator();
+        ConstIterator(T* start);
+        ConstIterator& operator++();
+        bool operator==(const ConstIterator& other) const;
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+    protected:
+    private:
+        T* current;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+
+template<class T, ListHook<T> T::*Hook>
+IntrusiveList<T, Hook>::IntrusiveList()
+    : head(nullptr), tail(nullptr), size(0)
+{}
+
+
+template<class T, ListHook<T> T::*Hook>
+IntrusiveList<T, Hook>::IntrusiveList(IntrusiveList<T, Hook>&& other) // move constructor
+    : head(other.head), tail(other.tail), size(other.size)
+{
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+IntrusiveList<T, Hook>& IntrusiveList<T, Hook>::operator=(IntrusiveList&& other) // move assignment operator
+{
+    head = other.head;
+    tail = other.tail;
+    size = other.size;
+
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+
+    return *this;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::Insert(T& item)
+{
+    Next(&item) = head;
+    head = &item;
+    if (tail == nullptr)
+        tail = &item;
+    size++;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::Append(T& item)
+{
+    Next(&item) = nullptr;
+    if (head == nullptr)
+        head = &item;
+    if (tail != nullptr)
+        Next(tail) = &item;
+    tail = &item;
+    size++;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::PopFront()
+{
+    if (head == nullptr)
+        return;
+    T* front = head;
+    head = Next(front);
+    if (head == nullptr)
+        tail = nullptr;
+    Next(front) = nullptr;
+    size--;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::Remove(T& item)
+{
+    T* previous = nullptr;
+    T* current = head;
+    while (current != nullptr && current != &item)
+    {
+        previous = current;
+        current = Next(current);
+    }
+    if (current == nullptr)
+        return false;
+
+    if (previous == nullptr)
+        head = Next(current);
+    else
+        Next(previous) = Next(current);
+    if (tail == current)
+        tail = previous;
+    Next(current) = nullptr;
+    size--;
+    return true;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+T& IntrusiveList<T, Hook>::Front() const
+{
+    return *head;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+T& IntrusiveList<T, Hook>::Back() const
+{
+    return *tail;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::Reverse()
+{
+    T* current = head;
+    T* previous = nullptr;
+    T* next = nullptr;
+    while (current != nullptr)
+    {
+        next = Next(current);
+        Next(current) = previous;
+
+        previous = current;
+        current = next;
+    }
+    T* temp = head;
+    head = tail;
+    tail = temp;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::IsEmpty() const
+{
+    return size == 0;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+size_t IntrusiveList<T, Hook>::Size() const
+{
+    return size;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::Clear()
+{
+    head = nullptr;
+    tail = nullptr;
+    size = 0;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+IntrusiveList<T, Hook>::ConstIterator::ConstIterator() // This also happens to be equivalent to IntrusiveList<T, Hook>::end()
+    : current(nullptr)
+{}
+
+
+template<class T, ListHook<T> T::*Hook>
+IntrusiveList<T, Hook>::ConstIterator::ConstIterator(T* start)
+    : current(start)
+{}
+
+
+template<class T, ListHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::ConstIterator& IntrusiveList<T, Hook>::ConstIterator::operator++()
+{
+    current = Next(current);
+    return *this;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::ConstIterator::operator==(const ConstIterator& other) const
+{
+    return current == other.current;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return current != other.current;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+const T& IntrusiveList<T, Hook>::ConstIterator::operator*() const
+{
+    return *current;
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::ConstIterator IntrusiveList<T, Hook>::begin() const
+{
+    return ConstIterator(head);
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::ConstIterator IntrusiveList<T, Hook>::end() const
+{
+    return ConstIterator(nullptr);
+}
+
+
+template<class T, ListHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::IsValid() const
+{
+    if (head != nullptr && tail == nullptr)
+        return false;
+    if (head == nullptr && tail != nullptr)
+        return false;
+
+    size_t elementCount(0);
+    T* current = head;
+    while (current != nullptr)
+    {
+        elementCount++;
+        if (elementCount > size)
+            return false; // Too many elements, or a cycle.
+        if (Next(current) == nullptr && tail != current)
+            return false;
+        current = Next(current);
+    }
+    if (Size() != elementCount)
+        return false;
+
+    return true;
+}
+
+
+struct IntrusiveListExample
+{
+    int value;
+    ListHook<IntrusiveListExample> hook;
+};
+template class IntrusiveList<IntrusiveListExample, &IntrusiveListExample::hook>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -1,401 +1,732 @@
-#ifndef _LIST_H_
-#define _LIST_H_
-
-/* List
-
-   Bob Burrough, 2021
-
-   Implementation of a singly-linked list. */
-
-
-template<class T>
-class List
-{
-public:
-    List();
-    List(std::initializer_list<T> l); // initialize List with a static array of values
-    virtual ~List(); // custom destructor (rule of 5)
-    List(const List& other); // copy constructor (rule of 5)
-    List<T>& operator=(const List& other); // copy assignment operator (rule of 5)
-    List(List<T>&& other); // move constructor (rule of 5)
-    List<T>& operator=(List&& other); // move assignment operator (rule of 5)
-
-    // Insert an item at the front of the list. O(1)
-    void Insert(const T& item);
-
-    // Append an item to the end of the list. O(1)
-    void Append(const T& item);
-
-    // Reverses the list. O(n)
-    void Reverse();
-
-    // returns true if the list contains no elements
-    bool IsEmpty() const;
-
-    // returns the number of elements contained in the list
-    size_t Size() const;
-
-    // empties the list of all elements
-    void Clear();
-
-    /* Consistency check. Returns true if the tree
-       is internally consistent. Otherwise, false. */
-    bool IsValid() const;
-
-protected:
-private:
-    class Node
-    {
-    public:
-        Node(const T& item_);
-
-        friend class List<T>;
-
-    protected:
-    private:
-        Node() = delete; // An item is required to instantiate a node.
-        Node* next;
-        T item;
-    };
-
-    Node* head;
-    Node* tail;
-    size_t size;
-
-    // Iterator declarations
-public:
-    class ConstIterator
-    {
-    public:
-        ConstIterator();
-        ConstIterator(Node* start);
-        ConstIterator& operator++();
-        bool operator==(const ConstIterator& other) const;
-        bool operator!=(const ConstIterator& other) const;
-        const T& operator*() const;
-
-        friend class List<T>; // For access to GetNode() member function below.
-
-    protected:
-    private:
-        const Node* GetNode() const;
-
-        Node* current;
-        Node* next; // This is necessary so we can delete nodes during iteration.
-    };
-
-    ConstIterator begin() const;
-    ConstIterator end() const;
-};
-
-
-template<class T>
-List<T>::List()
-    : head(nullptr), tail(nullptr), size(0)
-{}
-
-
-template<class T>
-List<T>::List(std::initializer_list<T> l)
-    : head(nullptr), tail(nullptr), size(0)
-{
-    for(const auto& x : l)
-        Append(x);
-}
-
-
-template<class T>
-List<T>::~List()
-{
-    for (ConstIterator itr = begin(); itr != end(); ++itr)
-        delete itr.GetNode();
-}
-
-
-template<class T>
-void List<T>::Clear()
-{
-    for (ConstIterator itr = begin(); itr != end(); ++itr)
-        delete itr.GetNode();
-    head = nullptr;
-    tail = nullptr;
-    size = 0;
-}
-
-
-template<class T>
-List<T>::List(const List<T>& other) // copy constructor
-    : head(nullptr), tail(nullptr), size(other.size)
-{
-    Node* otherCurrent = other.head;
-    Node* previous(nullptr);
-    Node* node(nullptr);
-    while (otherCurrent != nullptr)
-    {
-        node = new Node(otherCurrent->item);
-        if (head == nullptr)
-            head = node;
-        if (previous != nullptr)
-            previous->next = node;
-        previous = node;
-        otherCurrent = otherCurrent->next;
-        if (otherCurrent == nullptr)
-            tail = node;
-    }
-}
-
-
-template<class T>
-List<T>& List<T>::operator=(const List& other) // copy assignment operator
-{
-    Clear();
-    size = other.size;
-
-    Node* otherCurrent = other.head;
-    Node* previous(nullptr);
-    Node* node(nullptr);
-    while (otherCurrent != nullptr)
-    {
-        node = new Node(otherCurrent->item);
-        if (head == nullptr)
-            head = node;
-        if (previous != nullptr)
-            previous->next = node;
-        previous = node;
-        otherCurrent = otherCurrent->next;
-        if (otherCurrent == nullptr)
-            tail = node;
-    }
-    return *this;
-}
-
-
-template<class T>
-List<T>::List(List<T>&& other) // move constructor
-    : head(other.head), tail(other.tail), size(other.size)
-{
-    other.head = nullptr;
-    other.tail = nullptr;
-    other.size = 0;
-}
-
-
-template<class T>
-List<T>& List<T>::operator=(List&& other) // move assignment operator
-{
-    Clear();
-    head = other.head;
-    tail = other.tail;
-    size = other.size;
-
-    other.head = nullptr;
-    other.tail = nullptr;
-    other.size = 0;
-
-    return *this;
-}
-
-
-template<class T>
-void List<T>::Insert(const T& item)
-{
-    Node* current = new Node(item);
-    current->next = head;
-    head = current;
-    if (tail == nullptr)
-        tail = current;
-    size++;
-}
-
-
-template<class T>
-void List<T>::Append(const T& item)
-{
-    Node* current = new Node(item);
-    if (head == nullptr)
-        head = current;
-    if (tail != nullptr)
-        tail->next = current;
-    tail = current;
-    size++;
-}
-
-
-template<class T>
-void List<T>::Reverse()
-{
-    Node* current = head;
-    Node* previous = nullptr;
-    Node* next = nullptr;
-    while (current != nullptr)
-    {        
-        next = current->next;
-        current->next = previous;
-
-        previous = current;
-        current = next;
-    }
-    Node* temp = head;
-    head = tail;
-    tail = temp;
-}
-
-
-template<class T>
-bool List<T>::IsEmpty() const
-{
-    return size == 0;
-}
-
-
-template<class T>
-size_t List<T>::Size() const
-{
-    return size;
-}
-
-
-template<class T>
-List<T>::Node::Node(const T& item_)
-    : next(nullptr), item(item_)
-{}
-
-
-template<class T>
-List<T>::ConstIterator::ConstIterator() // This also happens to be equivalent to List<T>::end()
-    : current(nullptr), next(nullptr)
-{}
-
-
-template<class T>
-List<T>::ConstIterator::ConstIterator(Node* start)
-    : current(start), next(nullptr)
-{
-    if (current != nullptr && current->next != nullptr)
-        next = current->next;
-}
-
-
-template<class T>
-typename List<T>::ConstIterator& List<T>::ConstIterator::operator++()
-{
-    current = next;
-    if (current != nullptr)
-        next = current->next;
-    else
-        next = nullptr;
-    return *this;
-}
-
-
-template<class T>
-bool List<T>::ConstIterator::operator==(const List<T>::ConstIterator& other) const
-{
-    return (current == other.current && next == other.next);
-}
-
-
-template<class T>
-bool List<T>::ConstIterator::operator!=(const List<T>::ConstIterator& other) const
-{
-    return !(current == other.current && next == other.next);
-}
-
-
-template<class T>
-const T& List<T>::ConstIterator::operator*() const
-{
-    return current->item;
-}
-
-
-template<class T>
-const typename List<T>::Node* List<T>::ConstIterator::GetNode() const
-{
-    return current;
-}
-
-
-template<class T>
-typename List<T>::ConstIterator List<T>::begin() const
-{
-    return ConstIterator(head);
-}
-
-
-template<class T>
-typename List<T>::ConstIterator List<T>::end() const
-{
-    return ConstIterator(nullptr);
-}
-
-
-template<class T>
-bool List<T>::IsValid() const
-{
-    if (head != nullptr && tail == nullptr)
-        return false;
-    if (head == nullptr && tail != nullptr)
-        return false;
-
-    size_t elementCount(0);
-    Node* current = head;
-    while (current != nullptr)
-    {
-        elementCount++;
-        if (current->next == nullptr && tail != current)
-            return false;
-        current = current->next;
-    }
-    if (Size() != elementCount)
-        return false;
-
-    return true;
-}
-
-
-template class List<int>; // To force compilation of the template, for compile-time validation.
-
-/*
-------------------------------------------------------------------------------
-This software is available under 2 licenses -- choose whichever you prefer.
-------------------------------------------------------------------------------
-ALTERNATIVE A - MIT License
-Copyright (c) 2021 Bobby G. Burrough
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-------------------------------------------------------------------------------
-ALTERNATIVE B - Public Domain (www.unlicense.org)
-This is free and unencumbered software released into the public domain.
-Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
-software, either in source code form or as a compiled binary, for any purpose,
-commercial or non-commercial, and by any means.
-In jurisdictions that recognize copyright laws, the author or authors of this
-software dedicate any and all copyright interest in the software to the public
-domain. We make this dedication for the benefit of the public at large and to
-the detriment of our heirs and successors. We intend this dedication to be an
-overt act of relinquishment in perpetuity of all present and future rights to
-this software under copyright law.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
-ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
-WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-------------------------------------------------------------------------------
-*/
-
+#ifndef _LIST_H_
+#define _LIST_H_
+
+#include <new>
+
+/* List
+
+   Bob Burrough, 2021
+
+   Implementation of a singly-linked list. */
+
+
+template<class T>
+class List
+{
+public:
+    class ConstIterator;
+
+    List();
+    List(std::initializer_list<T> l); // initialize List with a static array of values
+    virtual ~List(); // custom destructor (rule of 5)
+    List(const List& other); // copy constructor (rule of 5)
+    List<T>& operator=(const List& other); // copy assignment operator (rule of 5)
+    List(List<T>&& other); // move constructor (rule of 5)
+    List<T>& operator=(List&& other); // move assignment operator (rule of 5)
+
+    // Insert an item at the front of the list. O(1)
+    void Insert(const T& item);
+
+    // Append an item to the end of the list. O(1)
+    void Append(const T& item);
+
+    /* Insert an item after position, and return an iterator to it. If
+       position is end(), the item is inserted at the front. O(1) */
+    ConstIterator InsertAfter(const ConstIterator& position, const T& item);
+
+    /* Remove the item after position, and return an iterator to the item
+       which followed it. If position is end(), the front item is removed.
+       Iterators to the removed item are invalidated, including position's
+       view of its successor, so continue from the returned iterator. O(1) */
+    ConstIterator EraseAfter(const ConstIterator& position);
+
+    // Remove the item at the front of the list, if there is one. O(1)
+    void PopFront();
+
+    // The first and last items. The list must not be empty. O(1)
+    T& Front();
+    const T& Front() const;
+    T& Back();
+    const T& Back() const;
+
+    /* Keep up to limit removed nodes for reuse by later insertions, so a
+       list used as a queue stops allocating once it reaches its working
+       size. The default limit, 0, frees nodes as they're removed. Lowering
+       the limit frees the excess spare nodes. */
+    void SetSpareNodeLimit(size_t limit);
+
+    // Moves every node of other to the end of this list, leaving other empty. O(1)
+    void Splice(List<T>&& other);
+
+    // Moves every node of other to the front of this list, leaving other empty. O(1)
+    void SpliceFront(List<T>&& other);
+
+    /* Moves the nodes after position into a new list, which is returned.
+       position must refer to an item of this list. Nothing is allocated or
+       copied, but the moved nodes are counted, so complexity is O(k) in the
+       number of items moved. */
+    List<T> SplitAfter(const ConstIterator& position);
+
+    // Reverses the list. O(n)
+    void Reverse();
+
+    /* Sorts the list in ascending order by relinking its nodes, with an
+       iterative bottom-up merge sort. Stable. No items are copied and no
+       memory is allocated. O(n log n) time, O(1) space. */
+    void Sort();
+
+    // As above, ordered by compare(lhs, rhs), which returns true if lhs belongs before rhs.
+    template<class Compare>
+    void Sort(Compare compare);
+
+    /* Removes all but the first of each run of equal items. On a sorted
+       list, this leaves each item once, ready for AVLTree::InsertSorted()
+       or Intersect(). O(n) */
+    void Unique();
+
+    // returns true if the list contains no elements
+    bool IsEmpty() const;
+
+    // returns the number of elements contained in the list
+    size_t Size() const;
+
+    // empties the list of all elements
+    void Clear();
+
+    /* Consistency check. Returns true if the tree
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+protected:
+private:
+    class Node
+    {
+    public:
+        Node(const T& item_);
+
+        friend class List<T>;
+
+    protected:
+    private:
+        Node() = delete; // An item is required to instantiate a node.
+        Node* next;
+        T item;
+    };
+
+    // Detach the list after the first count nodes starting at node. Returns the remainder.
+    static Node* Cut(Node* node, size_t count);
+
+    // The memory of a recycled node, whose item has been destroyed.
+    struct SpareNode
+    {
+        SpareNode* next;
+    };
+
+    // Construct a node in spare memory if there is any. Otherwise, allocate one.
+    Node* NewNode(const T& item);
+
+    // Destroy a node, keeping its memory as a spare if there is room under the limit.
+    void ReleaseNode(Node* node);
+
+    Node* head;
+    Node* tail;
+    size_t size;
+    SpareNode* spare;
+    size_t spareCount;
+    size_t spareLimit;
+
+    // Iterator declarations
+public:
+    class ConstIterator
+    {
+    public:
+        ConstIterator();
+        ConstIterator(Node* start);
+        ConstIterator& operator++();
+        bool operator==(const ConstIterator& other) const;
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+        friend class List<T>; // For access to GetNode() member function below.
+
+    protected:
+    private:
+        const Node* GetNode() const;
+
+        Node* current;
+        Node* next; // This is necessary so we can delete nodes during iteration.
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+
+template<class T>
+List<T>::List()
+    : head(nullptr), tail(nullptr), size(0), spare(nullptr), spareCount(0), spareLimit(0)
+{}
+
+
+template<class T>
+List<T>::List(std::initializer_list<T> l)
+    : head(nullptr), tail(nullptr), size(0), spare(nullptr), spareCount(0), spareLimit(0)
+{
+    for(const auto& x : l)
+        Append(x);
+}
+
+
+template<class T>
+List<T>::~List()
+{
+    for (ConstIterator itr = begin(); itr != end(); ++itr)
+        delete itr.GetNode();
+    SetSpareNodeLimit(0);
+}
+
+
+template<class T>
+void List<T>::Clear()
+{
+    for (ConstIterator itr = begin(); itr != end(); ++itr)
+        ReleaseNode(const_cast<Node*>(itr.GetNode()));
+    head = nullptr;
+    tail = nullptr;
+    size = 0;
+}
+
+
+template<class T>
+List<T>::List(const List<T>& other) // copy constructor
+    : head(nullptr), tail(nullptr), size(other.size), spare(nullptr), spareCount(0), spareLimit(0)
+{
+    Node* otherCurrent = other.head;
+    Node* previous(nullptr);
+    Node* node(nullptr);
+    while (otherCurrent != nullptr)
+    {
+        node = new Node(otherCurrent->item);
+        if (head == nullptr)
+            head = node;
+        if (previous != nullptr)
+            previous->next = node;
+        previous = node;
+        otherCurrent = otherCurrent->next;
+        if (otherCurrent == nullptr)
+            tail = node;
+    }
+}
+
+
+template<class T>
+List<T>& List<T>::operator=(const List& other) // copy assignment operator
+{
+    Clear();
+    size = other.size;
+
+    Node* otherCurrent = other.head;
+    Node* previous(nullptr);
+    Node* node(nullptr);
+    while (otherCurrent != nullptr)
+    {
+        node = NewNode(otherCurrent->item);
+        if (head == nullptr)
+            head = node;
+        if (previous != nullptr)
+            previous->next = node;
+        previous = node;
+        otherCurrent = otherCurrent->next;
+        if (otherCurrent == nullptr)
+            tail = node;
+    }
+    return *this;
+}
+
+
+template<class T>
+List<T>::List(List<T>&& other) // move constructor
+    : head(other.head), tail(other.tail), size(other.size), spare(nullptr), spareCount(0), spareLimit(0)
+{
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+}
+
+
+template<class T>
+List<T>& List<T>::operator=(List&& other) // move assignment operator
+{
+    Clear();
+    head = other.head;
+    tail = other.tail;
+    size = other.size;
+
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+
+    return *this;
+}
+
+
+template<class T>
+void List<T>::Insert(const T& item)
+{
+    Node* current = NewNode(item);
+    current->next = head;
+    head = current;
+    if (tail == nullptr)
+        tail = current;
+    size++;
+}
+
+
+template<class T>
+void List<T>::Append(const T& item)
+{
+    Node* current = NewNode(item);
+    if (head == nullptr)
+        head = current;
+    if (tail != nullptr)
+        tail->next = current;
+    tail = current;
+    size++;
+}
+
+
+template<class T>
+typename List<T>::ConstIterator List<T>::InsertAfter(const ConstIterator& position, const T& item)
+{
+    Node* previous = position.current;
+    if (previous == nullptr)
+    {
+        Insert(item);
+        return begin();
+    }
+    Node* current = NewNode(item);
+    current->next = previous->next;
+    previous->next = current;
+    if (tail == previous)
+        tail = current;
+    size++;
+    return ConstIterator(current);
+}
+
+
+template<class T>
+typename List<T>::ConstIterator List<T>::EraseAfter(const ConstIterator& position)
+{
+    Node* previous = position.current;
+    Node* current = previous != nullptr ? previous->next : head;
+    if (current == nullptr)
+        return end();
+    if (previous != nullptr)
+        previous->next = current->next;
+    else
+        head = current->next;
+    if (tail == current)
+        tail = previous;
+    size--;
+    Node* next = current->next;
+    ReleaseNode(current);
+    return ConstIterator(next);
+}
+
+
+template<class T>
+void List<T>::PopFront()
+{
+    EraseAfter(end());
+}
+
+
+template<class T>
+T& List<T>::Front()
+{
+    return head->item;
+}
+
+
+template<class T>
+const T& List<T>::Front() const
+{
+    return head->item;
+}
+
+
+template<class T>
+T& List<T>::Back()
+{
+    return tail->item;
+}
+
+
+template<class T>
+const T& List<T>::Back() const
+{
+    return tail->item;
+}
+
+
+template<class T>
+void List<T>::SetSpareNodeLimit(size_t limit)
+{
+    spareLimit = limit;
+    while (spareCount > spareLimit)
+    {
+        SpareNode* memory = spare;
+        spare = memory->next;
+        spareCount--;
+        ::operator delete(memory);
+    }
+}
+
+
+template<class T>
+typename List<T>::Node* List<T>::NewNode(const T& item)
+{
+    if (spare == nullptr)
+        return new Node(item);
+    SpareNode* memory = spare;
+    spare = memory->next;
+    spareCount--;
+    return new (memory) Node(item);
+}
+
+
+template<class T>
+void List<T>::ReleaseNode(Node* node)
+{
+    if (spareCount >= spareLimit)
+    {
+        delete node;
+        return;
+    }
+    node->~Node();
+    spare = new (node) SpareNode{ spare };
+    spareCount++;
+}
+
+
+template<class T>
+void List<T>::Splice(List<T>&& other)
+{
+    if (&other == this || other.head == nullptr)
+        return;
+    if (tail != nullptr)
+        tail->next = other.head;
+    else
+        head = other.head;
+    tail = other.tail;
+    size += other.size;
+
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+}
+
+
+template<class T>
+void List<T>::SpliceFront(List<T>&& other)
+{
+    if (&other == this || other.head == nullptr)
+        return;
+    other.tail->next = head;
+    if (tail == nullptr)
+        tail = other.tail;
+    head = other.head;
+    size += other.size;
+
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+}
+
+
+template<class T>
+List<T> List<T>::SplitAfter(const ConstIterator& position)
+{
+    List<T> rest;
+    Node* last = position.current;
+    if (last == nullptr || last->next == nullptr)
+        return rest;
+
+    rest.head = last->next;
+    rest.tail = tail;
+    for (Node* current = rest.head; current != nullptr; current = current->next)
+        rest.size++;
+
+    last->next = nullptr;
+    tail = last;
+    size -= rest.size;
+    return rest;
+}
+
+
+template<class T>
+void List<T>::Reverse()
+{
+    Node* current = head;
+    Node* previous = nullptr;
+    Node* next = nullptr;
+    while (current != nullptr)
+    {        
+        next = current->next;
+        current->next = previous;
+
+        previous = current;
+        current = next;
+    }
+    Node* temp = head;
+    head = tail;
+    tail = temp;
+}
+
+
+template<class T>
+void List<T>::Sort()
+{
+    Sort([](const T& lhs, const T& rhs) { return lhs < rhs; });
+}
+
+
+template<class T>
+template<class Compare>
+void List<T>::Sort(Compare compare)
+{
+    // Each pass merges adjacent sorted runs of length width into runs of length 2 * width.
+    for (size_t width = 1; width < size; width *= 2)
+    {
+        Node* remaining = head;
+        Node* merged = nullptr;
+        Node** link = &merged; // Where the next node of the merged list is attached.
+        Node* last = nullptr;
+        while (remaining != nullptr)
+        {
+            Node* left = remaining;
+            Node* right = Cut(left, width);
+            remaining = Cut(right, width);
+
+            while (left != nullptr && right != nullptr)
+            {
+                if (compare(right->item, left->item))
+                {
+                    *link = right;
+                    right = right->next;
+                }
+                else
+                {
+                    *link = left; // Ties favor the left run, which keeps the sort stable.
+                    left = left->next;
+                }
+                last = *link;
+                link = &last->next;
+            }
+            *link = left != nullptr ? left : right;
+            while (*link != nullptr)
+            {
+                last = *link;
+                link = &last->next;
+            }
+        }
+        head = merged;
+        tail = last;
+    }
+}
+
+
+template<class T>
+typename List<T>::Node* List<T>::Cut(Node* node, size_t count)
+{
+    for (size_t i = 1; node != nullptr && i < count; i++)
+        node = node->next;
+    if (node == nullptr)
+        return nullptr;
+    Node* rest = node->next;
+    node->next = nullptr;
+    return rest;
+}
+
+
+template<class T>
+void List<T>::Unique()
+{
+    Node* current = head;
+    while (current != nullptr && current->next != nullptr)
+    {
+        Node* next = current->next;
+        if (next->item == current->item)
+        {
+            current->next = next->next;
+            if (tail == next)
+                tail = current;
+            ReleaseNode(next);
+            size--;
+        }
+        else
+        {
+            current = next;
+        }
+    }
+}
+
+
+template<class T>
+bool List<T>::IsEmpty() const
+{
+    return size == 0;
+}
+
+
+template<class T>
+size_t List<T>::Size() const
+{
+    return size;
+}
+
+
+template<class T>
+List<T>::Node::Node(const T& item_)
+    : next(nullptr), item(item_)
+{}
+
+
+template<class T>
+List<T>::ConstIterator::ConstIterator() // This also happens to be equivalent to List<T>::end()
+    : current(nullptr), next(nullptr)
+{}
+
+
+template<class T>
+List<T>::ConstIterator::ConstIterator(Node* start)
+    : current(start), next(nullptr)
+{
+    if (current != nullptr && current->next != nullptr)
+        next = current->next;
+}
+
+
+template<class T>
+typename List<T>::ConstIterator& List<T>::ConstIterator::operator++()
+{
+    current = next;
+    if (current != nullptr)
+        next = current->next;
+    else
+        next = nullptr;
+    return *this;
+}
+
+
+template<class T>
+bool List<T>::ConstIterator::operator==(const List<T>::ConstIterator& other) const
+{
+    return (current == other.current && next == other.next);
+}
+
+
+template<class T>
+bool List<T>::ConstIterator::operator!=(const List<T>::ConstIterator& other) const
+{
+    return !(current == other.current && next == other.next);
+}
+
+
+template<class T>
+const T& List<T>::ConstIterator::operator*() const
+{
+    return current->item;
+}
+
+
+template<class T>
+const typename List<T>::Node* List<T>::ConstIterator::GetNode() const
+{
+    return current;
+}
+
+
+template<class T>
+typename List<T>::ConstIterator List<T>::begin() const
+{
+    return ConstIterator(head);
+}
+
+
+template<class T>
+typename List<T>::ConstIterator List<T>::end() const
+{
+    return ConstIterator(nullptr);
+}
+
+
+template<class T>
+bool List<T>::IsValid() const
+{
+    if (head != nullptr && tail == nullptr)
+        return false;
+    if (head == nullptr && tail != nullptr)
+        return false;
+
+    size_t elementCount(0);
+    Node* current = head;
+    while (current != nullptr)
+    {
+        elementCount++;
+        if (current->next == nullptr && tail != current)
+            return false;
+        current = current->next;
+    }
+    if (Size() != elementCount)
+        return false;
+
+    return true;
+}
+
+
+template class List<int>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
 #endif
\ No newline at end of file
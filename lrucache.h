@@ -0,0 +1,466 @@
+#ifndef _LRUCACHE_H_
+#define _LRUCACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include "dlist.h"
+#include "pair.h"
+
+/* LRUCache
+
+   Bob Burrough, 2021
+
+   A bounded key/value cache which evicts the least recently used entry
+   when it's full. Entries are Pair<K, V> items of a DList, kept in order
+   of use, least recent first, and found through an open-addressed hash
+   index of DList iterators. Get(), Put(), Remove() and eviction are all
+   O(1), and once the cache is full, Put() reuses the evicted entry's node
+   rather than allocating.
+
+   ShardedLRUCache splits the capacity over several LRUCaches, each behind
+   its own mutex, for use from many threads at once. */
+
+template<class K, class V, class Hash = std::hash<K>>
+class LRUCache
+{
+public:
+    typedef Pair<K, V> Entry;
+    typedef std::function<void(const K& key, const V& value)> EvictionCallback;
+
+    LRUCache(size_t capacity_); // capacity_ must be at least 1.
+    virtual ~LRUCache();
+    LRUCache(const LRUCache& other) = delete; // The index refers to the nodes of this cache's list.
+    LRUCache<K, V, Hash>& operator=(const LRUCache& other) = delete;
+
+    /* Returns the value cached for key, and marks it most recently used. If
+       key isn't cached, returns nullptr. The pointer is valid until the
+       entry is removed or evicted. O(1) */
+    const V* Get(const K& key);
+
+    // As Get(), but without marking the entry used. O(1)
+    const V* Peek(const K& key) const;
+
+    /* Caches value for key, replacing any value already cached, and marks
+       it most recently used. If the cache is full, the least recently used
+       entry is evicted first. O(1) */
+    void Put(const K& key, const V& value);
+
+    // Removes key from the cache. Returns false if it wasn't cached. O(1)
+    bool Remove(const K& key);
+
+    // Called with each entry evicted by Put() to make room. Not called by Remove() or Clear().
+    void SetEvictionCallback(EvictionCallback callback);
+
+    size_t Size() const;
+    size_t Capacity() const;
+    void Clear();
+
+    /* Consistency check. Returns true if the cache
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+    // Visits the entries from least to most recently used.
+    typedef typename DList<Entry>::ConstIterator ConstIterator;
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+protected:
+private:
+    LRUCache() = delete;
+
+    size_t Slot(const K& key) const; // Scrambles the hash, since e.g. std::hash<int> is the identity.
+    size_t FindSlot(const K& key) const; // Returns the slot holding key, or the empty slot where it belongs.
+    void EraseSlot(size_t slot);
+
+    DList<Entry> entries;
+    ConstIterator* index; // Open addressing with linear probing. end() marks an empty slot.
+    size_t mask; // index capacity - 1, where the capacity is a power of two
+    size_t capacity;
+    EvictionCallback onEvict;
+};
+
+
+template<class K, class V, class Hash = std::hash<K>>
+class ShardedLRUCache
+{
+public:
+    /* The capacity is divided over shardCount shards, each locked
+       independently, with the first capacity % shardCount shards holding
+       one more entry than the rest. A capacity smaller than shardCount
+       uses only capacity shards, so that none is empty; as for LRUCache,
+       a capacity of 0 holds one entry. Eviction is least recently used
+       within each shard. */
+    ShardedLRUCache(size_t capacity, size_t shardCount);
+    virtual ~ShardedLRUCache();
+    ShardedLRUCache(const ShardedLRUCache& other) = delete;
+    ShardedLRUCache<K, V, Hash>& operator=(const ShardedLRUCache& other) = delete;
+
+    // Copies the value cached for key into value, and marks it used. Returns false if key isn't cached.
+    bool Get(const K& key, V& value);
+
+    void Put(const K& key, const V& value);
+
+    bool Remove(const K& key);
+
+    // Called with each evicted entry, while the entry's shard is locked.
+    void SetEvictionCallback(typename LRUCache<K, V, Hash>::EvictionCallback callback);
+
+    size_t Size() const;
+
+    // The total of the shards' capacities.
+    size_t Capacity() const;
+
+protected:
+private:
+    ShardedLRUCache() = delete;
+
+    class Shard
+    {
+    public:
+        Shard(size_t capacity) : cache(capacity) {}
+        std::mutex lock;
+        LRUCache<K, V, Hash> cache;
+    };
+
+    Shard& ShardOf(const K& key) const;
+
+    Shard** shards;
+    size_t shardCount;
+};
+
+
+template<class K, class V, class Hash>
+LRUCache<K, V, Hash>::LRUCache(size_t capacity_)
+    : index(nullptr), mask(0), capacity(capacity_ > 0 ? capacity_ : 1)
+{
+    size_t slots = 8;
+    while (slots < capacity * 2) // keep the load factor at or below one half
+        slots *= 2;
+    index = new ConstIterator[slots];
+    mask = slots - 1;
+}
+
+
+template<class K, class V, class Hash>
+LRUCache<K, V, Hash>::~LRUCache()
+{
+    delete[] index;
+}
+
+
+template<class K, class V, class Hash>
+const V* LRUCache<K, V, Hash>::Get(const K& key)
+{
+    ConstIterator entry = index[FindSlot(key)];
+    if (entry == entries.end())
+        return nullptr;
+    entries.MoveToBack(entry);
+    return &(*entry).value;
+}
+
+
+template<class K, class V, class Hash>
+const V* LRUCache<K, V, Hash>::Peek(const K& key) const
+{
+    ConstIterator entry = index[FindSlot(key)];
+    return entry != entries.end() ? &(*entry).value : nullptr;
+}
+
+
+template<class K, class V, class Hash>
+void LRUCache<K, V, Hash>::Put(const K& key, const V& value)
+{
+    size_t slot = FindSlot(key);
+    if (index[slot] != entries.end())
+    {
+        entries.MoveToBack(index[slot]);
+        entries.Back().value = value;
+        return;
+    }
+
+    if (entries.Size() < capacity)
+    {
+        index[slot] = entries.Append(Entry(key, value));
+        return;
+    }
+
+    // Full. Evict the least recently used entry, and reuse its node for the new one.
+    ConstIterator victim = entries.begin();
+    if (onEvict)
+        onEvict((*victim).key, (*victim).value);
+    EraseSlot(FindSlot((*victim).key));
+    entries.MoveToBack(victim);
+    entries.Back() = Entry(key, value);
+    index[FindSlot(key)] = victim; // The erasure may have moved the empty slot.
+}
+
+
+template<class K, class V, class Hash>
+bool LRUCache<K, V, Hash>::Remove(const K& key)
+{
+    size_t slot = FindSlot(key);
+    ConstIterator entry = index[slot];
+    if (entry == entries.end())
+        return false;
+    EraseSlot(slot);
+    entries.Erase(entry);
+    return true;
+}
+
+
+template<class K, class V, class Hash>
+void LRUCache<K, V, Hash>::SetEvictionCallback(EvictionCallback callback)
+{
+    onEvict = callback;
+}
+
+
+template<class K, class V, class Hash>
+size_t LRUCache<K, V, Hash>::Size() const
+{
+    return entries.Size();
+}
+
+
+template<class K, class V, class Hash>
+size_t LRUCache<K, V, Hash>::Capacity() const
+{
+    return capacity;
+}
+
+
+template<class K, class V, class Hash>
+void LRUCache<K, V, Hash>::Clear()
+{
+    entries.Clear();
+    for (size_t slot = 0; slot <= mask; slot++)
+        index[slot] = entries.end();
+}
+
+
+template<class K, class V, class Hash>
+size_t LRUCache<K, V, Hash>::Slot(const K& key) const
+{
+    size_t hash = Hash()(key);
+    hash ^= hash >> 16;
+    hash *= 0x7feb352d;
+    hash ^= hash >> 15;
+    return hash & mask;
+}
+
+
+template<class K, class V, class Hash>
+size_t LRUCache<K, V, Hash>::FindSlot(const K& key) const
+{
+    size_t slot = Slot(key);
+    while (index[slot] != entries.end() && !((*index[slot]).key == key))
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+
+/* Empty a slot without leaving a tombstone: shift back any later entry in
+   the same run which would otherwise become unreachable from its home slot. */
+template<class K, class V, class Hash>
+void LRUCache<K, V, Hash>::EraseSlot(size_t slot)
+{
+    size_t hole = slot;
+    size_t next = (hole + 1) & mask;
+    while (index[next] != entries.end())
+    {
+        size_t home = Slot((*index[next]).key);
+        // Move the entry into the hole unless its home lies cyclically within (hole, next].
+        bool reachable = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!reachable)
+        {
+            index[hole] = index[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    index[hole] = entries.end();
+}
+
+
+template<class K, class V, class Hash>
+typename LRUCache<K, V, Hash>::ConstIterator LRUCache<K, V, Hash>::begin() const
+{
+    return entries.begin();
+}
+
+
+template<class K, class V, class Hash>
+typename LRUCache<K, V, Hash>::ConstIterator LRUCache<K, V, Hash>::end() const
+{
+    return entries.end();
+}
+
+
+template<class K, class V, class Hash>
+bool LRUCache<K, V, Hash>::IsValid() const
+{
+    if (!entries.IsValid() || entries.Size() > capacity)
+        return false;
+
+    // Every entry must be reachable through the index, and the index must hold nothing else.
+    size_t indexed = 0;
+    for (size_t slot = 0; slot <= mask; slot++)
+    {
+        if (index[slot] != entries.end())
+            indexed++;
+    }
+    if (indexed != entries.Size())
+        return false;
+    for (ConstIterator entry = entries.begin(); entry != entries.end(); ++entry)
+    {
+        if (index[FindSlot((*entry).key)] != entry)
+            return false;
+    }
+    return true;
+}
+
+
+template<class K, class V, class Hash>
+ShardedLRUCache<K, V, Hash>::ShardedLRUCache(size_t capacity, size_t shardCount_)
+    : shards(nullptr), shardCount(shardCount_ > 0 ? shardCount_ : 1)
+{
+    if (capacity == 0)
+        capacity = 1;
+    if (shardCount > capacity)
+        shardCount = capacity;
+    shards = new Shard*[shardCount];
+    for (size_t i = 0; i < shardCount; i++)
+        shards[i] = new Shard(capacity / shardCount + (i < capacity % shardCount ? 1 : 0));
+}
+
+
+template<class K, class V, class Hash>
+ShardedLRUCache<K, V, Hash>::~ShardedLRUCache()
+{
+    for (size_t i = 0; i < shardCount; i++)
+        delete shards[i];
+    delete[] shards;
+}
+
+
+template<class K, class V, class Hash>
+typename ShardedLRUCache<K, V, Hash>::Shard& ShardedLRUCache<K, V, Hash>::ShardOf(const K& key) const
+{
+    // Take the shard from different bits of the hash than each shard's index uses.
+    size_t hash = Hash()(key) * 0x9e3779b9;
+    return *shards[(hash >> 16) % shardCount];
+}
+
+
+template<class K, class V, class Hash>
+bool ShardedLRUCache<K, V, Hash>::Get(const K& key, V& value)
+{
+    Shard& shard = ShardOf(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    const V* cached = shard.cache.Get(key);
+    if (cached == nullptr)
+        return false;
+    value = *cached;
+    return true;
+}
+
+
+template<class K, class V, class Hash>
+void ShardedLRUCache<K, V, Hash>::Put(const K& key, const V& value)
+{
+    Shard& shard = ShardOf(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.cache.Put(key, value);
+}
+
+
+template<class K, class V, class Hash>
+bool ShardedLRUCache<K, V, Hash>::Remove(const K& key)
+{
+    Shard& shard = ShardOf(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.cache.Remove(key);
+}
+
+
+template<class K, class V, class Hash>
+void ShardedLRUCache<K, V, Hash>::SetEvictionCallback(typename LRUCache<K, V, Hash>::EvictionCallback callback)
+{
+    for (size_t i = 0; i < shardCount; i++)
+    {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        shards[i]->cache.SetEvictionCallback(callback);
+    }
+}
+
+
+template<class K, class V, class Hash>
+size_t ShardedLRUCache<K, V, Hash>::Size() const
+{
+    size_t size = 0;
+    for (size_t i = 0; i < shardCount; i++)
+    {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        size += shards[i]->cache.Size();
+    }
+    return size;
+}
+
+
+template<class K, class V, class Hash>
+size_t ShardedLRUCache<K, V, Hash>::Capacity() const
+{
+    size_t capacity = 0;
+    for (size_t i = 0; i < shardCount; i++)
+        capacity += shards[i]->cache.Capacity(); // Fixed at construction, so no lock is needed.
+    return capacity;
+}
+
+
+template class LRUCache<int, int>; // To force compilation of the template, for compile-time validation.
+template class ShardedLRUCache<int, int>;
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -1,408 +1,1721 @@
-
-#include <iostream>
-#include <string>
-
-using namespace std;
-
-#include "rbtree.h"
-#include "avltree.h"
-#include "avltreemorris.h"
-#include "list.h"
-#include "pair.h"
-
-
-bool SequencesMatch(const List<int>& lhs, const List<int>& rhs)
-{
-    if (lhs.Size() != rhs.Size())
-        return false;
-
-    List<int>::ConstIterator lhs_itr = lhs.begin();
-    List<int>::ConstIterator rhs_itr = rhs.begin();
-    for (; lhs_itr != lhs.end() && rhs_itr != rhs.end();)
-    {
-        if (*lhs_itr != *rhs_itr)
-            return false;
-
-        ++lhs_itr;
-        ++rhs_itr;
-    }
-
-    return true;
-}
-
-
-#define VALUES { 2, 13, 10, 5, 12, 7, 17, 18, 37, 29, 11, 14, 15, 16 }
-#define REVERSE_VALUES { 16, 15, 14, 11, 29, 37, 18, 17, 7, 12, 5, 10, 13, 2 }
-#define SORTED_VALUES { 2, 5, 7, 10, 11, 12, 13, 14, 15, 16, 17, 18, 29, 37 }
-#define EMPTY_VALUES {}
-
-template<typename T>
-void IntegerListTest()
-{
-    T integerList(VALUES);
-    List<int> resultantSequence;
-    for (const int& x : integerList)
-        resultantSequence.Append(x);
-    cout << (integerList.IsValid() && SequencesMatch(resultantSequence, VALUES) ? "passed" : "failed") << "...initializer_list test " << endl;
-    resultantSequence.Clear();
-
-    integerList.Clear();
-    for (const int& x : integerList)
-        resultantSequence.Append(x);
-    cout << (integerList.IsValid() && SequencesMatch(resultantSequence, EMPTY_VALUES) ? "passed" : "failed") << "...clear test " << endl;
-    resultantSequence.Clear();
-
-    for (const int& x : VALUES)
-        integerList.Insert(x); // Insert causes the order of VALUES to be reversed.
-    for (const int& x : integerList)
-        resultantSequence.Append(x);
-    cout << (integerList.IsValid() && SequencesMatch(resultantSequence, REVERSE_VALUES) ? "passed" : "failed") << "...insert test " << endl;
-
-    resultantSequence.Reverse();
-    cout << (integerList.IsValid() && SequencesMatch(resultantSequence, VALUES) ? "passed" : "failed") << "...reversal test " << endl;
-    resultantSequence.Clear();
-
-    integerList.Clear();
-    for (const int& x : VALUES)
-        integerList.Append(x);
-    for (const int& x : integerList)
-        resultantSequence.Append(x);
-    cout << (integerList.IsValid() && SequencesMatch(resultantSequence, VALUES) ? "passed" : "failed") << "...append test " << endl;
-    resultantSequence.Clear();
-
-    // test copy constructor
-    T copyConstructedList(integerList);
-    cout << (integerList.IsValid() && copyConstructedList.IsValid() && SequencesMatch(copyConstructedList, VALUES) ? "passed" : "failed") << "...copy constructor test" << endl;
-    copyConstructedList.Clear();
-
-    // test copy assignment operator
-    copyConstructedList = integerList;
-    cout << (integerList.IsValid() && copyConstructedList.IsValid() && SequencesMatch(copyConstructedList, VALUES) ? "passed" : "failed") << "...copy assignment test" << endl;
-    copyConstructedList.Clear();
-
-    // test move constructor
-    T moveConstructedList(std::move(integerList));
-    cout << (integerList.IsValid() && integerList.Size() == 0 && moveConstructedList.IsValid() && SequencesMatch(moveConstructedList, VALUES) ? "passed" : "failed") << "...move constructor test" << endl;
-    moveConstructedList.Clear();
-
-    // test move assignment operator
-    for (const int& x : VALUES)
-        integerList.Append(x);
-    moveConstructedList = std::move(integerList);
-    cout << (integerList.IsValid() && integerList.Size() == 0 && moveConstructedList.IsValid() && SequencesMatch(moveConstructedList, VALUES) ? "passed" : "failed") << "...move assignment operator test" << endl;
-    moveConstructedList.Clear();
-}
-
-
-template<typename T>
-void IntegerTreeTest()
-{
-    T integerTree;
-    const int values[] = VALUES;
-    List<int> resultantSequence;
-    for (const int &x : values)
-        integerTree.Insert(x);
-
-    for (typename T::ConstIterator itr = integerTree.begin(); itr != integerTree.end(); ++itr)
-        resultantSequence.Append(*itr);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, SORTED_VALUES) ? "passed" : "failed") << "...insert test " << endl;
-    resultantSequence.Clear();
-
-    integerTree.Insert(2);
-    integerTree.Insert(2);
-    integerTree.Insert(2);
-    for (typename T::ConstIterator itr = integerTree.begin(); itr != integerTree.end(); ++itr)
-        resultantSequence.Append(*itr);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, SORTED_VALUES) ? "passed" : "failed") << "...duplicate insertion test " << endl;
-    resultantSequence.Clear();
-
-    for (typename T::ConstIterator itr = integerTree.begin(); itr != integerTree.end(); ++itr)
-    {
-        if (*itr == 5)
-            break;  // intentionally stop in the middle
-
-        resultantSequence.Append(*itr);
-    }
-    cout <<  (integerTree.IsValid() && SequencesMatch(resultantSequence, { 2 }) ? "passed" : "failed") << "...interrupted iteration test " << endl;
-    resultantSequence.Clear();
-
-    // At this point, there should be no traversal pointers in the tree.
-
-    integerTree.Insert(4);
-    integerTree.Insert(6);
-    integerTree.Insert(42);
-
-    for (typename T::ConstIterator itr = integerTree.begin(); itr != integerTree.end(); ++itr)
-        resultantSequence.Append(*itr);
-    cout <<  (integerTree.IsValid() && SequencesMatch(resultantSequence, { 2,4,5,6,7,10,11,12,13,14,15,16,17,18,29,37,42 }) ? "passed" : "failed") << "...insert after interruption test " << endl;
-    resultantSequence.Clear();
-
-    for (auto &x : integerTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 2,4,5,6,7,10,11,12,13,14,15,16,17,18,29,37,42 }) ? "passed" : "failed") << "...range-based iteration test " << endl;
-    resultantSequence.Clear();
-
-    for (typename T::ConstPostorder::Iterator itr = typename T::ConstPostorder(integerTree).begin(); itr != typename T::ConstPostorder(integerTree).end(); ++itr)
-        resultantSequence.Append(*itr);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 4,2,6,7,5,11,12,10,14,16,17,15,29,42,37,18,13 }) ? "passed" : "failed") << "...first postorder iteration test " << endl;
-    resultantSequence.Clear();
-
-    for (auto &x : typename T::ConstPostorder(integerTree))
-        resultantSequence.Append(x);
-    cout <<  (integerTree.IsValid() && SequencesMatch(resultantSequence, { 4,2,6,7,5,11,12,10,14,16,17,15,29,42,37,18,13 }) ? "passed" : "failed") << "...second postorder iteration test " << endl;
-    resultantSequence.Clear();
-
-    for (auto &x : typename T::ConstPostorder(integerTree))
-    {
-        if (x == 37)
-            break;
-
-        resultantSequence.Append(x);
-    }
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 4,2,6,7,5,11,12,10,14,16,17,15,29,42 }) ? "passed" : "failed") << "...interrupted postorder iteration test " << endl;
-    resultantSequence.Clear();
-
-    for (auto &x : typename T::ConstPostorder(integerTree))
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 4,2,6,7,5,11,12,10,14,16,17,15,29,42,37,18,13 }) ? "passed" : "failed") << "...iteration after postorder iteration test " << endl;
-    resultantSequence.Clear();
-
-    cout << (integerTree.IsValid() && integerTree.Search(29) ? "passed" : "failed") << "...search found test" << endl;
-
-    cout << (integerTree.IsValid() && integerTree.Search(30) == false ? "passed" : "failed") << "...search not found test" << endl;
-
-    T secondTree;
-    int alternateValues[] = { -1, 800, 12, 10, 3, 42, 7, 16, 15 }; // -1, 800, 3 do not intersect. 12, 10, 42, 7, 16, 15 do intersect.
-    for (auto &x : alternateValues)
-        secondTree.Insert(x);
-
-    T intersectionTree = integerTree.Intersect(secondTree);
-    for (auto &x : intersectionTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && secondTree.IsValid() && intersectionTree.IsValid() && SequencesMatch(resultantSequence, { 7, 10, 12, 15, 16, 42 }) ? "passed" : "failed") << "...intersection test" << endl;
-    resultantSequence.Clear();
-
-    AVLTree<float> floatTree;
-    float floatValues[] = { 0.1f, 3.14159f, -1.0f, 2.71828f, 7.0f, 10.0f, 12.0f };
-    for (auto &x : floatValues)
-    {
-        floatTree.Insert(x);
-        if (!floatTree.IsValid())
-            cout << "not valid" << endl;
-    }
-    
-    T intersectionTree2 = integerTree.Intersect(floatTree);
-    for (auto &x : intersectionTree2)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && floatTree.IsValid() && intersectionTree2.IsValid() && SequencesMatch(resultantSequence, { 7, 10, 12 }) ? "passed" : "failed") << "...float intersection test" << endl;
-    resultantSequence.Clear();
-
-    // removal tests
-    integerTree.Clear();
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, EMPTY_VALUES) ? "passed" : "failed") << "...clear all items" << endl;
-    resultantSequence.Clear();
-
-    integerTree.Insert(1);
-    integerTree.Remove(0); // TC1 - attempt to remove nonexistent item. Nothing should happen.
-    for (auto &x : integerTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 1 }) ? "passed" : "failed") << "...remove nonexistent item" << endl;
-    resultantSequence.Clear();
-
-    integerTree.Remove(1); // TC2 - remove root node which has no children. Result should be empty tree.
-    for (auto &x : integerTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, EMPTY_VALUES) ? "passed" : "failed") << "...remove root with no children" << endl;
-    resultantSequence.Clear();
-
-    integerTree.Insert(1); // 1 is root
-    integerTree.Insert(2); // 2 is root's right child
-    integerTree.Remove(1); // TC3 - remove root node which has a right child. Result should be item 2 is root.
-    for (auto &x : integerTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 2 }) ? "passed" : "failed") << "...remove root with right child" << endl;
-    resultantSequence.Clear();
-
-    integerTree.Insert(1); // 1 is now root's left child. 2 is root.
-    integerTree.Remove(2); // TC4 - remove root node which has a left child. Result should be item 1 is root.
-    for (auto &x : integerTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 1 }) ? "passed" : "failed") << "...remove root with left child" << endl;
-    resultantSequence.Clear();
-
-    integerTree.Insert(0);
-    integerTree.Insert(2);
-    integerTree.Remove(1); // TC5 - remove root node which has two children. Result should be 2 is now root.
-    for (auto &x : integerTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 0, 2 }) ? "passed" : "failed") << "...remove root with two children" << endl;
-    resultantSequence.Clear();
-
-    integerTree.Insert(5);
-    integerTree.Remove(5); // TC6 - remove non-root node with no children
-    for (auto &x : integerTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 0, 2 }) ? "passed" : "failed") << "...remove non-root with no children" << endl;
-    resultantSequence.Clear();
-
-    integerTree.Insert(5);
-    integerTree.Insert(4);
-    integerTree.Remove(5); // TC7 - remove non-root node with a left child
-    for (auto &x : integerTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 0, 2, 4 }) ? "passed" : "failed") << "...remove non-root with left child" << endl;
-    resultantSequence.Clear();
-
-    integerTree.Insert(5);
-    integerTree.Remove(4); // TC8 - remove non-root node with a right child.
-    for (auto &x : integerTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 0, 2, 5 }) ? "passed" : "failed") << "...remove non-root with right child" << endl;
-    resultantSequence.Clear();
-
-    integerTree.Insert(4);
-    integerTree.Insert(6);
-    integerTree.Remove(5); // TC9 - remove non-root node which has two children.
-    for (auto &x : integerTree)
-        resultantSequence.Append(x);
-    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 0, 2, 4, 6 }) ? "passed" : "failed") << "...remove non-root with two children" << endl;
-    resultantSequence.Clear();
-
-    // Forward removal iteration test
-    bool removalIterationsPassed = true;
-    const int numRemovalIterations = 1000;
-    for (int i = 0; i < numRemovalIterations; i++)
-    {
-        integerTree.Clear();
-        List<int> expectedResult;
-        for (int j = 0; j < numRemovalIterations; j++)
-        {
-            integerTree.Insert(j); // put all values in integerTree.
-            if (j == i)
-                continue;
-            expectedResult.Append(j); // put all values but i in expectedResult
-        }
-        integerTree.Remove(i);
-        resultantSequence.Clear();
-        for (auto &x : integerTree)
-            resultantSequence.Append(x);
-        removalIterationsPassed &= integerTree.IsValid() && SequencesMatch(resultantSequence, expectedResult);
-        if (!removalIterationsPassed)
-        {
-            cout << "failed...remove " << i << " from " << numRemovalIterations << " element tree test" << endl;
-            break;
-        }
-    }
-    if(removalIterationsPassed)
-        cout << "passed...remove n from " << numRemovalIterations << " element tree test" << endl;
-
-    // Backward removal iteration test
-    removalIterationsPassed = true;
-    for (int i = 0; i < numRemovalIterations; i++)
-    {
-        integerTree.Clear();
-        List<int> expectedResult;
-        for (int j = 0; j < numRemovalIterations; j++)
-        {
-            int value = numRemovalIterations - (j + 1);
-
-            integerTree.Insert(value); // put all values in integerTree.
-            if (value == i)
-                continue;
-            expectedResult.Insert(value); // put all values but i in expectedResult
-        }
-        integerTree.Remove(i);
-        resultantSequence.Clear();
-        for (auto &x : integerTree)
-            resultantSequence.Append(x);
-        removalIterationsPassed &= integerTree.IsValid() && SequencesMatch(resultantSequence, expectedResult);
-        if (!removalIterationsPassed)
-        {
-            cout << "failed...remove " << i << " from " << numRemovalIterations << " element tree (reverse insertion) test" << endl;
-            break;
-        }
-    }
-    if (removalIterationsPassed)
-        cout << "passed...remove n from " << numRemovalIterations << " element tree (reverse insertion) test" << endl;
-
-}
-
-
-int main()
-{
-    cout << "\n\nTesting AVLTree<int>...\n\n";
-    IntegerTreeTest<AVLTree<int>>();
-    cout << "\n\nTesting RBTree<int>...\n\n";
-    IntegerTreeTest<RBTree<int>>();
-
-    // These are disabled becuase AVLTreeMorris<T> implementation is incomplete.
-    //cout << "\n\nTesting AVLTreeMorris<int>...\n\n";
-    //IntegerTreeTest<AVLTreeMorris<int>>();
-
-    cout << "\n\nTesting List<int>...\n\n";
-    IntegerListTest<List<int>>();
-
-
-    cout << "\n\nTestling List<string>...\n\n";
-    List<string> names;
-    names.Insert("Charlie");
-    names.Insert("Bob");
-    names.Insert("Aaron");
-    names.Append("Xavier");
-    names.Append("Yolanda");
-    names.Append("Zoe");
-
-    cout << "forward...\n";
-    for (const string& name : names)
-        cout << "name: " << name << "\n";
-
-    cout << "\nreverse...\n";
-    names.Reverse();
-    for (const string& name : names)
-        cout << "name: " << name << "\n";
-    names.Clear();
-
-    return 0;
-} 
-
-/*
-------------------------------------------------------------------------------
-This software is available under 2 licenses -- choose whichever you prefer.
-------------------------------------------------------------------------------
-ALTERNATIVE A - MIT License
-Copyright (c) 2021 Bobby G. Burrough
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-------------------------------------------------------------------------------
-ALTERNATIVE B - Public Domain (www.unlicense.org)
-This is free and unencumbered software released into the public domain.
-Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
-software, either in source code form or as a compiled binary, for any purpose,
-commercial or non-commercial, and by any means.
-In jurisdictions that recognize copyright laws, the author or authors of this
-software dedicate any and all copyright interest in the software to the public
-domain. We make this dedication for the benefit of the public at large and to
-the detriment of our heirs and successors. We intend this dedication to be an
-overt act of relinquishment in perpetuity of all present and future rights to
-this software under copyright law.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
-ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
-WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-------------------------------------------------------------------------------
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#include "rbtree.h"
+#include "avltree.h"
+#include "adaptiveset.h"
+#include "artset.h"
+#include "flatset.h"
+#include "intervaltree.h"
+#include "intrusiveavltree.h"
+#include "intrusivelist.h"
+#include "multiset.h"
+#include "avltreemorris.h"
+#include "dlist.h"
+#include "list.h"
+#include "lrucache.h"
+#include "mpsclist.h"
+#include "unrolledlist.h"
+#include "pair.h"
+#include "prefixkey.h"
+#include "roaringset.h"
+#include "setops.h"
+#include "smalllist.h"
+
+
+template<class Sequence>
+bool SequencesMatch(const Sequence& lhs, const List<int>& rhs)
+{
+    if (lhs.Size() != rhs.Size())
+        return false;
+
+    typename Sequence::ConstIterator lhs_itr = lhs.begin();
+    List<int>::ConstIterator rhs_itr = rhs.begin();
+    for (; lhs_itr != lhs.end() && rhs_itr != rhs.end();)
+    {
+        if (*lhs_itr != *rhs_itr)
+            return false;
+
+        ++lhs_itr;
+        ++rhs_itr;
+    }
+
+    return true;
+}
+
+
+#define VALUES { 2, 13, 10, 5, 12, 7, 17, 18, 37, 29, 11, 14, 15, 16 }
+#define REVERSE_VALUES { 16, 15, 14, 11, 29, 37, 18, 17, 7, 12, 5, 10, 13, 2 }
+#define SORTED_VALUES { 2, 5, 7, 10, 11, 12, 13, 14, 15, 16, 17, 18, 29, 37 }
+#define EMPTY_VALUES {}
+
+template<typename T>
+void IntegerListTest()
+{
+    T integerList(VALUES);
+    List<int> resultantSequence;
+    for (const int& x : integerList)
+        resultantSequence.Append(x);
+    cout << (integerList.IsValid() && SequencesMatch(resultantSequence, VALUES) ? "passed" : "failed") << "...initializer_list test " << endl;
+    resultantSequence.Clear();
+
+    integerList.Clear();
+    for (const int& x : integerList)
+        resultantSequence.Append(x);
+    cout << (integerList.IsValid() && SequencesMatch(resultantSequence, EMPTY_VALUES) ? "passed" : "failed") << "...clear test " << endl;
+    resultantSequence.Clear();
+
+    for (const int& x : VALUES)
+        integerList.Insert(x); // Insert causes the order of VALUES to be reversed.
+    for (const int& x : integerList)
+        resultantSequence.Append(x);
+    cout << (integerList.IsValid() && SequencesMatch(resultantSequence, REVERSE_VALUES) ? "passed" : "failed") << "...insert test " << endl;
+
+    resultantSequence.Reverse();
+    cout << (integerList.IsValid() && SequencesMatch(resultantSequence, VALUES) ? "passed" : "failed") << "...reversal test " << endl;
+    resultantSequence.Clear();
+
+    integerList.Clear();
+    for (const int& x : VALUES)
+        integerList.Append(x);
+    for (const int& x : integerList)
+        resultantSequence.Append(x);
+    cout << (integerList.IsValid() && SequencesMatch(resultantSequence, VALUES) ? "passed" : "failed") << "...append test " << endl;
+    resultantSequence.Clear();
+
+    // test copy constructor
+    T copyConstructedList(integerList);
+    cout << (integerList.IsValid() && copyConstructedList.IsValid() && SequencesMatch(copyConstructedList, VALUES) ? "passed" : "failed") << "...copy constructor test" << endl;
+    copyConstructedList.Clear();
+
+    // test copy assignment operator
+    copyConstructedList = integerList;
+    cout << (integerList.IsValid() && copyConstructedList.IsValid() && SequencesMatch(copyConstructedList, VALUES) ? "passed" : "failed") << "...copy assignment test" << endl;
+    copyConstructedList.Clear();
+
+    // test move constructor
+    T moveConstructedList(std::move(integerList));
+    cout << (integerList.IsValid() && integerList.Size() == 0 && moveConstructedList.IsValid() && SequencesMatch(moveConstructedList, VALUES) ? "passed" : "failed") << "...move constructor test" << endl;
+    moveConstructedList.Clear();
+
+    // test move assignment operator
+    for (const int& x : VALUES)
+        integerList.Append(x);
+    moveConstructedList = std::move(integerList);
+    cout << (integerList.IsValid() && integerList.Size() == 0 && moveConstructedList.IsValid() && SequencesMatch(moveConstructedList, VALUES) ? "passed" : "failed") << "...move assignment operator test" << endl;
+    moveConstructedList.Clear();
+}
+
+
+template<typename T>
+void IntegerTreeTest()
+{
+    T integerTree;
+    const int values[] = VALUES;
+    List<int> resultantSequence;
+    for (const int &x : values)
+        integerTree.Insert(x);
+
+    for (typename T::ConstIterator itr = integerTree.begin(); itr != integerTree.end(); ++itr)
+        resultantSequence.Append(*itr);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, SORTED_VALUES) ? "passed" : "failed") << "...insert test " << endl;
+    resultantSequence.Clear();
+
+    integerTree.Insert(2);
+    integerTree.Insert(2);
+    integerTree.Insert(2);
+    for (typename T::ConstIterator itr = integerTree.begin(); itr != integerTree.end(); ++itr)
+        resultantSequence.Append(*itr);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, SORTED_VALUES) ? "passed" : "failed") << "...duplicate insertion test " << endl;
+    resultantSequence.Clear();
+
+    for (typename T::ConstIterator itr = integerTree.begin(); itr != integerTree.end(); ++itr)
+    {
+        if (*itr == 5)
+            break;  // intentionally stop in the middle
+
+        resultantSequence.Append(*itr);
+    }
+    cout <<  (integerTree.IsValid() && SequencesMatch(resultantSequence, { 2 }) ? "passed" : "failed") << "...interrupted iteration test " << endl;
+    resultantSequence.Clear();
+
+    // At this point, there should be no traversal pointers in the tree.
+
+    integerTree.Insert(4);
+    integerTree.Insert(6);
+    integerTree.Insert(42);
+
+    for (typename T::ConstIterator itr = integerTree.begin(); itr != integerTree.end(); ++itr)
+        resultantSequence.Append(*itr);
+    cout <<  (integerTree.IsValid() && SequencesMatch(resultantSequence, { 2,4,5,6,7,10,11,12,13,14,15,16,17,18,29,37,42 }) ? "passed" : "failed") << "...insert after interruption test " << endl;
+    resultantSequence.Clear();
+
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 2,4,5,6,7,10,11,12,13,14,15,16,17,18,29,37,42 }) ? "passed" : "failed") << "...range-based iteration test " << endl;
+    resultantSequence.Clear();
+
+    for (typename T::ConstPostorder::Iterator itr = typename T::ConstPostorder(integerTree).begin(); itr != typename T::ConstPostorder(integerTree).end(); ++itr)
+        resultantSequence.Append(*itr);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 4,2,6,7,5,11,12,10,14,16,17,15,29,42,37,18,13 }) ? "passed" : "failed") << "...first postorder iteration test " << endl;
+    resultantSequence.Clear();
+
+    for (auto &x : typename T::ConstPostorder(integerTree))
+        resultantSequence.Append(x);
+    cout <<  (integerTree.IsValid() && SequencesMatch(resultantSequence, { 4,2,6,7,5,11,12,10,14,16,17,15,29,42,37,18,13 }) ? "passed" : "failed") << "...second postorder iteration test " << endl;
+    resultantSequence.Clear();
+
+    for (auto &x : typename T::ConstPostorder(integerTree))
+    {
+        if (x == 37)
+            break;
+
+        resultantSequence.Append(x);
+    }
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 4,2,6,7,5,11,12,10,14,16,17,15,29,42 }) ? "passed" : "failed") << "...interrupted postorder iteration test " << endl;
+    resultantSequence.Clear();
+
+    for (auto &x : typename T::ConstPostorder(integerTree))
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 4,2,6,7,5,11,12,10,14,16,17,15,29,42,37,18,13 }) ? "passed" : "failed") << "...iteration after postorder iteration test " << endl;
+    resultantSequence.Clear();
+
+    cout << (integerTree.IsValid() && integerTree.Search(29) ? "passed" : "failed") << "...search found test" << endl;
+
+    cout << (integerTree.IsValid() && integerTree.Search(30) == false ? "passed" : "failed") << "...search not found test" << endl;
+
+    T secondTree;
+    int alternateValues[] = { -1, 800, 12, 10, 3, 42, 7, 16, 15 }; // -1, 800, 3 do not intersect. 12, 10, 42, 7, 16, 15 do intersect.
+    for (auto &x : alternateValues)
+        secondTree.Insert(x);
+
+    T intersectionTree = integerTree.Intersect(secondTree);
+    for (auto &x : intersectionTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && secondTree.IsValid() && intersectionTree.IsValid() && SequencesMatch(resultantSequence, { 7, 10, 12, 15, 16, 42 }) ? "passed" : "failed") << "...intersection test" << endl;
+    resultantSequence.Clear();
+
+    AVLTree<float> floatTree;
+    float floatValues[] = { 0.1f, 3.14159f, -1.0f, 2.71828f, 7.0f, 10.0f, 12.0f };
+    for (auto &x : floatValues)
+    {
+        floatTree.Insert(x);
+        if (!floatTree.IsValid())
+            cout << "not valid" << endl;
+    }
+    
+    T intersectionTree2 = integerTree.Intersect(floatTree);
+    for (auto &x : intersectionTree2)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && floatTree.IsValid() && intersectionTree2.IsValid() && SequencesMatch(resultantSequence, { 7, 10, 12 }) ? "passed" : "failed") << "...float intersection test" << endl;
+    resultantSequence.Clear();
+
+    for (auto &x : MakeIntersectView(integerTree, secondTree))
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && secondTree.IsValid() && SequencesMatch(resultantSequence, { 7, 10, 12, 15, 16, 42 }) ? "passed" : "failed") << "...intersect view test" << endl;
+    resultantSequence.Clear();
+
+    for (auto &x : MakeIntersectView(integerTree, secondTree))
+    {
+        if (x == 15)
+            break;  // intentionally stop in the middle
+
+        resultantSequence.Append(x);
+    }
+    cout << (integerTree.IsValid() && secondTree.IsValid() && SequencesMatch(resultantSequence, { 7, 10, 12 }) ? "passed" : "failed") << "...interrupted intersect view test" << endl;
+    resultantSequence.Clear();
+
+    for (auto &x : MakeIntersectView(integerTree, floatTree))
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && floatTree.IsValid() && SequencesMatch(resultantSequence, { 7, 10, 12 }) ? "passed" : "failed") << "...float intersect view test" << endl;
+    resultantSequence.Clear();
+
+    for (auto &x : MakeUnionView(integerTree, secondTree))
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && secondTree.IsValid() && SequencesMatch(resultantSequence, { -1,2,3,4,5,6,7,10,11,12,13,14,15,16,17,18,29,37,42,800 }) ? "passed" : "failed") << "...union view test" << endl;
+    resultantSequence.Clear();
+
+    for (auto &x : MakeDifferenceView(integerTree, secondTree))
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && secondTree.IsValid() && SequencesMatch(resultantSequence, { 2,4,5,6,11,13,14,17,18,29,37 }) ? "passed" : "failed") << "...difference view test" << endl;
+    resultantSequence.Clear();
+
+    const int sortedArray[] = { -1, 3, 7, 10, 12, 15, 16, 42, 800 };
+    T arrayIntersectionTree = integerTree.Intersect(sortedArray);
+    for (auto &x : arrayIntersectionTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && arrayIntersectionTree.IsValid() && SequencesMatch(resultantSequence, { 7, 10, 12, 15, 16, 42 }) ? "passed" : "failed") << "...sorted array intersection test" << endl;
+    resultantSequence.Clear();
+
+    List<int> sortedList({ -1, 3, 7, 10, 12, 15, 16, 42, 800 });
+    T listIntersectionTree = integerTree.Intersect(sortedList);
+    for (auto &x : listIntersectionTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && listIntersectionTree.IsValid() && SequencesMatch(resultantSequence, { 7, 10, 12, 15, 16, 42 }) ? "passed" : "failed") << "...sorted list intersection test" << endl;
+    resultantSequence.Clear();
+
+    // Seek forward through the tree, comparing against a linear scan.
+    bool seekPassed = true;
+    typename T::ConstIterator seekItr = integerTree.begin();
+    for (int target = -5; target <= 45; target += 3)
+    {
+        seekItr.Seek(target);
+        typename T::ConstIterator scanItr = integerTree.begin();
+        while (scanItr != integerTree.end() && *scanItr < target)
+            ++scanItr;
+        typename T::ConstIterator lowerBound = integerTree.LowerBound(target);
+        seekPassed &= !(seekItr != scanItr) && !(lowerBound != scanItr);
+    }
+    cout << (integerTree.IsValid() && seekPassed ? "passed" : "failed") << "...seek test" << endl;
+
+    T largeTree;
+    for (int i = 0; i < 10000; i++)
+        largeTree.Insert(i * 2);
+    const int smallArray[] = { -4, 6, 7, 1000, 1001, 19998, 20000 };
+    T skewedIntersectionTree = largeTree.Intersect(smallArray);
+    for (auto &x : skewedIntersectionTree)
+        resultantSequence.Append(x);
+    T skewedIntersectionTree2 = skewedIntersectionTree.Intersect(largeTree);
+    cout << (largeTree.IsValid() && skewedIntersectionTree.IsValid() && SequencesMatch(resultantSequence, { 6, 1000, 19998 }) && skewedIntersectionTree2.Size() == 3 ? "passed" : "failed") << "...skewed intersection test" << endl;
+    resultantSequence.Clear();
+
+    T thirdTree;
+    for (auto &x : { 99, 1, 42, 12, 7, 16 })
+        thirdTree.Insert(x);
+    T multiwayIntersectionTree = T::IntersectAll({ &largeTree, &integerTree, &secondTree, &thirdTree });
+    for (auto &x : multiwayIntersectionTree)
+        resultantSequence.Append(x);
+    cout << (multiwayIntersectionTree.IsValid() && SequencesMatch(resultantSequence, { 12, 16, 42 }) ? "passed" : "failed") << "...multi-way intersection test" << endl;
+    resultantSequence.Clear();
+
+    T emptyTree;
+    T emptyIntersectionTree = T::IntersectAll({ &integerTree, &emptyTree, &secondTree });
+    T singleIntersectionTree = T::IntersectAll({ &thirdTree });
+    for (auto &x : singleIntersectionTree)
+        resultantSequence.Append(x);
+    cout << (emptyIntersectionTree.IsValid() && emptyIntersectionTree.Size() == 0 && singleIntersectionTree.IsValid() && SequencesMatch(resultantSequence, { 1, 7, 12, 16, 42, 99 }) ? "passed" : "failed") << "...degenerate multi-way intersection test" << endl;
+    resultantSequence.Clear();
+
+    const int disjointArray[] = { -7, 3, 8, 800 };
+    cout << (IntersectionSize(integerTree, secondTree) == 6 && IntersectionSize(sortedList, integerTree) == 6 && IntersectionSize(largeTree, smallArray) == 3 && IntersectionSize(integerTree, emptyTree) == 0 ? "passed" : "failed") << "...intersection size test" << endl;
+    cout << (Includes(integerTree, multiwayIntersectionTree) && Includes(largeTree, multiwayIntersectionTree) && Includes(sortedList, multiwayIntersectionTree) && !Includes(integerTree, secondTree) && Includes(integerTree, emptyTree) ? "passed" : "failed") << "...includes test" << endl;
+    cout << (IsDisjoint(integerTree, disjointArray) && !IsDisjoint(integerTree, secondTree) && IsDisjoint(emptyTree, integerTree) ? "passed" : "failed") << "...disjoint test" << endl;
+    List<int> unsortedList({ 42, 3, 7, 800, 16, 10, 12, 15, 7, -1 });
+    T unsortedIntersectionTree = integerTree.IntersectUnsorted(unsortedList); // comparable sizes, hashes the list
+    for (auto &x : unsortedIntersectionTree)
+        resultantSequence.Append(x);
+    bool unsortedPassed = unsortedIntersectionTree.IsValid() && SequencesMatch(resultantSequence, { 7, 10, 12, 15, 16, 42 });
+    resultantSequence.Clear();
+
+    T probedIntersectionTree = largeTree.IntersectUnsorted(List<int>({ 1001, 6, 19998, 6, -4 })); // small list, probes the tree
+    for (auto &x : probedIntersectionTree)
+        resultantSequence.Append(x);
+    unsortedPassed &= probedIntersectionTree.IsValid() && SequencesMatch(resultantSequence, { 6, 19998 });
+    resultantSequence.Clear();
+
+    List<int> descendingList;
+    for (int i = 0; i < 100; i++)
+        descendingList.Insert(i);
+    T hashedIntersectionTree = thirdTree.IntersectUnsorted(descendingList); // small tree, hashes the tree
+    for (auto &x : hashedIntersectionTree)
+        resultantSequence.Append(x);
+    unsortedPassed &= hashedIntersectionTree.IsValid() && SequencesMatch(resultantSequence, { 1, 7, 12, 16, 42, 99 });
+    cout << (unsortedPassed ? "passed" : "failed") << "...unsorted list intersection test" << endl;
+    resultantSequence.Clear();
+
+    T bulkTree;
+    bulkTree.InsertSorted(sortedArray);
+    bulkTree.InsertSorted(integerTree);
+    bulkTree.InsertSorted(List<int>({ 3, 3, 8, 2000 }));
+    for (auto &x : bulkTree)
+        resultantSequence.Append(x);
+    cout << (bulkTree.IsValid() && bulkTree.Size() == 22 && SequencesMatch(resultantSequence, { -1,2,3,4,5,6,7,8,10,11,12,13,14,15,16,17,18,29,37,42,800,2000 }) ? "passed" : "failed") << "...sorted bulk insertion test" << endl;
+    resultantSequence.Clear();
+
+    cout << (Equals(secondTree, sortedList) && Equals(sortedList, sortedArray) && !Equals(integerTree, secondTree) && !Equals(multiwayIntersectionTree, thirdTree) && Equals(emptyTree, emptyIntersectionTree) ? "passed" : "failed") << "...equals test" << endl;
+
+    // removal tests
+    integerTree.Clear();
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, EMPTY_VALUES) ? "passed" : "failed") << "...clear all items" << endl;
+    resultantSequence.Clear();
+
+    integerTree.Insert(1);
+    integerTree.Remove(0); // TC1 - attempt to remove nonexistent item. Nothing should happen.
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 1 }) ? "passed" : "failed") << "...remove nonexistent item" << endl;
+    resultantSequence.Clear();
+
+    integerTree.Remove(1); // TC2 - remove root node which has no children. Result should be empty tree.
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, EMPTY_VALUES) ? "passed" : "failed") << "...remove root with no children" << endl;
+    resultantSequence.Clear();
+
+    integerTree.Insert(1); // 1 is root
+    integerTree.Insert(2); // 2 is root's right child
+    integerTree.Remove(1); // TC3 - remove root node which has a right child. Result should be item 2 is root.
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 2 }) ? "passed" : "failed") << "...remove root with right child" << endl;
+    resultantSequence.Clear();
+
+    integerTree.Insert(1); // 1 is now root's left child. 2 is root.
+    integerTree.Remove(2); // TC4 - remove root node which has a left child. Result should be item 1 is root.
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 1 }) ? "passed" : "failed") << "...remove root with left child" << endl;
+    resultantSequence.Clear();
+
+    integerTree.Insert(0);
+    integerTree.Insert(2);
+    integerTree.Remove(1); // TC5 - remove root node which has two children. Result should be 2 is now root.
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 0, 2 }) ? "passed" : "failed") << "...remove root with two children" << endl;
+    resultantSequence.Clear();
+
+    integerTree.Insert(5);
+    integerTree.Remove(5); // TC6 - remove non-root node with no children
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 0, 2 }) ? "passed" : "failed") << "...remove non-root with no children" << endl;
+    resultantSequence.Clear();
+
+    integerTree.Insert(5);
+    integerTree.Insert(4);
+    integerTree.Remove(5); // TC7 - remove non-root node with a left child
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 0, 2, 4 }) ? "passed" : "failed") << "...remove non-root with left child" << endl;
+    resultantSequence.Clear();
+
+    integerTree.Insert(5);
+    integerTree.Remove(4); // TC8 - remove non-root node with a right child.
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 0, 2, 5 }) ? "passed" : "failed") << "...remove non-root with right child" << endl;
+    resultantSequence.Clear();
+
+    integerTree.Insert(4);
+    integerTree.Insert(6);
+    integerTree.Remove(5); // TC9 - remove non-root node which has two children.
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    cout << (integerTree.IsValid() && SequencesMatch(resultantSequence, { 0, 2, 4, 6 }) ? "passed" : "failed") << "...remove non-root with two children" << endl;
+    resultantSequence.Clear();
+
+    // Forward removal iteration test
+    bool removalIterationsPassed = true;
+    const int numRemovalIterations = 1000;
+    for (int i = 0; i < numRemovalIterations; i++)
+    {
+        integerTree.Clear();
+        List<int> expectedResult;
+        for (int j = 0; j < numRemovalIterations; j++)
+        {
+            integerTree.Insert(j); // put all values in integerTree.
+            if (j == i)
+                continue;
+            expectedResult.Append(j); // put all values but i in expectedResult
+        }
+        integerTree.Remove(i);
+        resultantSequence.Clear();
+        for (auto &x : integerTree)
+            resultantSequence.Append(x);
+        removalIterationsPassed &= integerTree.IsValid() && SequencesMatch(resultantSequence, expectedResult);
+        if (!removalIterationsPassed)
+        {
+            cout << "failed...remove " << i << " from " << numRemovalIterations << " element tree test" << endl;
+            break;
+        }
+    }
+    if(removalIterationsPassed)
+        cout << "passed...remove n from " << numRemovalIterations << " element tree test" << endl;
+
+    // Backward removal iteration test
+    removalIterationsPassed = true;
+    for (int i = 0; i < numRemovalIterations; i++)
+    {
+        integerTree.Clear();
+        List<int> expectedResult;
+        for (int j = 0; j < numRemovalIterations; j++)
+        {
+            int value = numRemovalIterations - (j + 1);
+
+            integerTree.Insert(value); // put all values in integerTree.
+            if (value == i)
+                continue;
+            expectedResult.Insert(value); // put all values but i in expectedResult
+        }
+        integerTree.Remove(i);
+        resultantSequence.Clear();
+        for (auto &x : integerTree)
+            resultantSequence.Append(x);
+        removalIterationsPassed &= integerTree.IsValid() && SequencesMatch(resultantSequence, expectedResult);
+        if (!removalIterationsPassed)
+        {
+            cout << "failed...remove " << i << " from " << numRemovalIterations << " element tree (reverse insertion) test" << endl;
+            break;
+        }
+    }
+    if (removalIterationsPassed)
+        cout << "passed...remove n from " << numRemovalIterations << " element tree (reverse insertion) test" << endl;
+
+    // Random insertion and removal, checked against a table of which values are present.
+    integerTree.Clear();
+    const int randomRange = 200;
+    bool present[randomRange] = {};
+    unsigned int seed = 12345;
+    bool randomPassed = true;
+    for (int i = 0; i < 20000 && randomPassed; i++)
+    {
+        seed = seed * 1103515245 + 12345; // LCG, so the sequence is the same on every platform.
+        int value = (seed >> 8) % randomRange;
+        if ((seed >> 24) % 3 != 0)
+        {
+            integerTree.Insert(value);
+            present[value] = true;
+        }
+        else
+        {
+            integerTree.Remove(value);
+            present[value] = false;
+        }
+        if (i % 1000 == 0)
+            randomPassed = integerTree.IsValid();
+    }
+    resultantSequence.Clear();
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    List<int> expectedRandomResult;
+    for (int i = 0; i < randomRange; i++)
+    {
+        if (present[i])
+            expectedRandomResult.Append(i);
+    }
+    cout << (randomPassed && integerTree.IsValid() && SequencesMatch(resultantSequence, expectedRandomResult) ? "passed" : "failed") << "...random insertion and removal test" << endl;
+
+    // Node handles
+    integerTree.Clear();
+    for (int x : SORTED_VALUES)
+        integerTree.Insert(x);
+    typename T::NodeHandle handle = integerTree.Extract(12);
+    typename T::NodeHandle missingHandle = integerTree.Extract(99);
+    resultantSequence.Clear();
+    for (auto &x : integerTree)
+        resultantSequence.Append(x);
+    bool extractPassed = !handle.Empty() && handle.Item() == 12 && missingHandle.Empty() && integerTree.Size() == 13;
+    cout << (extractPassed && integerTree.IsValid() && SequencesMatch(resultantSequence, { 2, 5, 7, 10, 11, 13, 14, 15, 16, 17, 18, 29, 37 }) ? "passed" : "failed") << "...extract test" << endl;
+
+    T handleTree;
+    handleTree.Insert(12);
+    bool handleInsertPassed = !handleTree.Insert(std::move(handle)) && !handle.Empty(); // 12 is already present, so the handle keeps the node.
+    handle.Item() = 3;
+    handleInsertPassed &= handleTree.Insert(std::move(handle)) && handle.Empty() && handleTree.Size() == 2 && handleTree.Search(3);
+    handleInsertPassed &= !handleTree.Insert(std::move(missingHandle));
+    cout << (handleInsertPassed && handleTree.IsValid() ? "passed" : "failed") << "...node handle insertion test" << endl;
+
+    T evens;
+    T multiplesOfThree;
+    for (int i = 0; i < 20; i += 2)
+        evens.Insert(i);
+    for (int i = 0; i < 20; i += 3)
+        multiplesOfThree.Insert(i);
+    evens.Merge(multiplesOfThree);
+    resultantSequence.Clear();
+    for (auto &x : evens)
+        resultantSequence.Append(x);
+    List<int> leftoverSequence;
+    for (auto &x : multiplesOfThree)
+        leftoverSequence.Append(x);
+    bool mergePassed = evens.IsValid() && multiplesOfThree.IsValid() && evens.Size() == 13 && multiplesOfThree.Size() == 4;
+    mergePassed &= SequencesMatch(resultantSequence, { 0, 2, 3, 4, 6, 8, 9, 10, 12, 14, 15, 16, 18 }) && SequencesMatch(leftoverSequence, { 0, 6, 12, 18 });
+
+    T mergeTree;
+    for (int i = 0; i < 1000; i++)
+        mergeTree.Insert(i * 2);
+    mergeTree.Merge(evens); // Small into large, one node at a time. Only 3, 9, and 15 are new.
+    mergePassed &= mergeTree.IsValid() && evens.IsValid() && mergeTree.Size() == 1003 && evens.Size() == 10 && mergeTree.Search(9) && !evens.Search(9);
+    cout << (mergePassed ? "passed" : "failed") << "...merge test" << endl;
+}
+
+
+template<template<class, class> class Tree>
+void AugmentedTreeTest()
+{
+    // Insert 1..100 in a scrambled order. 37 is coprime with 100, so each value appears once.
+    Tree<int, SumAugmentation<int>> sumTree;
+    Tree<int, MaxAugmentation<int>> maxTree;
+    for (int i = 0; i < 100; i++)
+    {
+        sumTree.Insert(i * 37 % 100 + 1);
+        maxTree.Insert(i * 37 % 100 + 1);
+    }
+
+    bool rangeSumPassed = sumTree.IsValid() && sumTree.Aggregate() == 5050;
+    for (int lo = -5; lo <= 105; lo += 5)
+    {
+        for (int hi = lo; hi <= 105; hi += 7)
+        {
+            int expected = 0;
+            for (int x = lo < 1 ? 1 : lo; x <= hi && x <= 100; x++)
+                expected += x;
+            rangeSumPassed &= sumTree.Aggregate(lo, hi) == expected;
+        }
+    }
+    rangeSumPassed &= sumTree.Aggregate(60, 40) == 0; // empty range
+    cout << (rangeSumPassed ? "passed" : "failed") << "...range sum test" << endl;
+
+    bool rangeMaxPassed = maxTree.Aggregate(10, 50) == 50 && maxTree.Aggregate(-10, 3) == 3 && maxTree.Aggregate() == 100;
+    rangeMaxPassed &= maxTree.Aggregate(200, 300) == numeric_limits<int>::lowest();
+    cout << (rangeMaxPassed ? "passed" : "failed") << "...range max test" << endl;
+
+    // Remove the even numbers, then move the multiples of 5 to another tree through node handles.
+    for (int i = 2; i <= 100; i += 2)
+        sumTree.Remove(i);
+    Tree<int, SumAugmentation<int>> fives;
+    for (int i = 5; i <= 100; i += 10)
+        fives.Insert(sumTree.Extract(i));
+    bool maintenancePassed = sumTree.IsValid() && fives.IsValid() && fives.Aggregate() == 500 && sumTree.Aggregate() == 2500 - 500;
+    maintenancePassed &= sumTree.Aggregate(1, 10) == 1 + 3 + 7 + 9 && fives.Aggregate(10, 30) == 15 + 25;
+
+    // Bulk paths rebuild the tree, and must rebuild the aggregates too.
+    sumTree.Merge(fives);
+    int evens[] = { 2, 4, 6, 8, 10 };
+    sumTree.InsertSorted(evens);
+    maintenancePassed &= sumTree.IsValid() && sumTree.Aggregate() == 2500 + 30 && sumTree.Aggregate(1, 10) == 55;
+    Tree<int, SumAugmentation<int>> intersection = sumTree.Intersect(evens);
+    maintenancePassed &= intersection.Aggregate() == 30 && intersection.Aggregate(3, 7) == 10;
+    cout << (maintenancePassed ? "passed" : "failed") << "...aggregate maintenance test" << endl;
+}
+
+
+void AdaptiveSetTest()
+{
+    typedef AdaptiveSet<int, 8> Set;
+    Set set;
+    for (int x : { 13, 2, 10, 5, 12, 7 })
+        set.Insert(x);
+    set.Insert(13); // Duplicate. Ignored.
+    bool inlinePassed = set.IsValid() && set.GetStats().representation == Set::Representation::Inline;
+    inlinePassed &= SequencesMatch(set, { 2, 5, 7, 10, 12, 13 }) && set.Search(7) && !set.Search(8);
+    set.Freeze(); // Already a sorted array.
+    inlinePassed &= set.GetStats().representation == Set::Representation::Inline && set.GetStats().freezes == 0;
+    cout << (inlinePassed ? "passed" : "failed") << "...adaptive inline test" << endl;
+
+    for (const int& x : VALUES)
+        set.Insert(x);
+    Set::Stats stats = set.GetStats();
+    bool promotePassed = set.IsValid() && stats.representation == Set::Representation::Tree && stats.promotions == 1;
+    promotePassed &= SequencesMatch(set, SORTED_VALUES);
+    cout << (promotePassed ? "passed" : "failed") << "...adaptive promotion test" << endl;
+
+    set.Freeze();
+    stats = set.GetStats();
+    bool freezePassed = set.IsValid() && stats.representation == Set::Representation::Frozen && stats.freezes == 1;
+    freezePassed &= SequencesMatch(set, SORTED_VALUES) && set.Find(29) != nullptr && set.Find(30) == nullptr;
+    AVLTree<int> tree;
+    for (int x : { 5, 6, 7, 29 })
+        tree.Insert(x);
+    Set common = set.Intersect(tree);
+    freezePassed &= tree.Intersect(set).Size() == 3 && common.IsValid() && SequencesMatch(common, { 5, 7, 29 });
+    set.Remove(29); // Thaws.
+    stats = set.GetStats();
+    freezePassed &= set.IsValid() && stats.representation == Set::Representation::Tree && stats.thaws == 1 && set.Size() == 13;
+    cout << (freezePassed ? "passed" : "failed") << "...adaptive freeze test" << endl;
+}
+
+
+void FlatSetTest()
+{
+    FlatSet<int> flatSet;
+    for (const int& x : VALUES)
+        flatSet.Insert(x);
+    flatSet.Insert(13); // Duplicate. Ignored.
+    bool insertPassed = flatSet.IsValid() && SequencesMatch(flatSet, SORTED_VALUES) && flatSet.Search(37) && !flatSet.Search(3);
+    flatSet.Remove(2);
+    flatSet.Remove(37);
+    flatSet.Remove(14);
+    flatSet.Remove(3); // Absent. Ignored.
+    insertPassed &= flatSet.IsValid() && SequencesMatch(flatSet, { 5, 7, 10, 11, 12, 13, 15, 16, 17, 18, 29 });
+    cout << (insertPassed ? "passed" : "failed") << "...flat set insert and remove test" << endl;
+
+    List<int> batch({ 1, 5, 6, 20, 29, 40 });
+    flatSet.InsertSorted(batch);
+    bool mergePassed = flatSet.IsValid() && SequencesMatch(flatSet, { 1, 5, 6, 7, 10, 11, 12, 13, 15, 16, 17, 18, 20, 29, 40 });
+
+    // Merge both kinds of tree.
+    AVLTree<int> avlBatch;
+    RBTree<int> rbBatch;
+    for (int x : { 3, 7, 41 })
+        avlBatch.Insert(x);
+    for (int x : { 0, 40, 50 })
+        rbBatch.Insert(x);
+    flatSet.InsertSorted(avlBatch);
+    flatSet.InsertSorted(rbBatch);
+    mergePassed &= flatSet.IsValid() && SequencesMatch(flatSet, { 0, 1, 3, 5, 6, 7, 10, 11, 12, 13, 15, 16, 17, 18, 20, 29, 40, 41, 50 });
+    cout << (mergePassed ? "passed" : "failed") << "...flat set merge test" << endl;
+
+    // Intersect in both directions with both kinds of tree.
+    AVLTree<int> avlTree;
+    RBTree<int> rbTree;
+    FlatSet<int> evens;
+    for (int i = 0; i < 3000; i++)
+    {
+        if (i % 3 == 0)
+            avlTree.Insert(i);
+        if (i % 5 == 0)
+            rbTree.Insert(i);
+    }
+    List<int> sortedEvens;
+    for (int i = 0; i < 3000; i += 2)
+        sortedEvens.Append(i);
+    evens.InsertSorted(sortedEvens);
+    AVLTree<int> avlIntersection = avlTree.Intersect(evens);
+    RBTree<int> rbIntersection = rbTree.Intersect(evens);
+    FlatSet<int> flatIntersection = evens.Intersect(avlTree).Intersect(rbTree);
+    bool intersectPassed = avlIntersection.IsValid() && avlIntersection.Size() == 500 && rbIntersection.Size() == 300;
+    intersectPassed &= flatIntersection.IsValid() && flatIntersection.Size() == 100 && flatIntersection.Find(30) != nullptr && flatIntersection.Find(60) != nullptr && flatIntersection.Find(10) == nullptr;
+    cout << (intersectPassed ? "passed" : "failed") << "...flat set intersect test" << endl;
+}
+
+
+void RoaringSetTest()
+{
+    RoaringSet<int> roaring;
+    for (const int& x : VALUES)
+        roaring.Insert(x);
+    roaring.Insert(-5);
+    roaring.Insert(13); // Duplicate. Ignored.
+    roaring.Remove(2);
+    roaring.Remove(3); // Absent. Ignored.
+    bool insertPassed = roaring.IsValid() && roaring.Search(-5) && roaring.Search(37) && !roaring.Search(2);
+    insertPassed &= SequencesMatch(roaring, { -5, 5, 7, 10, 11, 12, 13, 14, 15, 16, 17, 18, 29, 37 });
+    cout << (insertPassed ? "passed" : "failed") << "...roaring insert and remove test" << endl;
+
+    // Multiples of 3 fill bitmap containers; multiples of 1000 stay arrays; a range optimizes to runs.
+    RoaringSet<int> threes, thousands, range;
+    for (int i = 0; i < 300000; i += 3)
+        threes.Insert(i);
+    for (int i = 0; i < 300000; i += 1000)
+        thousands.Insert(i);
+    for (int i = 100000; i < 200000; i++)
+        range.Insert(i);
+    size_t bytesBefore = range.ContentBytes();
+    range.Optimize();
+    bool containerPassed = threes.IsValid() && thousands.IsValid() && range.IsValid() && range.ContentBytes() < bytesBefore / 100;
+    RoaringSet<int> intersection = threes.Intersect(thousands).Intersect(range);
+    RoaringSet<int> both = threes.Union(range);
+    RoaringSet<int> difference = threes.Difference(range);
+    containerPassed &= intersection.IsValid() && intersection.Size() == 33 && intersection.Search(102000) && !intersection.Search(101000);
+    containerPassed &= both.IsValid() && both.Size() == 100000 + 66667 && difference.IsValid() && difference.Size() == 66667;
+    cout << (containerPassed ? "passed" : "failed") << "...roaring container test" << endl;
+
+    // Pass a RoaringSet to a tree's Intersect, and convert in bulk both ways.
+    AVLTree<int> tree;
+    for (int i = 0; i < 3000; i += 2)
+        tree.Insert(i);
+    AVLTree<int> treeIntersection = tree.Intersect(thousands);
+    AVLTree<int> fromRoaring;
+    fromRoaring.InsertSorted(threes);
+    RoaringSet<int> fromTree;
+    fromTree.InsertSorted(tree);
+    bool treePassed = treeIntersection.IsValid() && treeIntersection.Size() == 3 && fromRoaring.IsValid() && fromRoaring.Size() == threes.Size();
+    treePassed &= fromTree.IsValid() && fromTree.Size() == 1500 && fromTree.Intersect(threes).Size() == 500;
+    cout << (treePassed ? "passed" : "failed") << "...roaring tree interoperation test" << endl;
+
+    // Iterators on the same item compare equal however they got there, across bitmap/array container boundaries.
+    RoaringSet<int> bitmapThenArray, arrayThenBitmap;
+    for (int i = 0; i < 5000; i++)
+    {
+        bitmapThenArray.Insert(i);
+        arrayThenBitmap.Insert(65536 + i);
+    }
+    bitmapThenArray.Insert(65537);
+    bitmapThenArray.Insert(65538);
+    arrayThenBitmap.Insert(1);
+    arrayThenBitmap.Insert(2);
+    RoaringSet<int>::ConstIterator stepped = bitmapThenArray.begin();
+    for (int i = 0; i < 5000; i++)
+        ++stepped;
+    RoaringSet<int>::ConstIterator sought = bitmapThenArray.begin();
+    sought.Seek(65537);
+    bool equalityPassed = *stepped == 65537 && *sought == 65537 && stepped == sought && !(++stepped != ++sought);
+    stepped = arrayThenBitmap.begin();
+    for (int i = 0; i < 3; i++)
+        ++stepped;
+    sought = arrayThenBitmap.begin();
+    sought.Seek(65537);
+    equalityPassed &= *stepped == 65537 && *sought == 65537 && stepped == sought && stepped != arrayThenBitmap.begin();
+    cout << (equalityPassed ? "passed" : "failed") << "...roaring iterator equality test" << endl;
+}
+
+
+void BlockedIntersectTest()
+{
+    // Compare the block kernel with the lock-step merge, for types with and without a vector kernel.
+    AVLTree<int> multiplesOf2, multiplesOf3;
+    RBTree<float> halves, thirds;
+    AVLTree<long long> wideMultiplesOf3;
+    for (int i = -3000; i < 3000; i++)
+    {
+        if (i % 2 == 0)
+        {
+            multiplesOf2.Insert(i);
+            halves.Insert(i / 2.0f);
+        }
+        if (i % 3 == 0)
+        {
+            multiplesOf3.Insert(i);
+            thirds.Insert(i / 2.0f);
+            wideMultiplesOf3.Insert(i);
+        }
+    }
+    List<int> merged, blocked;
+    SortedRange::ForEachCommon(multiplesOf2, multiplesOf3, [&merged](const int& x) { merged.Append(x); return true; });
+    SortedRange::ForEachCommonBlocked(multiplesOf2, multiplesOf3, [&blocked](const int& x) { blocked.Append(x); return true; });
+    bool blockedPassed = merged.Size() == 1000 && SequencesMatch(blocked, merged);
+    blockedPassed &= halves.Intersect(thirds).Size() == 1000 && wideMultiplesOf3.Intersect(wideMultiplesOf3).Size() == 2000;
+
+    /* The right side may repeat elements; each element of the left is still reported once.
+       Runs of one to three repeats fall across block boundaries, so some are split by Retain(). */
+    List<int> repeats;
+    for (int i = -3000; i < 3000; i += 2)
+    {
+        for (int j = 0; j <= (i / 2 + 1500) % 3; j++)
+            repeats.Append(i);
+    }
+    List<int> mergedRepeats, blockedRepeats;
+    SortedRange::ForEachCommon(multiplesOf3, repeats, [&mergedRepeats](const int& x) { mergedRepeats.Append(x); return true; });
+    SortedRange::ForEachCommonBlocked(multiplesOf3, repeats, [&blockedRepeats](const int& x) { blockedRepeats.Append(x); return true; });
+    AVLTree<int> common = multiplesOf3.Intersect(repeats);
+    blockedPassed &= repeats.Size() == 6000 && mergedRepeats.Size() == 1000 && SequencesMatch(blockedRepeats, mergedRepeats);
+    blockedPassed &= common.IsValid() && common.Size() == 1000 && SequencesMatch(common, mergedRepeats);
+    cout << (blockedPassed ? "passed" : "failed") << "...blocked intersect test" << endl;
+}
+
+
+/* Run with "benchmark" as the argument. Times the two stages of a blocked
+   intersection separately: gathering tree elements into buffers, and
+   comparing buffers, against the lock-step merge of the same inputs. */
+void IntersectBenchmark()
+{
+    const int count = 1000000;
+    const int rounds = 10;
+    AVLTree<int> leftTree, rightTree;
+    List<int> leftItems, rightItems;
+    unsigned seed = 12345;
+    for (int i = 0; i < count * 2; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        if (seed & 0x10000)
+            leftItems.Append(i);
+        if (seed & 0x20000)
+            rightItems.Append(i);
+    }
+    leftTree.InsertSorted(leftItems);
+    rightTree.InsertSorted(rightItems);
+    FlatSet<int> leftArray, rightArray;
+    leftArray.InsertSorted(leftTree);
+    rightArray.InsertSorted(rightTree);
+
+    auto time = [rounds](const char* name, std::function<size_t()> stage)
+    {
+        size_t result = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++)
+            result += stage();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        cout << name << ": " << elapsed.count() / rounds << " ms (" << result / rounds << ")" << endl;
+    };
+
+    time("gather, both trees into blocks", [&]()
+    {
+        int buffer[SortedRange::BlockSize];
+        size_t total = 0;
+        AVLTree<int>::ConstIterator l = leftTree.begin(), r = rightTree.begin();
+        while (size_t gathered = SortedRange::Gather(l, leftTree.end(), buffer, SortedRange::BlockSize) + SortedRange::Gather(r, rightTree.end(), buffer, SortedRange::BlockSize))
+            total += gathered + buffer[0];
+        return total;
+    });
+    time("compare, lock-step merge of arrays", [&]()
+    {
+        return IntersectionSize(leftArray, rightArray);
+    });
+    // The kernel alone: both sides are gathered once, up front, and only IntersectBlocks() is timed.
+    vector<int> leftBuffer(leftArray.Size()), rightBuffer(rightArray.Size());
+    FlatSet<int>::ConstIterator leftItr = leftArray.begin(), rightItr = rightArray.begin();
+    SortedRange::Gather(leftItr, leftArray.end(), leftBuffer.data(), leftBuffer.size());
+    SortedRange::Gather(rightItr, rightArray.end(), rightBuffer.data(), rightBuffer.size());
+    time("compare, block kernel over arrays", [&]()
+    {
+        const size_t blockSize = SortedRange::BlockSize;
+        int common[blockSize];
+        size_t total = 0;
+        const int* a = leftBuffer.data();
+        const int* aEnd = a + leftBuffer.size();
+        const int* b = rightBuffer.data();
+        const int* bEnd = b + rightBuffer.size();
+        while (a != aEnd && b != bEnd)
+        {
+            size_t aSize = min(blockSize, size_t(aEnd - a));
+            size_t bSize = min(blockSize, size_t(bEnd - b));
+            total += SortedRange::IntersectBlocks(a, aSize, b, bSize, common);
+            // Step past the elements which can't match anything further on, as ForEachCommonBlocked() does.
+            int aLast = a[aSize - 1];
+            int bLast = b[bSize - 1];
+            a = upper_bound(a, a + aSize, bLast);
+            b = upper_bound(b, b + bSize, aLast);
+        }
+        return total;
+    });
+    time("lock-step merge of trees", [&]()
+    {
+        return IntersectionSize(leftTree, rightTree);
+    });
+    time("blocked intersection of trees", [&]()
+    {
+        size_t common = 0;
+        SortedRange::ForEachCommonBlocked(leftTree, rightTree, [&common](const int&) { common++; return true; });
+        return common;
+    });
+}
+
+
+void ARTSetTest()
+{
+    ARTSet<string> urls;
+    for (const char* url : { "http://example.com/", "http://example.com/a/", "http://example.com/a/b.html", "http://example.com/a/c.html",
+        "http://example.com/b/", "http://example.org/", "https://example.com/", "ftp://example.com/" })
+        urls.Insert(url);
+    urls.Insert("http://example.com/a/"); // Duplicate. Ignored.
+    bool insertPassed = urls.IsValid() && urls.Size() == 8 && urls.Search("http://example.com/a/b.html") && !urls.Search("http://example.com/a");
+    insertPassed &= *urls.begin() == "ftp://example.com/" && urls.Find("https://example.com/") != nullptr && urls.Find("https://") == nullptr;
+    cout << (insertPassed ? "passed" : "failed") << "...art insert and search test" << endl;
+
+    List<string> underA;
+    for (const string& url : urls.WithPrefix("http://example.com/a"))
+        underA.Append(url);
+    size_t http = 0;
+    for (const string& url : urls.WithPrefix("http:"))
+        http += url.size() > 0;
+    bool prefixPassed = underA.Size() == 3 && *underA.begin() == "http://example.com/a/" && http == 6;
+    prefixPassed &= !(urls.WithPrefix("mailto:").begin() != urls.WithPrefix("mailto:").end());
+    cout << (prefixPassed ? "passed" : "failed") << "...art prefix test" << endl;
+
+    // Enough keys under one prefix to grow the nodes through every size, then shrink them again.
+    ARTSet<string> paths;
+    for (int i = 0; i < 256; i++)
+        paths.Insert(string("/usr/lib/") + static_cast<char>(i) + "/lib.so");
+    bool growPassed = paths.IsValid() && paths.Size() == 256;
+    for (int i = 0; i < 256; i += 2)
+        paths.Remove(string("/usr/lib/") + static_cast<char>(i) + "/lib.so");
+    paths.Remove("/usr/lib/"); // Absent. Ignored.
+    growPassed &= paths.IsValid() && paths.Size() == 128 && paths.Search(string("/usr/lib/") + static_cast<char>(255) + "/lib.so");
+    for (int i = 1; i < 256; i += 2)
+        paths.Remove(string("/usr/lib/") + static_cast<char>(i) + "/lib.so");
+    growPassed &= paths.IsValid() && paths.Size() == 0 && !(paths.begin() != paths.end());
+    cout << (growPassed ? "passed" : "failed") << "...art node growth test" << endl;
+
+    // Iteration is in the trees' order, so the sets convert and intersect directly.
+    RBTree<string> tree;
+    tree.InsertSorted(urls);
+    RBTree<string> common = tree.Intersect(urls);
+    urls.Remove("http://example.com/");
+    bool treePassed = tree.IsValid() && tree.Size() == 8 && common.Size() == 8 && urls.IsValid() && tree.Intersect(urls).Size() == 7;
+    cout << (treePassed ? "passed" : "failed") << "...art tree interoperation test" << endl;
+}
+
+
+void PrefixKeyTest()
+{
+    // Keys shorter than the prefix, keys differing only after it, and keys containing 0 bytes must all keep string order.
+    List<string> keys({ "", string(1, '\0'), "a", string("a\0", 2), string("a\0b", 3), "ab", "abcdefgh", "abcdefghi", "abcdefgi", "b", "\xff" });
+    AVLTree<PrefixKey<string>> avlTree;
+    RBTree<PrefixKey<string, true>> rbTree;
+    for (const char* key : { "\xff", "abcdefgi", "ab", "b", "abcdefghi", "a", "abcdefgh", "" })
+    {
+        avlTree.Insert(key);
+        rbTree.Insert(key);
+    }
+    for (const string& key : { string("a\0b", 3), string(1, '\0'), string("a\0", 2) })
+    {
+        avlTree.Insert(key);
+        rbTree.Insert(key);
+    }
+    avlTree.Insert("ab"); // Duplicate. Ignored.
+    List<string> avlKeys, rbKeys;
+    for (const PrefixKey<string>& key : avlTree)
+        avlKeys.Append(key.Value());
+    for (const PrefixKey<string, true>& key : rbTree)
+        rbKeys.Append(key.Value());
+    bool orderPassed = avlTree.IsValid() && rbTree.IsValid() && avlTree.Size() == 11;
+    orderPassed &= avlKeys.Size() == 11 && Equals(avlKeys, keys) && Equals(rbKeys, keys);
+    cout << (orderPassed ? "passed" : "failed") << "...prefix key order test" << endl;
+
+    bool searchPassed = avlTree.Search("abcdefghi") && !avlTree.Search("abcdefgj") && rbTree.Search(string("a\0", 2)) && !rbTree.Search(string("b\0", 2));
+    avlTree.Remove("abcdefgh");
+    searchPassed &= avlTree.IsValid() && avlTree.Size() == 10 && avlTree.Search("abcdefghi") && !avlTree.Search("abcdefgh");
+    List<PrefixKey<string, true>> unsorted({ "b", "zzz", "a" });
+    searchPassed &= rbTree.IntersectUnsorted(unsorted).Size() == 2; // Uses the cached hashes.
+    cout << (searchPassed ? "passed" : "failed") << "...prefix key search test" << endl;
+}
+
+
+void IntervalTreeTest()
+{
+    IntervalTree<int> intervals;
+    intervals.Insert(15, 20);
+    intervals.Insert(10, 30);
+    intervals.Insert(17, 19);
+    intervals.Insert(5, 20);
+    intervals.Insert(12, 15);
+    intervals.Insert(30, 40);
+    intervals.Insert(1, 3);
+
+    List<int> lows;
+    List<int> highs;
+    for (const Interval<int>& interval : intervals.Overlapping(14, 16))
+    {
+        lows.Append(interval.low);
+        highs.Append(interval.high);
+    }
+    cout << (intervals.IsValid() && SequencesMatch(lows, { 5, 10, 12, 15 }) && SequencesMatch(highs, { 20, 30, 15, 20 }) ? "passed" : "failed") << "...interval overlap test" << endl;
+    lows.Clear();
+    highs.Clear();
+
+    for (const Interval<int>& interval : intervals.Stabbing(30))
+        lows.Append(interval.low);
+    bool stabbingPassed = SequencesMatch(lows, { 10, 30 });
+    lows.Clear();
+    for (const Interval<int>& interval : intervals.Stabbing(4))
+        lows.Append(interval.low);
+    stabbingPassed &= SequencesMatch(lows, EMPTY_VALUES);
+    cout << (stabbingPassed ? "passed" : "failed") << "...interval stabbing test" << endl;
+
+    intervals.Remove(10, 30);
+    intervals.Remove(5, 20);
+    for (const Interval<int>& interval : intervals.Overlapping(0, 16))
+        lows.Append(interval.low);
+    cout << (intervals.IsValid() && SequencesMatch(lows, { 1, 12, 15 }) ? "passed" : "failed") << "...interval removal test" << endl;
+}
+
+
+template<template<class> class MultisetType>
+void MultisetTest()
+{
+    // Heavy duplication: many insertions, few distinct items, one node per distinct item.
+    MultisetType<int> counts;
+    for (int i = 0; i < 100000; i++)
+        counts.Insert(i % 1000);
+    bool countPassed = counts.IsValid() && counts.Size() == 100000 && counts.DistinctSize() == 1000;
+    countPassed &= counts.Count(0) == 100 && counts.Count(999) == 100 && counts.Count(1000) == 0;
+    cout << (countPassed ? "passed" : "failed") << "...multiset count test" << endl;
+
+    MultisetType<int> multiset;
+    for (int value : { 5, 3, 5, 7, 3, 5 })
+        multiset.Insert(value);
+    multiset.Insert(9, 4);
+    bool removePassed = multiset.Remove(5) && multiset.Count(5) == 2;
+    removePassed &= multiset.Remove(7) && multiset.Count(7) == 0 && !multiset.Remove(7);
+    removePassed &= multiset.RemoveAll(9) == 4 && multiset.Count(9) == 0;
+    removePassed &= multiset.IsValid() && multiset.Size() == 4 && multiset.DistinctSize() == 2;
+    cout << (removePassed ? "passed" : "failed") << "...multiset removal test" << endl;
+
+    List<int> items;
+    List<int> copies;
+    for (const CountedItem<int>& entry : multiset)
+    {
+        items.Append(entry.item);
+        copies.Append(static_cast<int>(entry.count));
+    }
+    cout << (SequencesMatch(items, { 3, 5 }) && SequencesMatch(copies, { 2, 2 }) ? "passed" : "failed") << "...multiset iteration test" << endl;
+}
+
+
+struct Connection
+{
+    Connection(int id_, const string& name_) : id(id_), name(name_) {}
+    int id;
+    string name;
+    ListHook<Connection> byAge;
+    AVLHook<Connection> byId;
+    AVLHook<Connection> byName;
+};
+
+
+struct ConnectionsById
+{
+    bool operator()(const Connection& lhs, const Connection& rhs) const { return lhs.id < rhs.id; }
+    bool operator()(const Connection& lhs, int rhs) const { return lhs.id < rhs; }
+    bool operator()(int lhs, const Connection& rhs) const { return lhs < rhs.id; }
+};
+
+
+struct ConnectionsByName
+{
+    bool operator()(const Connection& lhs, const Connection& rhs) const { return lhs.name < rhs.name; }
+    bool operator()(const Connection& lhs, const string& rhs) const { return lhs.name < rhs; }
+    bool operator()(const string& lhs, const Connection& rhs) const { return lhs < rhs.name; }
+};
+
+
+void IntrusiveTest()
+{
+    // The same objects, in one list and two trees at once.
+    Connection connections[] = { { 5, "echo" }, { 2, "bravo" }, { 7, "golf" }, { 1, "alpha" }, { 4, "delta" }, { 3, "charlie" } };
+    IntrusiveList<Connection, &Connection::byAge> byAge;
+    IntrusiveAVLTree<Connection, &Connection::byId, ConnectionsById> byId;
+    IntrusiveAVLTree<Connection, &Connection::byName, ConnectionsByName> byName;
+    for (Connection& connection : connections)
+    {
+        byAge.Append(connection);
+        byId.Insert(connection);
+        byName.Insert(connection);
+    }
+
+    List<int> ids;
+    for (const Connection& connection : byAge)
+        ids.Append(connection.id);
+    bool listPassed = byAge.IsValid() && SequencesMatch(ids, { 5, 2, 7, 1, 4, 3 });
+    byAge.PopFront();
+    byAge.Remove(connections[3]);
+    byAge.Insert(connections[0]);
+    ids.Clear();
+    for (const Connection& connection : byAge)
+        ids.Append(connection.id);
+    listPassed &= byAge.IsValid() && SequencesMatch(ids, { 5, 2, 7, 4, 3 }) && &byAge.Back() == &connections[5];
+    cout << (listPassed ? "passed" : "failed") << "...intrusive list test" << endl;
+
+    ids.Clear();
+    for (const Connection& connection : byId)
+        ids.Append(connection.id);
+    bool treePassed = byId.IsValid() && byName.IsValid() && SequencesMatch(ids, { 1, 2, 3, 4, 5, 7 });
+    treePassed &= byId.Find(4) == &connections[4] && byName.Find(string("golf")) == &connections[2] && byId.Find(6) == nullptr;
+    Connection duplicate(4, "duplicate");
+    treePassed &= !byId.Insert(duplicate) && byId.Size() == 6;
+    cout << (treePassed ? "passed" : "failed") << "...intrusive tree test" << endl;
+
+    // Removal needs no search, and leaves the object in its other indexes.
+    byId.Remove(connections[1]);
+    byId.Remove(connections[0]);
+    ids.Clear();
+    for (const Connection& connection : byId)
+        ids.Append(connection.id);
+    bool removePassed = byId.IsValid() && SequencesMatch(ids, { 1, 3, 4, 7 }) && byId.Find(2) == nullptr;
+    removePassed &= byName.IsValid() && byName.Size() == 6 && byName.Find(string("bravo")) == &connections[1];
+    cout << (removePassed ? "passed" : "failed") << "...intrusive removal test" << endl;
+}
+
+
+template<template<class, class> class LeftMap, template<class, class> class RightMap>
+void MapJoinTest()
+{
+    LeftMap<int, string> names;
+    names.Insert(Pair<int, string>(3, "three"));
+    names.Insert(Pair<int, string>(1, "one"));
+    names.Insert(Pair<int, string>(5, "five"));
+    names.Insert(Pair<int, string>(2, "two"));
+    names.Insert(Pair<int, string>(2, "deux")); // Duplicate key. Ignored.
+
+    const Pair<int, string>* found = names.Find(2);
+    bool findPassed = names.IsValid() && names.Size() == 4 && found != nullptr && found->value == "two" && names.Find(4) == nullptr;
+    cout << (findPassed ? "passed" : "failed") << "...map find test" << endl;
+
+    RightMap<int, int> numbers;
+    numbers.Insert(Pair<int, int>(4, 40));
+    numbers.Insert(Pair<int, int>(2, 20));
+    numbers.Insert(Pair<int, int>(3, 30));
+
+    List<int> keys;
+    List<int> values;
+    bool namesMatch = true;
+    MergeJoin(names, numbers, [&](const int& key, const string& name, const int& number)
+    {
+        keys.Append(key);
+        values.Append(number);
+        namesMatch &= (key == 2 && name == "two") || (key == 3 && name == "three");
+    });
+    cout << (namesMatch && SequencesMatch(keys, { 2, 3 }) && SequencesMatch(values, { 20, 30 }) ? "passed" : "failed") << "...merge join test" << endl;
+    keys.Clear();
+    values.Clear();
+
+    LeftOuterJoin(names, numbers, [&](const int& key, const string&, const int* number)
+    {
+        keys.Append(key);
+        values.Append(number != nullptr ? *number : -1);
+    });
+    cout << (SequencesMatch(keys, { 1, 2, 3, 5 }) && SequencesMatch(values, { -1, 20, 30, -1 }) ? "passed" : "failed") << "...left outer join test" << endl;
+    keys.Clear();
+    values.Clear();
+
+    AntiJoin(names, numbers, [&](const int& key, const string&) { keys.Append(key); });
+    cout << (SequencesMatch(keys, { 1, 5 }) ? "passed" : "failed") << "...anti join test" << endl;
+    keys.Clear();
+
+    // A small map joined against a large one seeks through the large one.
+    RightMap<int, int> squares;
+    for (int i = 0; i < 10000; i += 2)
+        squares.Insert(Pair<int, int>(i, i * i));
+    LeftMap<int, string> probes;
+    probes.Insert(Pair<int, string>(7, "seven"));
+    probes.Insert(Pair<int, string>(4, "four"));
+    probes.Insert(Pair<int, string>(5000, "five thousand"));
+    MergeJoin(probes, squares, [&](const int& key, const string&, const int& square)
+    {
+        keys.Append(key);
+        values.Append(square);
+    });
+    bool skewedPassed = SequencesMatch(keys, { 4, 5000 }) && SequencesMatch(values, { 16, 25000000 });
+    keys.Clear();
+    AntiJoin(probes, squares, [&](const int& key, const string&) { keys.Append(key); });
+    skewedPassed &= SequencesMatch(keys, { 7 });
+    cout << (skewedPassed ? "passed" : "failed") << "...skewed join test" << endl;
+}
+
+
+void ListSortTest()
+{
+    List<int> integerList(VALUES);
+    integerList.Sort();
+    bool sortPassed = integerList.IsValid() && SequencesMatch(integerList, SORTED_VALUES);
+    integerList.Sort([](const int& lhs, const int& rhs) { return lhs > rhs; });
+    integerList.Reverse();
+    sortPassed &= integerList.IsValid() && SequencesMatch(integerList, SORTED_VALUES);
+    cout << (sortPassed ? "passed" : "failed") << "...sort test" << endl;
+
+    // Pairs compare by key alone, so equal keys must keep their original order.
+    List<Pair<int, int>> pairs;
+    for (int i = 0; i < 1000; i++)
+        pairs.Append(Pair<int, int>((i * 7919) % 10, i));
+    pairs.Sort();
+    bool stablePassed = pairs.IsValid();
+    const Pair<int, int>* previous = nullptr;
+    for (const Pair<int, int>& pair : pairs)
+    {
+        if (previous != nullptr && (pair < *previous || (pair == *previous && pair.value < previous->value)))
+            stablePassed = false;
+        previous = &pair;
+    }
+    cout << (stablePassed ? "passed" : "failed") << "...stable sort test" << endl;
+
+    List<int> duplicates({ 5, 3, 5, 1, 3, 3, 9, 1 });
+    duplicates.Sort();
+    duplicates.Unique();
+    bool uniquePassed = duplicates.IsValid() && SequencesMatch(duplicates, { 1, 3, 5, 9 });
+    duplicates.Append(9);
+    duplicates.Unique();
+    uniquePassed &= duplicates.IsValid() && SequencesMatch(duplicates, { 1, 3, 5, 9 });
+    AVLTree<int> tree;
+    tree.InsertSorted(duplicates);
+    uniquePassed &= tree.IsValid() && tree.Size() == 4;
+    cout << (uniquePassed ? "passed" : "failed") << "...unique test" << endl;
+}
+
+
+void ListSpliceTest()
+{
+    List<int> front({ 2, 13, 10 });
+    List<int> middle({ 5, 12, 7, 17, 18 });
+    List<int> back({ 37, 29, 11, 14, 15, 16 });
+    middle.Splice(std::move(back));
+    middle.SpliceFront(std::move(front));
+    List<int> empty;
+    middle.Splice(std::move(empty));
+    empty.Splice(std::move(middle));
+    bool splicePassed = empty.IsValid() && SequencesMatch(empty, VALUES);
+    splicePassed &= front.IsValid() && front.IsEmpty() && back.IsValid() && back.IsEmpty() && middle.IsValid() && middle.IsEmpty();
+    cout << (splicePassed ? "passed" : "failed") << "...splice test" << endl;
+
+    List<int> first(VALUES);
+    List<int>::ConstIterator position = first.begin();
+    for (int i = 0; i < 4; i++)
+        ++position;
+    List<int> second = first.SplitAfter(position);
+    bool splitPassed = first.IsValid() && SequencesMatch(first, { 2, 13, 10, 5, 12 });
+    splitPassed &= second.IsValid() && SequencesMatch(second, { 7, 17, 18, 37, 29, 11, 14, 15, 16 });
+    List<int> nothing = second.SplitAfter(second.end());
+    splitPassed &= nothing.IsEmpty() && second.Size() == 9;
+    first.Splice(std::move(second));
+    first.Append(0);
+    splitPassed &= first.IsValid() && first.Size() == 15;
+    cout << (splitPassed ? "passed" : "failed") << "...split test" << endl;
+}
+
+
+void ListQueueTest()
+{
+    List<int> queue;
+    for (int i = 0; i < 5; i++)
+        queue.Append(i);
+    bool queuePassed = queue.Front() == 0 && queue.Back() == 4;
+    queue.PopFront();
+    queue.PopFront();
+    queue.Append(5);
+    queuePassed &= queue.IsValid() && queue.Front() == 2 && queue.Back() == 5 && SequencesMatch(queue, { 2, 3, 4, 5 });
+    while (!queue.IsEmpty())
+        queue.PopFront();
+    queue.PopFront(); // No effect on an empty list.
+    queuePassed &= queue.IsValid() && queue.Size() == 0;
+    cout << (queuePassed ? "passed" : "failed") << "...queue test" << endl;
+
+    List<int> integerList({ 2, 10, 5 });
+    List<int>::ConstIterator position = integerList.InsertAfter(integerList.begin(), 13);
+    integerList.InsertAfter(integerList.end(), 0); // Front.
+    position = integerList.begin();
+    ++position;
+    ++position;
+    ++position;
+    ++position;
+    integerList.InsertAfter(position, 12); // After the last item.
+    bool insertPassed = integerList.IsValid() && SequencesMatch(integerList, { 0, 2, 13, 10, 5, 12 }) && integerList.Back() == 12;
+    cout << (insertPassed ? "passed" : "failed") << "...insert after test" << endl;
+
+    position = integerList.EraseAfter(integerList.end()); // Front.
+    position = integerList.EraseAfter(position); // 13
+    bool erasePassed = position != integerList.end() && *position == 10;
+    ++position;
+    position = integerList.EraseAfter(position); // 12, the last item.
+    erasePassed &= position == integerList.end() && integerList.Back() == 5;
+    erasePassed &= integerList.IsValid() && SequencesMatch(integerList, { 2, 10, 5 });
+    cout << (erasePassed ? "passed" : "failed") << "...erase after test" << endl;
+
+    // With spare nodes, a queue at its working size reuses the memory of the nodes it pops.
+    List<int> recycling;
+    recycling.SetSpareNodeLimit(4);
+    const int* addresses[4];
+    for (int i = 0; i < 4; i++)
+    {
+        recycling.Append(i);
+        addresses[i] = &recycling.Back();
+    }
+    for (int i = 0; i < 4; i++)
+        recycling.PopFront();
+    bool recyclingPassed = true;
+    for (int i = 0; i < 4; i++)
+    {
+        recycling.Append(i);
+        bool reused = false;
+        for (const int* address : addresses)
+            reused |= address == &recycling.Back();
+        recyclingPassed &= reused;
+    }
+    recycling.Clear();
+    for (int i = 0; i < 1000; i++)
+    {
+        recycling.Append(i);
+        if (i % 3 != 0)
+            recycling.PopFront();
+    }
+    recycling.SetSpareNodeLimit(0);
+    recyclingPassed &= recycling.IsValid() && recycling.Size() == 334 && recycling.Back() == 999;
+    cout << (recyclingPassed ? "passed" : "failed") << "...node recycling test" << endl;
+}
+
+
+void DListTest()
+{
+    DList<int> integerList;
+    DList<int>::ConstIterator thirteen = integerList.Append(13);
+    integerList.Insert(2);
+    DList<int>::ConstIterator five = integerList.Append(5);
+    integerList.InsertBefore(five, 10);
+    for (const int& x : { 12, 7, 17, 18, 37, 29, 11, 14, 15, 16 })
+        integerList.Append(x);
+    bool erasePassed = integerList.IsValid() && SequencesMatch(integerList, VALUES);
+    DList<int>::ConstIterator next = integerList.Erase(five);
+    erasePassed &= *next == 12;
+    integerList.Erase(thirteen);
+    integerList.PopFront();
+    integerList.PopBack();
+    erasePassed &= integerList.IsValid() && SequencesMatch(integerList, { 10, 12, 7, 17, 18, 37, 29, 11, 14, 15 });
+    cout << (erasePassed ? "passed" : "failed") << "...erase test" << endl;
+
+    List<int> backward;
+    for (const int& x : integerList.Reversed())
+        backward.Append(x);
+    cout << (SequencesMatch(backward, { 15, 14, 11, 29, 37, 18, 17, 7, 12, 10 }) ? "passed" : "failed") << "...reverse iteration test" << endl;
+
+    // Most recently used first: touching an item moves it to the front without invalidating it.
+    DList<int> recent({ 1, 2, 3, 4 });
+    DList<int>::ConstIterator three = recent.begin();
+    ++(++three);
+    recent.MoveToFront(three);
+    recent.MoveToFront(recent.begin());
+    DList<int>::ConstIterator one = recent.begin();
+    ++one;
+    recent.MoveToBack(one);
+    bool movePassed = recent.IsValid() && SequencesMatch(recent, { 3, 2, 4, 1 }) && *three == 3 && *one == 1;
+    recent.MoveToFront(one);
+    movePassed &= recent.IsValid() && SequencesMatch(recent, { 1, 3, 2, 4 }) && recent.Back() == 4;
+    cout << (movePassed ? "passed" : "failed") << "...move to front test" << endl;
+}
+
+
+void LRUCacheTest()
+{
+    LRUCache<int, string> cache(3);
+    List<int> evicted;
+    cache.SetEvictionCallback([&](const int& key, const string&) { evicted.Append(key); });
+    cache.Put(1, "one");
+    cache.Put(2, "two");
+    cache.Put(3, "three");
+    const string* one = cache.Get(1); // 2 is now the least recently used.
+    cache.Put(4, "four");
+    bool evictionPassed = one != nullptr && *one == "one" && cache.Get(2) == nullptr && SequencesMatch(evicted, { 2 });
+    cache.Put(5, "five");
+    evictionPassed &= cache.IsValid() && cache.Size() == 3 && SequencesMatch(evicted, { 2, 3 });
+    cout << (evictionPassed ? "passed" : "failed") << "...lru eviction test" << endl;
+
+    cache.Put(1, "uno"); // Replaces, and makes 4 the least recently used.
+    bool putPassed = cache.Peek(1) != nullptr && *cache.Peek(1) == "uno" && cache.Size() == 3;
+    cache.Put(6, "six");
+    putPassed &= cache.Peek(4) == nullptr && SequencesMatch(evicted, { 2, 3, 4 });
+    List<int> order;
+    for (const Pair<int, string>& entry : cache)
+        order.Append(entry.key);
+    putPassed &= cache.IsValid() && SequencesMatch(order, { 5, 1, 6 });
+    cout << (putPassed ? "passed" : "failed") << "...lru update test" << endl;
+
+    bool removePassed = cache.Remove(1) && !cache.Remove(1) && cache.Size() == 2;
+    for (int i = 0; i < 1000; i++)
+    {
+        cache.Put(i % 10, "many");
+        if (i % 7 == 0)
+            cache.Remove((i + 3) % 10);
+    }
+    removePassed &= cache.IsValid() && cache.Size() <= 3;
+    cout << (removePassed ? "passed" : "failed") << "...lru removal test" << endl;
+
+    ShardedLRUCache<int, int> shared(1000, 8);
+    std::thread threads[4];
+    for (int t = 0; t < 4; t++)
+    {
+        threads[t] = std::thread([&shared, t]()
+        {
+            int value;
+            for (int i = 0; i < 10000; i++)
+            {
+                shared.Put((i * 7 + t) % 3000, i);
+                shared.Get(i % 3000, value);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    int value = -1;
+    shared.Put(42, 4242);
+    bool sharedPassed = shared.Size() <= 1000 && shared.Get(42, value) && value == 4242 && shared.Capacity() == 1000;
+    ShardedLRUCache<int, int> uneven(10, 4), tiny(3, 8), empty(0, 4);
+    sharedPassed &= uneven.Capacity() == 10 && tiny.Capacity() == 3 && empty.Capacity() == 1;
+    for (int i = 0; i < 100; i++)
+        uneven.Put(i, i);
+    sharedPassed &= uneven.Size() <= 10;
+    cout << (sharedPassed ? "passed" : "failed") << "...sharded lru test" << endl;
+}
+
+
+void SmallContainerTest()
+{
+    SmallList<int, 4> small({ 2, 13, 10 });
+    bool listPassed = small.IsInline() && small.IsValid() && SequencesMatch(small, { 2, 13, 10 });
+    small.Insert(1);
+    listPassed &= small.IsInline() && SequencesMatch(small, { 1, 2, 13, 10 });
+    small.Append(5); // Overflows into nodes.
+    small.Reverse();
+    listPassed &= !small.IsInline() && small.IsValid() && SequencesMatch(small, { 5, 10, 13, 2, 1 });
+    small.Clear();
+    small.Append(7);
+    listPassed &= small.IsInline() && small.IsValid() && SequencesMatch(small, { 7 });
+    cout << (listPassed ? "passed" : "failed") << "...small list test" << endl;
+
+    // The List operations behave the same before and after spilling into nodes.
+    SmallList<int, 4> inlineOps({ 9, 3, 9, 3 });
+    inlineOps.Sort();
+    inlineOps.Unique();
+    SmallList<int, 4>::ConstIterator itr = inlineOps.InsertAfter(inlineOps.begin(), 6);
+    inlineOps.EraseAfter(itr);
+    inlineOps.PopFront();
+    bool opsPassed = inlineOps.IsInline() && SequencesMatch(inlineOps, { 6 }) && inlineOps.Front() == 6 && inlineOps.Back() == 6;
+    SmallList<int, 4> spilledOps({ 8, 1, 8, 4, 1 });
+    spilledOps.Sort();
+    spilledOps.Unique();
+    spilledOps.InsertAfter(spilledOps.end(), 0);
+    spilledOps.EraseAfter(spilledOps.begin());
+    opsPassed &= !spilledOps.IsInline() && spilledOps.IsValid() && SequencesMatch(spilledOps, { 0, 4, 8 });
+    SmallList<int, 4> full({ 1, 2, 3, 4 });
+    full.InsertAfter(++full.begin(), 10); // Spills, then links a node.
+    opsPassed &= !full.IsInline() && SequencesMatch(full, { 1, 2, 10, 3, 4 });
+    SmallList<int, 4> tail = full.SplitAfter(++full.begin());
+    opsPassed &= SequencesMatch(full, { 1, 2 }) && SequencesMatch(tail, { 10, 3, 4 });
+    inlineOps.Splice(SmallList<int, 4>({ 7 }));
+    inlineOps.SpliceFront(SmallList<int, 4>({ 5 }));
+    opsPassed &= inlineOps.IsInline() && SequencesMatch(inlineOps, { 5, 6, 7 });
+    inlineOps.Splice(std::move(tail));
+    opsPassed &= !inlineOps.IsInline() && inlineOps.IsValid() && tail.IsEmpty();
+    opsPassed &= SequencesMatch(inlineOps, { 5, 6, 7, 10, 3, 4 }) && inlineOps.Back() == 4;
+    cout << (opsPassed ? "passed" : "failed") << "...small list operations test" << endl;
+
+    SmallAVLTree<int, 4> tiny;
+    for (int x : { 12, 5, 7 })
+        tiny.Insert(x);
+    bool treePassed = tiny.IsValid() && tiny.GetStats().representation == SmallAVLTree<int, 4>::Representation::Inline;
+    treePassed &= tiny.Search(5) && !tiny.Search(6) && SequencesMatch(tiny, { 5, 7, 12 });
+    AVLTree<int> large;
+    for (const int& x : VALUES)
+        large.Insert(x);
+    treePassed &= SequencesMatch(tiny.Intersect(large), { 5, 7, 12 }) && large.Intersect(tiny).Size() == 3;
+    tiny.Insert(2);
+    tiny.Insert(3); // Overflows into nodes.
+    treePassed &= tiny.IsValid() && tiny.GetStats().representation == SmallAVLTree<int, 4>::Representation::Tree;
+    treePassed &= SequencesMatch(tiny, { 2, 3, 5, 7, 12 });
+    cout << (treePassed ? "passed" : "failed") << "...small tree test" << endl;
+}
+
+
+void MPSCListTest()
+{
+    MPSCList<string> strings;
+    string popped;
+    bool singlePassed = strings.IsEmpty() && !strings.PopFront(popped);
+    strings.Append("one");
+    strings.Append("two");
+    strings.Append("three");
+    singlePassed &= !strings.IsEmpty() && strings.PopFront(popped) && popped == "one";
+    string drained;
+    singlePassed &= strings.Drain([&](string& item) { drained += item + " "; }) == 2;
+    singlePassed &= drained == "two three " && strings.IsEmpty();
+    cout << (singlePassed ? "passed" : "failed") << "...mpsc list test" << endl;
+
+    // Each producer's items must arrive complete and in the order it appended them.
+    const int producerCount = 4;
+    const int itemCount = 20000;
+    MPSCList<int> queue;
+    int nextExpected[producerCount] = {};
+    bool orderPassed = true;
+    int received = 0;
+    auto consume = [&](int& item)
+    {
+        int producer = item / itemCount;
+        orderPassed &= item % itemCount == nextExpected[producer];
+        nextExpected[producer]++;
+        received++;
+    };
+    std::thread threads[producerCount];
+    for (int producer = 0; producer < producerCount; producer++)
+    {
+        threads[producer] = std::thread([&queue, producer, itemCount]()
+        {
+            for (int i = 0; i < itemCount; i++)
+                queue.Append(producer * itemCount + i);
+        });
+    }
+    int item;
+    while (received < producerCount * itemCount)
+    {
+        if (queue.PopFront(item))
+            consume(item);
+        queue.Drain(consume);
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    cout << (orderPassed && received == producerCount * itemCount && queue.IsEmpty() ? "passed" : "failed") << "...mpsc concurrent append test" << endl;
+}
+
+
+void UnrolledListTest()
+{
+    // Block-wise append across several partially filled nodes.
+    int values[] = VALUES;
+    UnrolledList<int, 4> blocks;
+    blocks.Append(2);
+    blocks.Append(values + 1, 13);
+    cout << (blocks.IsValid() && SequencesMatch(blocks, VALUES) ? "passed" : "failed") << "...block append test" << endl;
+
+    // Mixed insertion at both ends, then reversal.
+    UnrolledList<int, 4> mixed;
+    List<int> expected;
+    for (int i = 0; i < 50; i++)
+    {
+        if (i % 3 == 0)
+        {
+            mixed.Insert(i);
+            expected.Insert(i);
+        }
+        else
+        {
+            mixed.Append(i);
+            expected.Append(i);
+        }
+    }
+    bool mixedPassed = mixed.IsValid() && SequencesMatch(mixed, expected);
+    mixed.Reverse();
+    expected.Reverse();
+    mixedPassed &= mixed.IsValid() && SequencesMatch(mixed, expected);
+    cout << (mixedPassed ? "passed" : "failed") << "...mixed insert and append test" << endl;
+
+    UnrolledList<string, 3> strings;
+    strings.Append("two");
+    strings.Insert("one");
+    strings.Append("three");
+    strings.Append("four");
+    strings.Reverse();
+    string joined;
+    for (const string& s : strings)
+        joined += s + " ";
+    cout << (strings.IsValid() && joined == "four three two one " ? "passed" : "failed") << "...non-trivial item test" << endl;
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && string(argv[1]) == "benchmark")
+    {
+        IntersectBenchmark();
+        return 0;
+    }
+
+    cout << "\n\nTesting AVLTree<int>...\n\n";
+    IntegerTreeTest<AVLTree<int>>();
+    cout << "\n\nTesting RBTree<int>...\n\n";
+    IntegerTreeTest<RBTree<int>>();
+
+    cout << "\n\nTesting augmented AVLTree...\n\n";
+    AugmentedTreeTest<AVLTree>();
+    cout << "\n\nTesting augmented RBTree...\n\n";
+    AugmentedTreeTest<RBTree>();
+
+    cout << "\n\nTesting blocked Intersect...\n\n";
+    BlockedIntersectTest();
+
+    cout << "\n\nTesting FlatSet<int>...\n\n";
+    FlatSetTest();
+
+    cout << "\n\nTesting AdaptiveSet<int>...\n\n";
+    AdaptiveSetTest();
+
+    cout << "\n\nTesting RoaringSet<int>...\n\n";
+    RoaringSetTest();
+
+    cout << "\n\nTesting ARTSet<string>...\n\n";
+    ARTSetTest();
+
+    cout << "\n\nTesting PrefixKey<string>...\n\n";
+    PrefixKeyTest();
+
+    cout << "\n\nTesting IntervalTree<int>...\n\n";
+    IntervalTreeTest();
+
+    cout << "\n\nTesting AVLMultiset<int>...\n\n";
+    MultisetTest<AVLMultiset>();
+    cout << "\n\nTesting RBMultiset<int>...\n\n";
+    MultisetTest<RBMultiset>();
+
+    cout << "\n\nTesting intrusive containers...\n\n";
+    IntrusiveTest();
+
+    cout << "\n\nTesting AVLMap joined with RBMap...\n\n";
+    MapJoinTest<AVLMap, RBMap>();
+    cout << "\n\nTesting RBMap joined with AVLMap...\n\n";
+    MapJoinTest<RBMap, AVLMap>();
+
+    // These are disabled becuase AVLTreeMorris<T> implementation is incomplete.
+    //cout << "\n\nTesting AVLTreeMorris<int>...\n\n";
+    //IntegerTreeTest<AVLTreeMorris<int>>();
+
+    cout << "\n\nTesting List<int>...\n\n";
+    IntegerListTest<List<int>>();
+    ListSortTest();
+    ListSpliceTest();
+    ListQueueTest();
+
+    cout << "\n\nTesting UnrolledList<int, 4>...\n\n";
+    IntegerListTest<UnrolledList<int, 4>>();
+    UnrolledListTest();
+
+    cout << "\n\nTesting SmallList<int, 4>...\n\n";
+    IntegerListTest<SmallList<int, 4>>();
+    SmallContainerTest();
+
+    cout << "\n\nTesting DList<int>...\n\n";
+    IntegerListTest<DList<int>>();
+    DListTest();
+
+    cout << "\n\nTesting LRUCache<int, string>...\n\n";
+    LRUCacheTest();
+
+    cout << "\n\nTesting MPSCList<int>...\n\n";
+    MPSCListTest();
+
+
+    cout << "\n\nTestling List<string>...\n\n";
+    List<string> names;
+    names.Insert("Charlie");
+    names.Insert("Bob");
+    names.Insert("Aaron");
+    names.Append("Xavier");
+    names.Append("Yolanda");
+    names.Append("Zoe");
+
+    cout << "forward...\n";
+    for (const string& name : names)
+        cout << "name: " << name << "\n";
+
+    cout << "\nreverse...\n";
+    names.Reverse();
+    for (const string& name : names)
+        cout << "name: " << name << "\n";
+    names.Clear();
+
+    return 0;
+} 
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
 */
\ No newline at end of file
@@ -0,0 +1,230 @@
+#ifndef _MPSCLIST_H_
+#define _MPSCLIST_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/* MPSCList
+
+   Bob Burrough, 2021
+
+   A multi-producer, single-consumer FIFO queue, after Dmitry Vyukov's
+   intrusive MPSC node-based queue. Like List<T>, it's a singly-linked list
+   of nodes holding a next pointer and an item, linked from the oldest item
+   (the tail, owned by the consumer) to the newest (the head, shared by the
+   producers).
+
+   Append() may be called from any number of threads at once. It is
+   wait-free: a producer claims its place with a single atomic exchange of
+   the head pointer, then links the previous head to its node. PopFront()
+   and Drain() must only be called from one thread at a time.
+
+   The list always contains one stub node whose item has already been
+   consumed (or never existed), so producers and the consumer never touch
+   the same pointer unless the list is empty. An item is visible to the
+   consumer once its producer has linked it; until then, it and every item
+   appended after it are not. */
+
+template<class T>
+class MPSCList
+{
+public:
+    MPSCList();
+    virtual ~MPSCList();
+    MPSCList(const MPSCList& other) = delete; // Not copyable, since producers may be appending.
+    MPSCList<T>& operator=(const MPSCList& other) = delete;
+
+    // Append an item to the end of the list. Safe to call from any thread. Wait-free.
+    void Append(const T& item);
+    void Append(T&& item);
+
+    /* Move the oldest item into item and remove it. Returns false if there
+       is no item to remove. Consumer only. O(1) */
+    bool PopFront(T& item);
+
+    /* Remove every item available, oldest first, passing each to
+       visitor(T& item) before it's destroyed. Items appended during the
+       drain may or may not be included. Returns the number of items
+       removed. Consumer only. O(n) */
+    template<class Visitor>
+    size_t Drain(Visitor visitor);
+
+    // Returns true if no item is available to the consumer. Consumer only.
+    bool IsEmpty() const;
+
+protected:
+private:
+    class Node
+    {
+    public:
+        Node();
+
+        friend class MPSCList<T>;
+
+    protected:
+    private:
+        T* Item();
+
+        std::atomic<Node*> next;
+        alignas(T) unsigned char storage[sizeof(T)]; // The item, constructed by Append() and destroyed by the consumer.
+    };
+
+    void Link(Node* node);
+
+    // Destroy the front item and make its node the stub. Returns the node.
+    Node* Advance(Node* next);
+
+    std::atomic<Node*> head; // Newest node, exchanged by producers.
+    Node* tail; // The stub, which precedes the oldest item. Consumer only.
+};
+
+
+template<class T>
+MPSCList<T>::MPSCList()
+    : head(nullptr), tail(new Node())
+{
+    head.store(tail, std::memory_order_relaxed);
+}
+
+
+template<class T>
+MPSCList<T>::~MPSCList()
+{
+    Drain([](T&) {});
+    delete tail;
+}
+
+
+template<class T>
+void MPSCList<T>::Append(const T& item)
+{
+    Node* node = new Node();
+    new (node->Item()) T(item);
+    Link(node);
+}
+
+
+template<class T>
+void MPSCList<T>::Append(T&& item)
+{
+    Node* node = new Node();
+    new (node->Item()) T(std::move(item));
+    Link(node);
+}
+
+
+template<class T>
+void MPSCList<T>::Link(Node* node)
+{
+    // The exchange orders this producer among all producers. Between it and
+    // the store below, the consumer sees the list end at previous.
+    Node* previous = head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+}
+
+
+template<class T>
+bool MPSCList<T>::PopFront(T& item)
+{
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr)
+        return false;
+    item = std::move(*next->Item());
+    Advance(next);
+    return true;
+}
+
+
+template<class T>
+template<class Visitor>
+size_t MPSCList<T>::Drain(Visitor visitor)
+{
+    size_t count = 0;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    while (next != nullptr)
+    {
+        visitor(*next->Item());
+        next = Advance(next)->next.load(std::memory_order_acquire);
+        count++;
+    }
+    return count;
+}
+
+
+template<class T>
+typename MPSCList<T>::Node* MPSCList<T>::Advance(Node* next)
+{
+    next->Item()->~T();
+    delete tail;
+    tail = next;
+    return tail;
+}
+
+
+template<class T>
+bool MPSCList<T>::IsEmpty() const
+{
+    return tail->next.load(std::memory_order_acquire) == nullptr;
+}
+
+
+template<class T>
+MPSCList<T>::Node::Node()
+    : next(nullptr)
+{}
+
+
+template<class T>
+T* MPSCList<T>::Node::Item()
+{
+    return reinterpret_cast<T*>(storage);
+}
+
+
+template class MPSCList<int>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef _MULTISET_H_
+#define _MULTISET_H_
+
+#include <cstddef>
+#include "avltree.h"
+#include "rbtree.h"
+
+/* Multiset
+
+   Bob Burrough, 2021
+
+   Store items with repetition, e.g. AVLMultiset<T> or RBMultiset<T>. Rather
+   than a node per copy, the underlying tree holds one node per distinct
+   item together with a count, so a million insertions of a thousand
+   distinct items occupy a thousand nodes. Insertion, removal, and Count()
+   are O(log D), where D is the number of distinct items.
+
+   Iteration visits each distinct item once, in ascending order, as a
+   CountedItem holding the item and the number of copies. */
+
+template<class T>
+class CountedItem
+{
+public:
+    CountedItem(const T& item_, size_t count_);
+    T item;
+    mutable size_t count; // Not part of the ordering, so it may change while in a tree.
+
+    // Ordered by item alone.
+    bool operator<(const CountedItem<T>& other) const { return item < other.item; }
+    bool operator>(const CountedItem<T>& other) const { return other.item < item; }
+    bool operator==(const CountedItem<T>& other) const { return item == other.item; }
+    bool operator!=(const CountedItem<T>& other) const { return !(item == other.item); }
+private:
+    CountedItem() = delete;
+};
+
+// Compare with a bare item, for lookups.
+template<class T>
+bool operator<(const CountedItem<T>& lhs, const T& rhs) { return lhs.item < rhs; }
+template<class T>
+bool operator<(const T& lhs, const CountedItem<T>& rhs) { return lhs < rhs.item; }
+
+
+template<class T, template<class, class> class Tree>
+class Multiset
+{
+public:
+    typedef Tree<CountedItem<T>, NoAugmentation> TreeType;
+
+    Multiset();
+
+    // Add copies of an item. Complexity is O(log D).
+    void Insert(const T& item, size_t copies = 1);
+
+    // Remove one copy of an item. Returns false if there was none. Complexity is O(log D).
+    bool Remove(const T& item);
+
+    // Remove every copy of an item. Returns the number removed. Complexity is O(log D).
+    size_t RemoveAll(const T& item);
+
+    // Returns the number of copies of an item. Complexity is O(log D).
+    size_t Count(const T& item) const;
+
+    // Returns the total number of items, counting every copy. O(1)
+    size_t Size() const;
+
+    // Returns the number of distinct items, i.e. the number of nodes. O(1)
+    size_t DistinctSize() const;
+
+    void Clear();
+
+    /* Consistency check. Returns true if the multiset
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+    typedef typename TreeType::ConstIterator ConstIterator; // Visits a CountedItem per distinct item.
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+protected:
+private:
+    TreeType tree;
+    size_t size;
+};
+
+
+template<class T>
+using AVLMultiset = Multiset<T, AVLTree>;
+
+template<class T>
+using RBMultiset = Multiset<T, RBTree>;
+
+
+template<class T>
+CountedItem<T>::CountedItem(const T& item_, size_t count_)
+    : item(item_), count(count_)
+{}
+
+
+template<class T, template<class, class> class Tree>
+Multiset<T, Tree>::Multiset()
+    : size(0)
+{}
+
+
+template<class T, template<class, class> class Tree>
+void Multiset<T, Tree>::Insert(const T& item, size_t copies)
+{
+    if (copies == 0)
+        return;
+    const CountedItem<T>* existing = tree.Find(item);
+    if (existing != nullptr)
+        existing->count += copies;
+    else
+        tree.Insert(CountedItem<T>(item, copies));
+    size += copies;
+}
+
+
+template<class T, template<class, class> class Tree>
+bool Multiset<T, Tree>::Remove(const T& item)
+{
+    const CountedItem<T>* existing = tree.Find(item);
+    if (existing == nullptr)
+        return false;
+    if (existing->count > 1)
+        existing->count--;
+    else
+        tree.Remove(*existing);
+    size--;
+    return true;
+}
+
+
+template<class T, template<class, class> class Tree>
+size_t Multiset<T, Tree>::RemoveAll(const T& item)
+{
+    const CountedItem<T>* existing = tree.Find(item);
+    if (existing == nullptr)
+        return 0;
+    size_t removed = existing->count;
+    tree.Remove(*existing);
+    size -= removed;
+    return removed;
+}
+
+
+template<class T, template<class, class> class Tree>
+size_t Multiset<T, Tree>::Count(const T& item) const
+{
+    const CountedItem<T>* existing = tree.Find(item);
+    return existing != nullptr ? existing->count : 0;
+}
+
+
+template<class T, template<class, class> class Tree>
+size_t Multiset<T, Tree>::Size() const
+{
+    return size;
+}
+
+
+template<class T, template<class, class> class Tree>
+size_t Multiset<T, Tree>::DistinctSize() const
+{
+    return tree.Size();
+}
+
+
+template<class T, template<class, class> class Tree>
+void Multiset<T, Tree>::Clear()
+{
+    tree.Clear();
+    size = 0;
+}
+
+
+template<class T, template<class, class> class Tree>
+bool Multiset<T, Tree>::IsValid() const
+{
+    size_t total = 0;
+    for (const CountedItem<T>& entry : tree)
+    {
+        if (entry.count == 0)
+            return false;
+        total += entry.count;
+    }
+    return tree.IsValid() && total == size;
+}
+
+
+template<class T, template<class, class> class Tree>
+typename Multiset<T, Tree>::ConstIterator Multiset<T, Tree>::begin() const
+{
+    return tree.begin();
+}
+
+
+template<class T, template<class, class> class Tree>
+typename Multiset<T, Tree>::ConstIterator Multiset<T, Tree>::end() const
+{
+    return tree.end();
+}
+
+
+template class Multiset<int, AVLTree>; // To force compilation of the template, for compile-time validation.
+template class Multiset<int, RBTree>;
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
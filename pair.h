@@ -1,69 +1,107 @@
-#ifndef _PAIR_H_
-#define _PAIR_H_
-
-/* Pair
-
-   Bob Burrough, 2021
-
-   Store a pair of items (e.g. a key/value pair). */
-
-template<class KeyType, class ValueType>
-class Pair
-{
-public:    
-    Pair(const KeyType& key_, const ValueType& value_);
-    KeyType key;
-    ValueType value;
-private:
-    Pair() = delete; // Providing instantiated keys and values is required.
-};
-
-
-template<class KeyType, class ValueType>
-Pair<KeyType, ValueType>::Pair(const KeyType& key_, const ValueType& value_)
-    : key(key_), value(value_)
-{}
-
-/*
-------------------------------------------------------------------------------
-This software is available under 2 licenses -- choose whichever you prefer.
-------------------------------------------------------------------------------
-ALTERNATIVE A - MIT License
-Copyright (c) 2021 Bobby G. Burrough
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-------------------------------------------------------------------------------
-ALTERNATIVE B - Public Domain (www.unlicense.org)
-This is free and unencumbered software released into the public domain.
-Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
-software, either in source code form or as a compiled binary, for any purpose,
-commercial or non-commercial, and by any means.
-In jurisdictions that recognize copyright laws, the author or authors of this
-software dedicate any and all copyright interest in the software to the public
-domain. We make this dedication for the benefit of the public at large and to
-the detriment of our heirs and successors. We intend this dedication to be an
-overt act of relinquishment in perpetuity of all present and future rights to
-this software under copyright law.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
-ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
-WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-------------------------------------------------------------------------------
-*/
-
+#ifndef _PAIR_H_
+#define _PAIR_H_
+
+/* Pair
+
+   Bob Burrough, 2021
+
+   Store a pair of items (e.g. a key/value pair).
+
+   Pairs are compared by key alone, and may also be compared directly with
+   a key. This lets a tree of pairs serve as a map (see AVLMap and RBMap),
+   searched by key and joined with other maps by key regardless of the
+   type of their values. */
+
+template<class KeyType, class ValueType>
+class Pair
+{
+public:    
+    Pair(const KeyType& key_, const ValueType& value_);
+    typedef KeyType Key;
+    typedef ValueType Value;
+    KeyType key;
+    ValueType value;
+private:
+    Pair() = delete; // Providing instantiated keys and values is required.
+};
+
+
+template<class KeyType, class ValueType>
+Pair<KeyType, ValueType>::Pair(const KeyType& key_, const ValueType& value_)
+    : key(key_), value(value_)
+{}
+
+
+// Pair against pair. The values may be of different types.
+template<class K, class V1, class V2>
+bool operator==(const Pair<K, V1>& lhs, const Pair<K, V2>& rhs) { return lhs.key == rhs.key; }
+template<class K, class V1, class V2>
+bool operator!=(const Pair<K, V1>& lhs, const Pair<K, V2>& rhs) { return !(lhs.key == rhs.key); }
+template<class K, class V1, class V2>
+bool operator<(const Pair<K, V1>& lhs, const Pair<K, V2>& rhs) { return lhs.key < rhs.key; }
+template<class K, class V1, class V2>
+bool operator>(const Pair<K, V1>& lhs, const Pair<K, V2>& rhs) { return rhs.key < lhs.key; }
+
+// Pair against key.
+template<class K, class V>
+bool operator==(const Pair<K, V>& lhs, const typename Pair<K, V>::Key& key) { return lhs.key == key; }
+template<class K, class V>
+bool operator!=(const Pair<K, V>& lhs, const typename Pair<K, V>::Key& key) { return !(lhs.key == key); }
+template<class K, class V>
+bool operator<(const Pair<K, V>& lhs, const typename Pair<K, V>::Key& key) { return lhs.key < key; }
+template<class K, class V>
+bool operator>(const Pair<K, V>& lhs, const typename Pair<K, V>::Key& key) { return key < lhs.key; }
+
+// Key against pair.
+template<class K, class V>
+bool operator==(const typename Pair<K, V>::Key& key, const Pair<K, V>& rhs) { return key == rhs.key; }
+template<class K, class V>
+bool operator!=(const typename Pair<K, V>::Key& key, const Pair<K, V>& rhs) { return !(key == rhs.key); }
+template<class K, class V>
+bool operator<(const typename Pair<K, V>::Key& key, const Pair<K, V>& rhs) { return key < rhs.key; }
+template<class K, class V>
+bool operator>(const typename Pair<K, V>::Key& key, const Pair<K, V>& rhs) { return rhs.key < key; }
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
 #endif
\ No newline at end of file
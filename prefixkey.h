@@ -0,0 +1,225 @@
+#ifndef _PREFIXKEY_H_
+#define _PREFIXKEY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+/* PrefixKey
+
+   Bob Burrough, 2021
+
+   A string key which carries its first 8 bytes packed into an integer,
+   most significant byte first, so that comparing the integers orders
+   keys the same way as comparing their bytes. A tree of PrefixKeys, e.g.
+   AVLTree<PrefixKey<string>>, holds the integer in each node beside the
+   child pointers. Most comparisons during Search() and Insert() are then
+   decided by one integer comparison, without following the string's
+   pointer to its characters, which would be a second cache miss at every
+   level of the tree. Only keys whose first 8 bytes agree fall back to
+   comparing the strings.
+
+   With CacheHash, the key's std::hash is also stored. Equality fails fast
+   on differing hashes, and std::hash<PrefixKey> returns the stored value,
+   e.g. for IntersectUnsorted().
+
+   S may be std::string or anything else with size(), operator[],
+   operator== and operator<() which holds bytes. */
+
+template<class S, bool CacheHash>
+class PrefixKeyHash
+{
+public:
+    size_t Hash(const S& value) const { return std::hash<S>()(value); }
+
+protected:
+    PrefixKeyHash(const S&) {}
+    bool MayEqual(const PrefixKeyHash<S, CacheHash>&) const { return true; }
+};
+
+
+template<class S>
+class PrefixKeyHash<S, true>
+{
+public:
+    size_t Hash(const S&) const { return hash; }
+
+protected:
+    PrefixKeyHash(const S& value) : hash(std::hash<S>()(value)) {}
+    bool MayEqual(const PrefixKeyHash<S, true>& other) const { return hash == other.hash; }
+
+private:
+    size_t hash;
+};
+
+
+template<class S = std::string, bool CacheHash = false>
+class PrefixKey : private PrefixKeyHash<S, CacheHash>
+{
+public:
+    PrefixKey(const S& value_);
+    PrefixKey(S&& value_);
+    PrefixKey(const char* value_); // e.g. tree.Search("/usr/lib")
+
+    const S& Value() const;
+    uint64_t Prefix() const;
+    size_t Hash() const;
+
+    bool operator==(const PrefixKey<S, CacheHash>& other) const;
+    bool operator!=(const PrefixKey<S, CacheHash>& other) const;
+    bool operator<(const PrefixKey<S, CacheHash>& other) const;
+    bool operator>(const PrefixKey<S, CacheHash>& other) const;
+
+protected:
+private:
+    PrefixKey() = delete;
+    static uint64_t PrefixOf(const S& value); // Bytes beyond the end of a short key count as 0.
+
+    uint64_t prefix; // First, to share a cache line with the node's pointers.
+    S value;
+};
+
+
+template<class S, bool CacheHash>
+PrefixKey<S, CacheHash>::PrefixKey(const S& value_)
+    : PrefixKeyHash<S, CacheHash>(value_), prefix(PrefixOf(value_)), value(value_)
+{}
+
+
+template<class S, bool CacheHash>
+PrefixKey<S, CacheHash>::PrefixKey(S&& value_)
+    : PrefixKeyHash<S, CacheHash>(value_), prefix(PrefixOf(value_)), value(std::move(value_))
+{}
+
+
+template<class S, bool CacheHash>
+PrefixKey<S, CacheHash>::PrefixKey(const char* value_)
+    : PrefixKey(S(value_))
+{}
+
+
+template<class S, bool CacheHash>
+const S& PrefixKey<S, CacheHash>::Value() const
+{
+    return value;
+}
+
+
+template<class S, bool CacheHash>
+uint64_t PrefixKey<S, CacheHash>::Prefix() const
+{
+    return prefix;
+}
+
+
+template<class S, bool CacheHash>
+size_t PrefixKey<S, CacheHash>::Hash() const
+{
+    return PrefixKeyHash<S, CacheHash>::Hash(value);
+}
+
+
+template<class S, bool CacheHash>
+uint64_t PrefixKey<S, CacheHash>::PrefixOf(const S& value)
+{
+    uint64_t packed = 0;
+    size_t length = value.size();
+    for (size_t i = 0; i < 8; i++)
+        packed = (packed << 8) | (i < length ? static_cast<uint8_t>(value[i]) : 0);
+    return packed;
+}
+
+
+template<class S, bool CacheHash>
+bool PrefixKey<S, CacheHash>::operator==(const PrefixKey<S, CacheHash>& other) const
+{
+    return prefix == other.prefix && this->MayEqual(other) && value == other.value;
+}
+
+
+template<class S, bool CacheHash>
+bool PrefixKey<S, CacheHash>::operator!=(const PrefixKey<S, CacheHash>& other) const
+{
+    return !(*this == other);
+}
+
+
+/* Differing prefixes order the keys correctly, even where one key is
+   shorter than 8 bytes: it is then a prefix of the other up to the first
+   differing byte, where its padding byte is 0 and the other's is not.
+   Equal prefixes (including a short key against one with 0 bytes after
+   it) need the strings compared. */
+template<class S, bool CacheHash>
+bool PrefixKey<S, CacheHash>::operator<(const PrefixKey<S, CacheHash>& other) const
+{
+    if (prefix != other.prefix)
+        return prefix < other.prefix;
+    return value < other.value;
+}
+
+
+template<class S, bool CacheHash>
+bool PrefixKey<S, CacheHash>::operator>(const PrefixKey<S, CacheHash>& other) const
+{
+    return other < *this;
+}
+
+
+namespace std
+{
+    template<class S, bool CacheHash>
+    struct hash<PrefixKey<S, CacheHash>>
+    {
+        size_t operator()(const PrefixKey<S, CacheHash>& key) const { return key.Hash(); }
+    };
+}
+
+
+template class PrefixKey<std::string>; // To force compilation of the template, for compile-time validation.
+template class PrefixKey<std::string, true>;
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -1,939 +1,1657 @@
-#ifndef _RBTREE_H_
-#define _RBTREE_H_
-
-/*  red black tree 
-
-    Bob Burrough, 2021
-
-    Store items in a tree and retrieve them with O(log N) time complexity.
-    Does not use recursion and does not allocate extra memory (e.g. stacks
-    and queues) during iteration. The type stored in the tree must have
-    a meaningful operator==() and operator<() to facilitate storage in and
-    retrieval from the tree.
-
-    Differs from the Morris traversal edition in that each node has a pointer to
-    its parent, and the tree remains unmodified during traversal. To understand
-    which tree to select for your project:
-
-                                        Aborted    Complete          Memory
-                        Insert  Search  Traversal  Traversal         Usage
-                        ------  ------  ---------  ---------         -----
-    RBTree<T>            fast    slow     fast       fast     3 ptrs + 1 enum per node
-    RBTreeMorris<T>      slow    slow    slowest     slow             TBD
-    AVLTree<T>           fast    fast    fastest     fast     3 ptrs + 1 int per node
-    AVLTreeMorris<T>     slow    fast     slow       slow     2 ptrs + 1 int per node
-
-    Note, if you are so memory constrained that you are considering using
-    AVLTreeMorris<T>, make sure your compiler is configured for proper padding
-    and alignment to benefit from AVLTreeMorris<T>'s smaller node sizes. */
-
-template<class T>
-class RBTree
-{
-public:
-	RBTree();
-	virtual ~RBTree();
-    RBTree(RBTree<T>&& other); // move constructor
-
-	// Retrieve item from the tree. Complexity os O(log N).
-	bool Search(const T& item) const;
-
-	// Place an item in the tree. Complexity is O(log N).
-	void Insert(const T& item);
-
-	// Remove item from the tree. Complexity is O(log N).
-	void Remove(const T& item);
-
-    void Clear();
-
-    /* Create the intersection of this tree with another. 
-       Complexity is O(N), where N is the number of elements
-       in the smaller of the two trees. */
-    template<typename U>
-    RBTree<T> Intersect(const U& other) const;
-
-	/* Consistency check. Returns true if the red black tree
-       is internally consistent. Otherwise, false. */
-	bool IsValid() const;
-  
-protected:
-private:
-	class Node
-	{
-		/* This is implemented as a nested class to avoid
-		   presenting unnecessary interfaces to the calling
-		   program. Node is purely an internal storage
-		   concept of RBTree, and isn't used elsewhere.
-		*/
-	public:
-		Node(const T& item);		
-		virtual ~Node() = default;
-
-		friend class RBTree<T>;
-
-	protected:
-	private:
-		Node() = delete;
-		enum class RBColor { Red, Black } color;
-		T item;
-		Node* right;
-		Node* left;
-		Node* parent;
-	};
-
-	Node* root;	
-	void LeftRotate(Node* x);
-	void RightRotate(Node* x);
-	void InsertFixup(Node* z);
-    void RemoveFixup(Node* x);
-
-    // Iterator declarations
-public:
-    class ConstIterator // inorder iterator
-    {
-    public:
-        ConstIterator();
-        ConstIterator(Node* current);
-        virtual ~ConstIterator();
-        ConstIterator& operator++();
-        bool operator!=(const ConstIterator& other) const;
-        const T& operator*() const;
-
-        friend class RBTree<T>; // For access to GetNode() member function below.
-
-    protected:
-    private:
-        const Node* GetNode() const;
-        Node* current; // cached copy of the current visitable element
-    };
-    ConstIterator begin() const; // inorder iterator is the default when doing range-based iteration of RBTree
-    ConstIterator end() const;
-
-
-    class ConstPostorder // adaptor for postorder iteration
-    {
-    public:
-        ConstPostorder(const RBTree<T>& tree);
-        virtual ~ConstPostorder();
-
-        class Iterator
-        {
-        public:
-            Iterator();
-            Iterator(Node* current);
-            virtual ~Iterator();
-            Iterator& operator++();
-            bool operator!=(const Iterator& other) const;
-            const T& operator*() const;
-
-            friend class RBTree<T>; // For access to GetNode() member function below.
-
-        protected:
-        private:
-            const Node* GetNode() const; // This is used for (eg) destruction of the tree.
-            Node* current;
-            Node* next; // So we can delete nodes during traversal, we first traverse via the next pointer and allow current to be mutated/deleted.
-            bool downwardPhase; // Whether we're in the upward phase of tree traversal, or the downward phase.
-        };
-        Iterator begin() const;
-        Iterator end() const;
-
-    protected:
-    private:
-        ConstPostorder() = delete;
-        const RBTree<T>& _tree;
-    };
-};
-
-
-template<class T>
-RBTree<T>::RBTree() 
-    : root(nullptr) 
-{}
-
-
-template<class T>
-RBTree<T>::~RBTree()
-{
-    for (typename ConstPostorder::Iterator itr = ConstPostorder(*this).begin(); itr != ConstPostorder(*this).end(); ++itr)
-        delete itr.GetNode();
-}
-
-
-template<class T>
-void RBTree<T>::Clear()
-{
-    for (typename ConstPostorder::Iterator itr = ConstPostorder(*this).begin(); itr != ConstPostorder(*this).end(); ++itr)
-        delete itr.GetNode();
-    root = nullptr;
-}
-
-
-template<class T>
-RBTree<T>::RBTree(RBTree<T>&& other)
-{
-    root = other.root;
-    other.root = nullptr;
-}
-
-
-template<class T>
-bool RBTree<T>::Search(const T& item) const
-{
-    Node* current(root);
-    while (current != nullptr)
-    {
-        if (current->item == item)
-            return true;
-
-        if (item < current->item)
-            current = current->left;
-        else
-            current = current->right;
-    }
-	return false;
-}
-
-
-template<class T>
-void RBTree<T>::Insert(const T& item)
-{
-	Node* current(root);
-	Node* previous(nullptr);
-	Node* node = new Node(item);
-	while(current != nullptr)
-	{
-		previous = current;
-		if(item < current->item)
-			current = current->left;
-		else if(item > current->item)
-			current = current->right;			
-        else
-        {
-            // They're equal.
-            delete node;
-            return;
-        }
-	}
-
-	node->parent = previous;
-	if(previous == nullptr)
-		root = node;
-	else if(item < previous->item)
-		previous->left = node;
-	else
-		previous->right = node;
-
-	InsertFixup(node);
-}
-
-
-template<class T>
-void RBTree<T>::Remove(const T& item)
-{
-    Node* current(root);
-    Node* balancePoint(nullptr);
-
-    while (current != nullptr)
-    {
-        if (current->item == item)
-            break;
-
-        if (item < current->item)
-            current = current->left;
-        else
-            current = current->right;
-    }
-    if (current == nullptr)
-        return; // The tree doesn't contain the specified item.
-
-    if (current->left == nullptr && current->right == nullptr)
-    {
-        // We're removing a bottom-most node.
-        if (current == root)
-            root = nullptr;
-        else if (current->parent->left == current)
-        {
-            current->parent->left = nullptr;
-        }
-        else
-        {
-            current->parent->right = nullptr;
-        }
-    }
-    else if (current->left != nullptr && current->right == nullptr)
-    {
-        // The current node has only one child, which is on the left.
-        if (current == root)
-        {
-            root = current->left;
-            current->left->parent = nullptr;
-            balancePoint = root;
-        }
-        else if (current->parent->left == current)
-        {
-            current->parent->left = current->left;
-            balancePoint = current->left;
-            current->left->parent = current->parent;
-        }
-        else
-        {
-            current->parent->right = current->left;
-            balancePoint = current->left;
-            current->left->parent = current->parent;
-        }
-    }
-    else if (current->left == nullptr && current->right != nullptr)
-    {
-        // The current node has only one child, which is on the right.
-        if (current == root)
-        {
-            root = current->right;
-            current->right->parent = nullptr;
-            balancePoint = root;
-        }
-        else if (current->parent->left == current)
-        {
-            current->parent->left = current->right;
-            balancePoint = current->right;
-            current->right->parent = current->parent;
-        }
-        else
-        {
-            current->parent->right = current->right;
-            balancePoint = current->right;
-            current->right->parent = current->parent;
-        }
-    }
-    else
-    {
-        // current has both left and right children
-        Node* replacement = current->right;
-        while (replacement->left != nullptr)   // traverse to the minimum value in the right subtree
-            replacement = replacement->left;
-
-        replacement->left = current->left;
-        current->left->parent = replacement;
-        typename Node::RBColor temp = replacement->color;
-        replacement->color = current->color;
-        current->color = temp;
-        balancePoint = replacement->right;
-
-        if (replacement->parent != current)
-        {
-            replacement->parent->left = replacement->right;
-            replacement->right = current->right;
-            current->right->parent = replacement;
-        }
-
-        if (current == root)
-        {
-            root = replacement;
-            replacement->parent = nullptr;
-        }
-        else if (current->parent->left == current)
-        {
-            current->parent->left = replacement;
-            replacement->parent = current->parent;
-        }
-        else
-        {
-            current->parent->right = replacement;
-            replacement->parent = current->parent;
-        }
-    }
-
-    if (balancePoint != nullptr && current->color == Node::RBColor::Black)
-        RemoveFixup(balancePoint);
-
-    delete current;
-}
-
-
-template<class T>
-void RBTree<T>::InsertFixup(Node* z)
-{
-	while(z != root && z->parent->color == Node::RBColor::Red)
-		/* Parameter z is set by the caller, and since Insert(const T& item)
-		   is the only caller, we are guaranteed it is set. There is no
-		   guarantee that z->parent is set (i.e. z is the root node), or
-		   that z->parent->parent so we check it here. */
-	{
-		if(z->parent == z->parent->parent->left) // Is our parent on the left of its grandparent?
-		{
-			Node* y = z->parent->parent->right; // z->parent->parent->right is "uncle."
-			if(y != nullptr && y->color == Node::RBColor::Red)
-			{
-				z->parent->color = Node::RBColor::Black;
-				y->color = Node::RBColor::Black;
-				z->parent->parent->color = Node::RBColor::Red;
-				z = z->parent->parent;
-			}
-			else 
-			{
-				if(z == z->parent->right) 
-				{
-					z = z->parent;
-					LeftRotate(z);
-				}
-				z->parent->color = Node::RBColor::Black;
-				z->parent->parent->color = Node::RBColor::Red;
-				RightRotate(z->parent->parent);				
-			}
-		}
-		else
-		{
-			Node* y = z->parent->parent->left; // z->parent->parent->left is "uncle."
-			if(y != nullptr && y->color == Node::RBColor::Red)
-			{
-				z->parent->color = Node::RBColor::Black;
-				y->color = Node::RBColor::Black;
-				z->parent->parent->color = Node::RBColor::Red;
-				z = z->parent->parent;
-			}
-			else 
-			{
-				if(z == z->parent->left)
-				{
-					z = z->parent;
-					RightRotate(z);
-				}	
-				z->parent->color = Node::RBColor::Black;
-				z->parent->parent->color = Node::RBColor::Red;
-				LeftRotate(z->parent->parent);				
-			}			
-		}
-	}
-	root->color = Node::RBColor::Black;
-}
-
-
-template<class T>
-void RBTree<T>::RemoveFixup(Node* x)
-{
-    while (x != root && x->color == Node::RBColor::Black)
-    {
-        if (x == x->parent->left)
-        {
-            Node* y = x->parent->right;
-            if (y->color == Node::RBColor::Red)
-            {
-                // Case 1
-                y->color = Node::RBColor::Black;
-                x->parent->color = Node::RBColor::Red;
-                LeftRotate(x->parent);
-                y = x->parent->right; // TODO: Confirm this is not a no-op because LeftRotate() changed the relationship of the nodes.
-            }
-            
-            if ((y->left == nullptr || y->left->color == Node::RBColor::Black) &&
-                (y->right == nullptr || y->right->color == Node::RBColor::Black))
-            {
-                // Case 2
-                y->color = Node::RBColor::Red;
-                x = x->parent;
-            }
-            else
-            {
-                if (y->right == nullptr || y->right->color == Node::RBColor::Black)
-                {
-                    // Case 3
-                    if (y->left != nullptr)
-                        y->left->color = Node::RBColor::Black;
-                    y->color = Node::RBColor::Red;
-                    RightRotate(y);
-                    y = x->parent->right;  // TODO: Confirm this is not a no-op because RightRotate() changed the relationship of the nodes.
-                }
-
-                // Case 4
-                y->color = x->parent->color;
-                if(x->parent->parent != nullptr)
-                    x->parent->parent->color = Node::RBColor::Black;
-                y->right->color = Node::RBColor::Black;
-                LeftRotate(x->parent);
-                root = x;
-            }
-        }
-        else
-        {
-            // left-right symmetry here
-            Node* y = x->parent->left;
-            if (y->color == Node::RBColor::Red)
-            {
-                // Case 1
-                y->color = Node::RBColor::Black;
-                x->parent->color = Node::RBColor::Red;
-                RightRotate(x->parent);
-                y = x->parent->left; // TODO: Confirm this is not a no-op because LeftRotate() changed the relationship of the nodes.
-            }
-            
-            if ((y->right == nullptr || y->right->color == Node::RBColor::Black) &&
-                (y->left == nullptr || y->left->color == Node::RBColor::Black))
-            {
-                // Case 2
-                y->color = Node::RBColor::Red;
-                x = x->parent;
-            }
-            else
-            {
-                if (y->left == nullptr || y->left->color == Node::RBColor::Black)
-                {
-                    // Case 3
-                    if (y->right != nullptr)
-                        y->right->color = Node::RBColor::Black;
-                    y->color = Node::RBColor::Red;
-                    LeftRotate(y);
-                    y = x->parent->left;  // TODO: Confirm this is not a no-op because RightRotate() changed the relationship of the nodes.
-                }
-
-                // Case 4
-                y->color = x->parent->color;
-                if (x->parent->parent != nullptr)
-                    x->parent->parent->color = Node::RBColor::Black;
-                y->left->color = Node::RBColor::Black;
-                RightRotate(x->parent);
-                root = x;
-            }
-        }
-    }
-    x->color = Node::RBColor::Black;
-}
-
-
-/*
-	x     left rotate ->     y
-	 \                      /
-	  y   <- right rotate  x
-*/
-template <class T>
-void RBTree<T>::LeftRotate(Node* x)
-{
-	Node* y = x->right;
-	x->right = y->left;
-	if(y->left != nullptr)
-		y->left->parent = x;
-	y->parent = x->parent;
-	if(x->parent == nullptr)
-	{
-		root = y;
-	}
-	else if(x == x->parent->left)
-	{
-		x->parent->left = y;
-	}
-	else
-	{
-		x->parent->right = y;
-	}
-	y->left = x;
-	x->parent = y;
-}
-
-
-/*
-	x     left rotate ->     y
-	 \                      /
-	  y   <- right rotate  x
-*/
-template <class T>
-void RBTree<T>::RightRotate(Node* x)
-{
-	Node* y = x->left;
-	x->left = y->right;
-	if(y->right != nullptr)
-		y->right->parent = x;
-	y->parent = x->parent;
-	if(x->parent == nullptr)
-	{
-		root = y;	
-	}
-	else if(x == x->parent->right)
-	{
-		x->parent->right = y;
-	}
-	else
-	{
-		x->parent->left = y;
-	}
-	y->right = x;
-	x->parent = y;
-}
-
-
-template<class T>
-RBTree<T>::Node::Node(const T& item)
-    : color(RBColor::Red), item(item), right(nullptr), left(nullptr), parent(nullptr)
-{}
-
-
-template<class T>
-bool RBTree<T>::IsValid() const
-{
-	/* 1. Every node has color red or black.
-       2. The root is always black.
-       3. Every leaf node is black (nullptr is treated as black).
-       4. If a node is red, then both its children are black.
-       5. For each node, all paths from the node to the descendant leaves contains
-          the same number of black nodes.
-    */
-
-    // #1 is definitionally true.
-
-    // Check #2, that root is black.
-    if(root != nullptr && root->color != Node::RBColor::Black)
-		return false;
-
-	// #3 is definitionally true. The leaf nodes are nullptr's and cannot be checked, but are treated as being black.
-
-	// Check #4, that all red nodes have black children.    
-    for (ConstIterator itr = begin(); itr != end(); ++itr)
-    {
-        const Node* current = itr.GetNode();
-        // Check whether the current color is red and also has any red children.
-        if (current->color == Node::RBColor::Red &&
-            ((current->left != nullptr && current->left->color == Node::RBColor::Red) ||
-            (current->right != nullptr && current->right->color == Node::RBColor::Red)
-                ))
-        {
-            return false;
-        }
-    }
-
-    // Check #5, For each node, all paths from the node to the descendant leaves contains the same number of black nodes.
-    int mainCount = -1;
-    for (typename ConstPostorder::Iterator itr = ConstPostorder(*this).begin(); itr != ConstPostorder(*this).end(); ++itr)
-    {
-        const Node* current = itr.GetNode();
-        if (current->left != nullptr || current->right != nullptr) // The below validation only occurs at leaf nodes (i.e. bottom-most nodes).
-            continue;
-
-        int blackNodeCount = 0;
-        const Node* ancestor = current;
-        while (ancestor != nullptr) // Ascend the tree counting black nodes.
-        {
-            if (ancestor->color == Node::RBColor::Black)
-                blackNodeCount++;
-            ancestor = ancestor->parent;
-        }
-        if (mainCount == -1)
-            mainCount = blackNodeCount;
-        else if (blackNodeCount != mainCount)
-            return false;     // iteration stops
-    }
-	return true;
-}
-
-
-template<class T>
-template<typename U>
-RBTree<T> RBTree<T>::Intersect(const U& other) const
-{
-    ConstIterator left = begin();
-    typename U::ConstIterator right = other.begin();
-    RBTree<T> intersectionTree;
-    while (left != end() && right != other.end())
-    {
-        if (*left == *right)
-        {
-            intersectionTree.Insert(*left);
-            ++left;
-            ++right;
-        }
-        else if (*left < *right)
-            ++left;
-        else
-            ++right;
-    }
-    return intersectionTree;
-}
-
-
-template<class T>
-RBTree<T>::ConstIterator::ConstIterator() : current(nullptr)
-{}
-
-
-template<class T>
-RBTree<T>::ConstIterator::ConstIterator(Node* current_) 
-    : current(current_)
-{
-    if (current_ == nullptr)
-        return;
-
-    while (current->left != nullptr)
-        current = current->left;
-}
-
-
-template<class T>
-RBTree<T>::ConstIterator::~ConstIterator()
-{}
-
-
-template<class T>
-typename RBTree<T>::ConstIterator& RBTree<T>::ConstIterator::operator++()
-{
-    if (current->right != nullptr)
-    {
-        current = current->right;
-        while (current->left != nullptr)
-            current = current->left;
-    }
-    else
-    {
-        while (current->parent != nullptr && current->parent->right == current)
-            current = current->parent;
-
-        current = current->parent;
-    }
-        
-    return *this;
-}
-
-
-template<class T>
-bool RBTree<T>::ConstIterator::operator!=(const ConstIterator& other) const
-{
-    return current != other.current;
-}
-
-
-template<class T>
-const T& RBTree<T>::ConstIterator::operator*() const
-{
-    return current->item;
-}
-
-
-template<class T>
-const typename RBTree<T>::Node* RBTree<T>::ConstIterator::GetNode() const
-{
-    return current;
-}
-
-
-template<class T>
-typename RBTree<T>::ConstIterator RBTree<T>::begin() const
-{
-    return ConstIterator(root);
-}
-
-
-template<class T>
-typename RBTree<T>::ConstIterator RBTree<T>::end() const
-{    
-    return ConstIterator(nullptr);
-}
-
-
-template<class T>
-RBTree<T>::ConstPostorder::ConstPostorder(const RBTree<T>& tree)
-    : _tree(tree) 
-{}
-
-template<class T>
-RBTree<T>::ConstPostorder::~ConstPostorder() {}
-
-
-template<class T>
-RBTree<T>::ConstPostorder::Iterator::Iterator()
-    : current(nullptr), next(nullptr), downwardPhase(true)
-{}
-
-
-template<class T>
-RBTree<T>::ConstPostorder::Iterator::~Iterator()
-{}
-
-
-template<class T>
-RBTree<T>::ConstPostorder::Iterator::Iterator(Node* current_)
-    : current(nullptr), next(current_), downwardPhase(true)
-{
-    if (current_ == nullptr)
-        return;
-
-    while (next->left != nullptr) // descend leftward as far as possible
-        next = next->left;
-
-    operator++();
-}
-
-
-template<class T>
-typename RBTree<T>::ConstPostorder::Iterator& RBTree<T>::ConstPostorder::Iterator::operator++()
-{
-    if (next == nullptr)        
-        current = nullptr; // We're at the end.
-
-    while (next != nullptr)
-    {
-        if (downwardPhase)
-        {
-            if (next->right != nullptr)
-            {
-                next = next->right;
-                while (next->left != nullptr)
-                    next = next->left;
-            }
-            else
-            {
-                downwardPhase = false;
-            }
-        }
-        else
-        {
-            if (next->parent != nullptr && next->parent->right == next)
-            {
-                // stay in the upward phase
-            }
-            else
-            {
-                downwardPhase = true;
-            }
-
-            // visit
-            current = next;
-            next = next->parent;
-            break;
-        }
-    }
-    return *this;
-}
-
-
-template<class T>
-bool RBTree<T>::ConstPostorder::Iterator::operator!=(const Iterator& other) const
-{
-    return !(current == other.current && next == other.next && downwardPhase == other.downwardPhase);
-}
-
-
-template<class T>
-const T& RBTree<T>::ConstPostorder::Iterator::operator*() const
-{
-    return current->item;
-}
-
-
-template<class T>
-const typename RBTree<T>::Node* RBTree<T>::ConstPostorder::Iterator::GetNode() const
-{
-    return current;
-}
-
-
-template<class T>
-typename RBTree<T>::ConstPostorder::Iterator RBTree<T>::ConstPostorder::begin() const
-{
-    return Iterator(_tree.root);
-}
-
-
-template<class T>
-typename RBTree<T>::ConstPostorder::Iterator RBTree<T>::ConstPostorder::end() const
-{
-    return Iterator(nullptr);
-}
-
-
-#if 0
-/* This is an archival reprsentation of the traversal algorithm. It is provided
-   purely as a reference for comparison with the iterator implementations. The
-   implementations should be functionally identical.
-
-   Recursion and stack are not allowed. Recursion is forbidden to preclude
-   the possibility of a stack smash, and the stack is forbidden for the sake
-   of memory efficiency. */
-template<class T>
-template<typename FunctorA, typename FunctorB>
-void RBTree<T>::ForEachNode(FunctorA sortOrderVisitor, FunctorB bottomUpVisitor) const
-{
-    Node* current = root;
-    if (current == nullptr)
-        return;
-
-    while (current->left != nullptr) // descend leftward as far as possible
-        current = current->left;
-
-    while (current != nullptr)
-    {
-        if (!sortOrderVisitor(current))
-            return;
-
-        if (current->right != nullptr) // descend rightward one step
-        {
-            current = current->right;
-            while (current->left != nullptr) // descend leftward as far as possible
-                current = current->left;
-        }
-        else
-        {
-            // ascend, skipping any previously visited nodes
-            //Node* bottomUpNode = current;
-
-            while (current->parent != nullptr && current->parent->right == current)
-            {
-                if (!bottomUpVisitor(current))
-                    return;
-                current = current->parent;
-                //if (!bottomUpVisitor(current))
-                //    return;
-                //bottomUpNode = current;
-            }
-            if (!bottomUpVisitor(current))
-                return;
-
-            current = current->parent;
-            //if (!bottomUpVisitor(bottomUpNode))
-            //    return;
-        }
-    }
-}
-#endif
-
-
-template class RBTree<int>; // To force compilation of the template, for validation.
-
-/*
-------------------------------------------------------------------------------
-This software is available under 2 licenses -- choose whichever you prefer.
-------------------------------------------------------------------------------
-ALTERNATIVE A - MIT License
-Copyright (c) 2021 Bobby G. Burrough
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-------------------------------------------------------------------------------
-ALTERNATIVE B - Public Domain (www.unlicense.org)
-This is free and unencumbered software released into the public domain.
-Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
-software, either in source code form or as a compiled binary, for any purpose,
-commercial or non-commercial, and by any means.
-In jurisdictions that recognize copyright laws, the author or authors of this
-software dedicate any and all copyright interest in the software to the public
-domain. We make this dedication for the benefit of the public at large and to
-the detriment of our heirs and successors. We intend this dedication to be an
-overt act of relinquishment in perpetuity of all present and future rights to
-this software under copyright law.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
-ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
-WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-------------------------------------------------------------------------------
-*/
-
+#ifndef _RBTREE_H_
+#define _RBTREE_H_
+
+#include <initializer_list>
+#include <type_traits>
+#include "augmentation.h"
+#include "setops.h"
+
+/*  red black tree 
+
+    Bob Burrough, 2021
+
+    Store items in a tree and retrieve them with O(log N) time complexity.
+    Does not use recursion and does not allocate extra memory (e.g. stacks
+    and queues) during iteration. The type stored in the tree must have
+    a meaningful operator==() and operator<() to facilitate storage in and
+    retrieval from the tree.
+
+    Differs from the Morris traversal edition in that each node has a pointer to
+    its parent, and the tree remains unmodified during traversal. To understand
+    which tree to select for your project:
+
+                                        Aborted    Complete          Memory
+                        Insert  Search  Traversal  Traversal         Usage
+                        ------  ------  ---------  ---------         -----
+    RBTree<T>            fast    slow     fast       fast     3 ptrs + 1 enum per node
+    RBTreeMorris<T>      slow    slow    slowest     slow             TBD
+    AVLTree<T>           fast    fast    fastest     fast     3 ptrs + 1 int per node
+    AVLTreeMorris<T>     slow    fast     slow       slow     2 ptrs + 1 int per node
+
+    Note, if you are so memory constrained that you are considering using
+    AVLTreeMorris<T>, make sure your compiler is configured for proper padding
+    and alignment to benefit from AVLTreeMorris<T>'s smaller node sizes. */
+
+template<class T, class Augmentation = NoAugmentation>
+class RBTree
+{
+public:
+	RBTree();
+	virtual ~RBTree();
+    RBTree(RBTree<T, Augmentation>&& other); // move constructor
+
+	// Retrieve item from the tree. Complexity os O(log N).
+	bool Search(const T& item) const;
+
+    /* Retrieve the stored item which is equal to the given one, or nullptr.
+       The argument may be of any type comparable with T, e.g. a key when T
+       is a Pair. Complexity is O(log N). */
+    template<typename U>
+    const T* Find(const U& item) const;
+
+	// Place an item in the tree. Complexity is O(log N).
+	void Insert(const T& item);
+
+	// Remove item from the tree. Complexity is O(log N).
+	void Remove(const T& item);
+
+    // Returns the number of items in the tree. O(1)
+    size_t Size() const;
+
+    void Clear();
+
+    /* Create the intersection of this tree with any sorted range (another
+       tree, a sorted List, an array, etc.). Complexity is O(N + M) when the
+       two are of similar size, and O(M log(N/M)) when one is much smaller.
+       For arithmetic T, similar sized inputs are compared a block at a time.
+       See SortedRange::ForEachCommonBlocked(). */
+    template<typename U>
+    RBTree<T, Augmentation> Intersect(const U& other) const;
+
+    /* Create the intersection of several trees at once, e.g.
+       IntersectAll({ &a, &b, &c }). No intermediate trees are built. The
+       smallest tree is walked, and each of the others seeks forward to the
+       current candidate. When one of them leaps past the candidate, the
+       smallest tree seeks forward to meet it. */
+    static RBTree<T, Augmentation> IntersectAll(std::initializer_list<const RBTree<T, Augmentation>*> trees);
+
+    /* Place every item of a sorted range (another tree, a sorted List, an
+       array, etc.) in the tree. The existing nodes and the new items are
+       merged into one sorted chain, which is then rebalanced in a single
+       pass, for O(N + M) rather than O(M log(N + M)). A handful of items
+       going into a large tree are inserted one at a time instead. */
+    template<typename U>
+    void InsertSorted(const U& sortedRange);
+
+    /* Create the intersection of this tree with an unsorted range, such as
+       an unsorted List. Depending on the sizes of the two, this either looks
+       up each element of other in the tree, or goes through a temporary
+       hash set. See SortedRange::ForEachCommonUnsorted(). */
+    template<typename U>
+    RBTree<T, Augmentation> IntersectUnsorted(const U& other) const;
+
+
+    /* Combine the values of every item x with lo <= x <= hi, in order,
+       using the tree's Augmentation (see augmentation.h). Only the nodes on
+       the paths to lo and hi are visited, so complexity is O(log N). */
+    template<typename U>
+    typename Augmentation::Value Aggregate(const U& lo, const U& hi) const;
+
+    // The aggregate of every item in the tree. O(1)
+    template<class A = Augmentation>
+    typename A::Value Aggregate() const;
+
+	/* Consistency check. Returns true if the red black tree
+       is internally consistent. Otherwise, false. */
+	bool IsValid() const;
+  
+protected:
+private:
+	class Node : public SubtreeAggregate<Augmentation>
+	{
+		/* This is implemented as a nested class to avoid
+		   presenting unnecessary interfaces to the calling
+		   program. Node is purely an internal storage
+		   concept of RBTree, and isn't used elsewhere.
+		*/
+	public:
+		Node(const T& item);		
+		virtual ~Node() = default;
+
+		friend class RBTree<T, Augmentation>;
+
+	protected:
+	private:
+		Node() = delete;
+		enum class RBColor { Red, Black } color;
+		T item;
+		Node* right;
+		Node* left;
+		Node* parent;
+
+        // Finger search. Returns the first node at or after from whose item is not less than the given item.
+        template<typename U> static Node* Seek(Node* from, const U& item);
+	};
+
+	Node* root;	
+    size_t size;
+
+    /* Bulk construction. Nodes are gathered in sorted order into a vine (a
+       degenerate tree linked through the right pointers), which is then
+       balanced in place with the Day-Stout-Warren algorithm. This is O(N)
+       and, like traversal, uses neither recursion nor extra memory. */
+    class Vine
+    {
+    public:
+        Vine();
+        void Append(Node* node); // Overwrites the node's links.
+        Node* head;
+        Node* tail;
+        size_t count;
+    };
+    void BuildFromVine(const Vine& vine); // The tree must be empty.
+    static Node* TreeToVine(Node* root); // Flattens the tree with right rotations. Parent pointers are left stale.
+    static void Compress(Node** link, size_t count); // Left rotates every other node of a vine, count times.
+    template<typename Visitor>
+    static void ForEachNodePostorder(Node* root, Visitor visitor); // visitor(node, depth). For bulk construction only.
+	void LeftRotate(Node* x);
+	void RightRotate(Node* x);
+	void InsertFixup(Node* z);
+    void RemoveFixup(Node* x, Node* parent);
+    void Transplant(Node* current, Node* replacement); // Puts replacement (which may be nullptr) in current's place under current's parent.
+    bool InsertNode(Node* node); // Links the node into the tree. Returns false, leaving it unlinked, if an equal item is already present.
+    void Detach(Node* node); // Unlinks the node from the tree and rebalances, without deleting it.
+    template<typename U> Node* FindNode(const U& item) const;
+
+    // Aggregate maintenance. These compile to nothing for NoAugmentation.
+    typedef std::integral_constant<bool, !std::is_same<Augmentation, NoAugmentation>::value> IsAugmented;
+    static void UpdateAggregate(Node* node) { UpdateAggregate(node, IsAugmented()); } // From the node's item and its children's aggregates.
+    template<class A = Augmentation> static void UpdateAggregate(Node* node, std::true_type);
+    static void UpdateAggregate(Node*, std::false_type) {}
+    static void UpdateAggregatesToRoot(Node* node) { UpdateAggregatesToRoot(node, IsAugmented()); } // The node and each of its ancestors.
+    template<class A = Augmentation> static void UpdateAggregatesToRoot(Node* node, std::true_type);
+    static void UpdateAggregatesToRoot(Node*, std::false_type) {}
+
+    // Node handle declarations
+public:
+    /* Owning handle to a node which has been taken out of a tree with
+       Extract(). The node can be placed in another tree of the same type
+       with Insert(NodeHandle&&), without allocating memory or copying the
+       item. If the handle still holds the node when it is destroyed, the
+       node is deleted. */
+    class NodeHandle
+    {
+    public:
+        NodeHandle(); // Creates an empty handle.
+        NodeHandle(NodeHandle&& other);
+        NodeHandle& operator=(NodeHandle&& other);
+        virtual ~NodeHandle();
+
+        bool Empty() const;
+
+        /* The item held by the handle. It may be modified, since it isn't in
+           a tree, e.g. to change the key before inserting it elsewhere. */
+        T& Item() const;
+
+        friend class RBTree<T, Augmentation>;
+
+    protected:
+    private:
+        NodeHandle(Node* node_);
+        NodeHandle(const NodeHandle&) = delete;
+        NodeHandle& operator=(const NodeHandle&) = delete;
+        Node* node;
+    };
+
+    /* Take an item out of the tree without destroying it. Returns an empty
+       handle if the tree doesn't contain the item. Complexity is O(log N). */
+    NodeHandle Extract(const T& item);
+
+    /* Place the node held by the handle in the tree. No memory is allocated
+       and the item is not copied. Returns true, and leaves the handle empty,
+       on success. If an equal item is already present, returns false, and
+       the handle keeps the node. Complexity is O(log N). */
+    bool Insert(NodeHandle&& handle);
+
+    /* Move every node of other into this tree, except for those whose items
+       are already present here, which remain in other. No memory is
+       allocated and no items are copied. Both trees are flattened, merged,
+       and rebuilt in O(N + M), or if other is small, its nodes are inserted
+       one at a time. */
+    void Merge(RBTree<T, Augmentation>& other);
+
+    // Iterator declarations
+public:
+    class ConstIterator // inorder iterator
+    {
+    public:
+        ConstIterator();
+        ConstIterator(Node* current);
+        virtual ~ConstIterator();
+        ConstIterator& operator++();
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+        /* Advance to the first item which is not less than the given item.
+           Complexity is O(log D), where D is the distance travelled. */
+        template<typename U>
+        ConstIterator& Seek(const U& item);
+
+        friend class RBTree<T, Augmentation>; // For access to GetNode() member function below.
+
+    protected:
+    private:
+        const Node* GetNode() const;
+        Node* current; // cached copy of the current visitable element
+    };
+    ConstIterator begin() const; // inorder iterator is the default when doing range-based iteration of RBTree
+    ConstIterator end() const;
+
+    // Returns an iterator to the first item which is not less than the given item. Complexity is O(log N).
+    template<typename U>
+    ConstIterator LowerBound(const U& item) const;
+
+
+    class ConstPostorder // adaptor for postorder iteration
+    {
+    public:
+        ConstPostorder(const RBTree<T, Augmentation>& tree);
+        virtual ~ConstPostorder();
+
+        class Iterator
+        {
+        public:
+            Iterator();
+            Iterator(Node* current);
+            virtual ~Iterator();
+            Iterator& operator++();
+            bool operator!=(const Iterator& other) const;
+            const T& operator*() const;
+
+            friend class RBTree<T, Augmentation>; // For access to GetNode() member function below.
+
+        protected:
+        private:
+            const Node* GetNode() const; // This is used for (eg) destruction of the tree.
+            Node* current;
+            Node* next; // So we can delete nodes during traversal, we first traverse via the next pointer and allow current to be mutated/deleted.
+            bool downwardPhase; // Whether we're in the upward phase of tree traversal, or the downward phase.
+        };
+        Iterator begin() const;
+        Iterator end() const;
+
+    protected:
+    private:
+        ConstPostorder() = delete;
+        const RBTree<T, Augmentation>& _tree;
+    };
+};
+
+
+/* A tree of key/value Pairs, ordered by key. Use Find(key) to retrieve a
+   value, and MergeJoin() and friends (setops.h) to combine maps. */
+template<class KeyType, class ValueType> class Pair;
+template<class KeyType, class ValueType>
+using RBMap = RBTree<Pair<KeyType, ValueType>>;
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::RBTree() 
+    : root(nullptr), size(0)
+{}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::~RBTree()
+{
+    for (typename ConstPostorder::Iterator itr = ConstPostorder(*this).begin(); itr != ConstPostorder(*this).end(); ++itr)
+        delete itr.GetNode();
+}
+
+
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::Clear()
+{
+    for (typename ConstPostorder::Iterator itr = ConstPostorder(*this).begin(); itr != ConstPostorder(*this).end(); ++itr)
+        delete itr.GetNode();
+    root = nullptr;
+    size = 0;
+}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::RBTree(RBTree<T, Augmentation>&& other)
+{
+    root = other.root;
+    size = other.size;
+    other.root = nullptr;
+    other.size = 0;
+}
+
+
+template<class T, class Augmentation>
+bool RBTree<T, Augmentation>::Search(const T& item) const
+{
+    Node* current(root);
+    while (current != nullptr)
+    {
+        if (current->item == item)
+            return true;
+
+        if (item < current->item)
+            current = current->left;
+        else
+            current = current->right;
+    }
+	return false;
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+const T* RBTree<T, Augmentation>::Find(const U& item) const
+{
+    Node* node = FindNode(item);
+    return node != nullptr ? &node->item : nullptr;
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+typename RBTree<T, Augmentation>::Node* RBTree<T, Augmentation>::FindNode(const U& item) const
+{
+    Node* current(root);
+    while (current != nullptr)
+    {
+        if (current->item < item)
+            current = current->right;
+        else if (item < current->item)
+            current = current->left;
+        else
+            return current;
+    }
+    return nullptr;
+}
+
+
+template<class T, class Augmentation>
+typename RBTree<T, Augmentation>::NodeHandle RBTree<T, Augmentation>::Extract(const T& item)
+{
+    Node* node = FindNode(item);
+    if (node == nullptr)
+        return NodeHandle();
+    Detach(node);
+    node->left = nullptr;
+    node->right = nullptr;
+    node->parent = nullptr;
+    return NodeHandle(node);
+}
+
+
+template<class T, class Augmentation>
+bool RBTree<T, Augmentation>::Insert(NodeHandle&& handle)
+{
+    if (handle.node == nullptr || !InsertNode(handle.node))
+        return false;
+    handle.node = nullptr;
+    return true;
+}
+
+
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::Merge(RBTree<T, Augmentation>& other)
+{
+    if (&other == this || other.root == nullptr)
+        return;
+
+    Node* incoming = TreeToVine(other.root);
+    other.root = nullptr;
+    size_t otherSize = other.size;
+    other.size = 0;
+    Vine leftover; // nodes whose items are already present
+
+    size_t depth = 1; // approximately log2 of size, the cost of an InsertNode()
+    for (size_t remaining = size; remaining > 1; remaining /= 2)
+        depth++;
+    if (otherSize * depth < size)
+    {
+        while (incoming != nullptr)
+        {
+            Node* next = incoming->right;
+            if (!InsertNode(incoming))
+                leftover.Append(incoming);
+            incoming = next;
+        }
+        other.BuildFromVine(leftover);
+        return;
+    }
+
+    Node* existing = TreeToVine(root);
+    root = nullptr;
+    size = 0;
+    Vine merged;
+    while (existing != nullptr || incoming != nullptr)
+    {
+        if (incoming != nullptr && (existing == nullptr || incoming->item < existing->item))
+        {
+            Node* next = incoming->right;
+            merged.Append(incoming);
+            incoming = next;
+        }
+        else
+        {
+            if (incoming != nullptr && incoming->item == existing->item)
+            {
+                Node* next = incoming->right;
+                leftover.Append(incoming);
+                incoming = next;
+            }
+            Node* next = existing->right;
+            merged.Append(existing);
+            existing = next;
+        }
+    }
+    BuildFromVine(merged);
+    other.BuildFromVine(leftover);
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+typename RBTree<T, Augmentation>::ConstIterator RBTree<T, Augmentation>::LowerBound(const U& item) const
+{
+    Node* current(root);
+    Node* candidate(nullptr);
+    while (current != nullptr)
+    {
+        if (current->item < item)
+            current = current->right;
+        else
+        {
+            candidate = current;
+            current = current->left;
+        }
+    }
+    ConstIterator itr;
+    itr.current = candidate;
+    return itr;
+}
+
+
+template<class T, class Augmentation>
+size_t RBTree<T, Augmentation>::Size() const
+{
+    return size;
+}
+
+
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::Insert(const T& item)
+{
+	Node* node = new Node(item);
+	if(!InsertNode(node))
+		delete node; // They're equal.
+}
+
+
+template<class T, class Augmentation>
+bool RBTree<T, Augmentation>::InsertNode(Node* node)
+{
+	Node* current(root);
+	Node* previous(nullptr);
+	while(current != nullptr)
+	{
+		previous = current;
+		if(node->item < current->item)
+			current = current->left;
+		else if(node->item > current->item)
+			current = current->right;			
+        else
+            return false; // They're equal.
+	}
+
+	size++;
+	node->color = Node::RBColor::Red;
+	node->left = nullptr;
+	node->right = nullptr;
+	node->parent = previous;
+	if(previous == nullptr)
+		root = node;
+	else if(node->item < previous->item)
+		previous->left = node;
+	else
+		previous->right = node;
+
+	UpdateAggregatesToRoot(node); // Rotations below keep the aggregates of the nodes they move.
+	InsertFixup(node);
+	return true;
+}
+
+
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::Remove(const T& item)
+{
+    Node* current = FindNode(item);
+    if (current == nullptr)
+        return; // The tree doesn't contain the specified item.
+    Detach(current);
+    delete current;
+}
+
+
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::Detach(Node* current)
+{
+    size--;
+
+    /* child takes the place of the node which is removed from its position
+       in the tree. It may be nullptr, so its parent is tracked separately. */
+    Node* child(nullptr);
+    Node* childParent(nullptr);
+    typename Node::RBColor removedColor = current->color;
+    if (current->left == nullptr)
+    {
+        child = current->right;
+        childParent = current->parent;
+        Transplant(current, current->right);
+    }
+    else if (current->right == nullptr)
+    {
+        child = current->left;
+        childParent = current->parent;
+        Transplant(current, current->left);
+    }
+    else
+    {
+        // current has both left and right children. Its successor takes its place, and its color.
+        Node* replacement = current->right;
+        while (replacement->left != nullptr)   // traverse to the minimum value in the right subtree
+            replacement = replacement->left;
+
+        removedColor = replacement->color;
+        child = replacement->right;
+        if (replacement->parent == current)
+            childParent = replacement;
+        else
+        {
+            childParent = replacement->parent;
+            Transplant(replacement, replacement->right);
+            replacement->right = current->right;
+            replacement->right->parent = replacement;
+        }
+        Transplant(current, replacement);
+        replacement->left = current->left;
+        replacement->left->parent = replacement;
+        replacement->color = current->color;
+    }
+
+    UpdateAggregatesToRoot(childParent);
+    if (removedColor == Node::RBColor::Black)
+        RemoveFixup(child, childParent);
+}
+
+
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::Transplant(Node* current, Node* replacement)
+{
+    if (current->parent == nullptr)
+        root = replacement;
+    else if (current == current->parent->left)
+        current->parent->left = replacement;
+    else
+        current->parent->right = replacement;
+    if (replacement != nullptr)
+        replacement->parent = current->parent;
+}
+
+
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::InsertFixup(Node* z)
+{
+	while(z != root && z->parent->color == Node::RBColor::Red)
+		/* Parameter z is set by the caller, and since Insert(const T& item)
+		   is the only caller, we are guaranteed it is set. There is no
+		   guarantee that z->parent is set (i.e. z is the root node), or
+		   that z->parent->parent so we check it here. */
+	{
+		if(z->parent == z->parent->parent->left) // Is our parent on the left of its grandparent?
+		{
+			Node* y = z->parent->parent->right; // z->parent->parent->right is "uncle."
+			if(y != nullptr && y->color == Node::RBColor::Red)
+			{
+				z->parent->color = Node::RBColor::Black;
+				y->color = Node::RBColor::Black;
+				z->parent->parent->color = Node::RBColor::Red;
+				z = z->parent->parent;
+			}
+			else 
+			{
+				if(z == z->parent->right) 
+				{
+					z = z->parent;
+					LeftRotate(z);
+				}
+				z->parent->color = Node::RBColor::Black;
+				z->parent->parent->color = Node::RBColor::Red;
+				RightRotate(z->parent->parent);				
+			}
+		}
+		else
+		{
+			Node* y = z->parent->parent->left; // z->parent->parent->left is "uncle."
+			if(y != nullptr && y->color == Node::RBColor::Red)
+			{
+				z->parent->color = Node::RBColor::Black;
+				y->color = Node::RBColor::Black;
+				z->parent->parent->color = Node::RBColor::Red;
+				z = z->parent->parent;
+			}
+			else 
+			{
+				if(z == z->parent->left)
+				{
+					z = z->parent;
+					RightRotate(z);
+				}	
+				z->parent->color = Node::RBColor::Black;
+				z->parent->parent->color = Node::RBColor::Red;
+				LeftRotate(z->parent->parent);				
+			}			
+		}
+	}
+	root->color = Node::RBColor::Black;
+}
+
+
+/* x carries an extra black, having taken the place of a black node which
+   was removed. x may be nullptr (an empty leaf), which is why its parent is
+   passed in separately. */
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::RemoveFixup(Node* x, Node* parent)
+{
+    while (x != root && (x == nullptr || x->color == Node::RBColor::Black))
+    {
+        if (x == parent->left)
+        {
+            Node* y = parent->right; // The sibling. It can't be nullptr, since x's side is short a black node.
+            if (y->color == Node::RBColor::Red)
+            {
+                // Case 1
+                y->color = Node::RBColor::Black;
+                parent->color = Node::RBColor::Red;
+                LeftRotate(parent);
+                y = parent->right;
+            }
+            
+            if ((y->left == nullptr || y->left->color == Node::RBColor::Black) &&
+                (y->right == nullptr || y->right->color == Node::RBColor::Black))
+            {
+                // Case 2
+                y->color = Node::RBColor::Red;
+                x = parent;
+                parent = x->parent;
+            }
+            else
+            {
+                if (y->right == nullptr || y->right->color == Node::RBColor::Black)
+                {
+                    // Case 3
+                    y->left->color = Node::RBColor::Black;
+                    y->color = Node::RBColor::Red;
+                    RightRotate(y);
+                    y = parent->right;
+                }
+
+                // Case 4
+                y->color = parent->color;
+                parent->color = Node::RBColor::Black;
+                y->right->color = Node::RBColor::Black;
+                LeftRotate(parent);
+                x = root;
+            }
+        }
+        else
+        {
+            // left-right symmetry here
+            Node* y = parent->left;
+            if (y->color == Node::RBColor::Red)
+            {
+                // Case 1
+                y->color = Node::RBColor::Black;
+                parent->color = Node::RBColor::Red;
+                RightRotate(parent);
+                y = parent->left;
+            }
+            
+            if ((y->right == nullptr || y->right->color == Node::RBColor::Black) &&
+                (y->left == nullptr || y->left->color == Node::RBColor::Black))
+            {
+                // Case 2
+                y->color = Node::RBColor::Red;
+                x = parent;
+                parent = x->parent;
+            }
+            else
+            {
+                if (y->left == nullptr || y->left->color == Node::RBColor::Black)
+                {
+                    // Case 3
+                    y->right->color = Node::RBColor::Black;
+                    y->color = Node::RBColor::Red;
+                    LeftRotate(y);
+                    y = parent->left;
+                }
+
+                // Case 4
+                y->color = parent->color;
+                parent->color = Node::RBColor::Black;
+                y->left->color = Node::RBColor::Black;
+                RightRotate(parent);
+                x = root;
+            }
+        }
+    }
+    if (x != nullptr)
+        x->color = Node::RBColor::Black;
+}
+
+
+/*
+	x     left rotate ->     y
+	 \                      /
+	  y   <- right rotate  x
+*/
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::LeftRotate(Node* x)
+{
+	Node* y = x->right;
+	x->right = y->left;
+	if(y->left != nullptr)
+		y->left->parent = x;
+	y->parent = x->parent;
+	if(x->parent == nullptr)
+	{
+		root = y;
+	}
+	else if(x == x->parent->left)
+	{
+		x->parent->left = y;
+	}
+	else
+	{
+		x->parent->right = y;
+	}
+	y->left = x;
+	x->parent = y;
+	UpdateAggregate(x);
+	UpdateAggregate(y);
+}
+
+
+/*
+	x     left rotate ->     y
+	 \                      /
+	  y   <- right rotate  x
+*/
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::RightRotate(Node* x)
+{
+	Node* y = x->left;
+	x->left = y->right;
+	if(y->right != nullptr)
+		y->right->parent = x;
+	y->parent = x->parent;
+	if(x->parent == nullptr)
+	{
+		root = y;	
+	}
+	else if(x == x->parent->right)
+	{
+		x->parent->right = y;
+	}
+	else
+	{
+		x->parent->left = y;
+	}
+	y->right = x;
+	x->parent = y;
+	UpdateAggregate(x);
+	UpdateAggregate(y);
+}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::Node::Node(const T& item)
+    : color(RBColor::Red), item(item), right(nullptr), left(nullptr), parent(nullptr)
+{}
+
+
+/* Rather than starting over from the root, climb only as far as is needed
+   to bracket the item, then descend. Walking forward through a tree this
+   way costs O(log D) per call, where D is the distance travelled. */
+template<class T, class Augmentation>
+template<typename U>
+typename RBTree<T, Augmentation>::Node* RBTree<T, Augmentation>::Node::Seek(Node* from, const U& item)
+{
+    if (from == nullptr || !(from->item < item))
+        return from;
+
+    Node* current = from; // current->item < item
+    while (1)
+    {
+        // Find the nearest ancestor which follows current in order.
+        Node* successor = current;
+        while (successor->parent != nullptr && successor->parent->right == successor)
+            successor = successor->parent;
+        successor = successor->parent;
+
+        if (successor == nullptr || !(successor->item < item))
+        {
+            // The item lies within current's right subtree, or else it's the successor.
+            Node* candidate = successor;
+            Node* descendant = current->right;
+            while (descendant != nullptr)
+            {
+                if (descendant->item < item)
+                    descendant = descendant->right;
+                else
+                {
+                    candidate = descendant;
+                    descendant = descendant->left;
+                }
+            }
+            return candidate;
+        }
+
+        // Everything in current's right subtree precedes the successor, so skip all of it.
+        current = successor;
+    }
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+typename Augmentation::Value RBTree<T, Augmentation>::Aggregate(const U& lo, const U& hi) const
+{
+    // Find the topmost node in the range, where the paths to lo and hi split.
+    Node* split(root);
+    while (split != nullptr && (split->item < lo || hi < split->item))
+        split = split->item < lo ? split->right : split->left;
+    if (split == nullptr)
+        return Augmentation::Identity();
+
+    /* Follow the path to lo. Wherever it goes left, the node and its right
+       subtree are in range, and follow everything collected further down. */
+    typename Augmentation::Value lower = Augmentation::Identity();
+    for (Node* current = split->left; current != nullptr;)
+    {
+        if (current->item < lo)
+            current = current->right;
+        else
+        {
+            typename Augmentation::Value above = Augmentation::Lift(current->item);
+            if (current->right != nullptr)
+                above = Augmentation::Combine(above, current->right->aggregate);
+            lower = Augmentation::Combine(above, lower);
+            current = current->left;
+        }
+    }
+
+    // Likewise for hi, mirrored.
+    typename Augmentation::Value upper = Augmentation::Identity();
+    for (Node* current = split->right; current != nullptr;)
+    {
+        if (hi < current->item)
+            current = current->left;
+        else
+        {
+            typename Augmentation::Value below = Augmentation::Lift(current->item);
+            if (current->left != nullptr)
+                below = Augmentation::Combine(current->left->aggregate, below);
+            upper = Augmentation::Combine(upper, below);
+            current = current->right;
+        }
+    }
+
+    return Augmentation::Combine(Augmentation::Combine(lower, Augmentation::Lift(split->item)), upper);
+}
+
+
+template<class T, class Augmentation>
+template<class A>
+typename A::Value RBTree<T, Augmentation>::Aggregate() const
+{
+    return root != nullptr ? root->aggregate : Augmentation::Identity();
+}
+
+
+template<class T, class Augmentation>
+template<class A>
+void RBTree<T, Augmentation>::UpdateAggregate(Node* node, std::true_type)
+{
+    typename Augmentation::Value aggregate = Augmentation::Lift(node->item);
+    if (node->left != nullptr)
+        aggregate = Augmentation::Combine(node->left->aggregate, aggregate);
+    if (node->right != nullptr)
+        aggregate = Augmentation::Combine(aggregate, node->right->aggregate);
+    node->aggregate = aggregate;
+}
+
+
+template<class T, class Augmentation>
+template<class A>
+void RBTree<T, Augmentation>::UpdateAggregatesToRoot(Node* node, std::true_type)
+{
+    for (; node != nullptr; node = node->parent)
+        UpdateAggregate(node, std::true_type());
+}
+
+
+template<class T, class Augmentation>
+bool RBTree<T, Augmentation>::IsValid() const
+{
+	/* 1. Every node has color red or black.
+       2. The root is always black.
+       3. Every leaf node is black (nullptr is treated as black).
+       4. If a node is red, then both its children are black.
+       5. For each node, all paths from the node to the descendant leaves contains
+          the same number of black nodes.
+    */
+
+    // Check that the recorded size matches the number of nodes, and that each child points back to its parent.
+    size_t nodeCount = 0;
+    for (ConstIterator itr = begin(); itr != end(); ++itr)
+    {
+        nodeCount++;
+        const Node* n = itr.GetNode();
+        if ((n->left != nullptr && n->left->parent != n) || (n->right != nullptr && n->right->parent != n))
+            return false;
+    }
+    if (nodeCount != size)
+        return false;
+
+    // #1 is definitionally true.
+
+    // Check #2, that root is black.
+    if(root != nullptr && root->color != Node::RBColor::Black)
+		return false;
+
+	// #3 is definitionally true. The leaf nodes are nullptr's and cannot be checked, but are treated as being black.
+
+	// Check #4, that all red nodes have black children.    
+    for (ConstIterator itr = begin(); itr != end(); ++itr)
+    {
+        const Node* current = itr.GetNode();
+        // Check whether the current color is red and also has any red children.
+        if (current->color == Node::RBColor::Red &&
+            ((current->left != nullptr && current->left->color == Node::RBColor::Red) ||
+            (current->right != nullptr && current->right->color == Node::RBColor::Red)
+                ))
+        {
+            return false;
+        }
+    }
+
+    // Check #5, For each node, all paths from the node to the descendant leaves contains the same number of black nodes.
+    int mainCount = -1;
+    for (typename ConstPostorder::Iterator itr = ConstPostorder(*this).begin(); itr != ConstPostorder(*this).end(); ++itr)
+    {
+        const Node* current = itr.GetNode();
+        if (current->left != nullptr || current->right != nullptr) // The below validation only occurs at leaf nodes (i.e. bottom-most nodes).
+            continue;
+
+        int blackNodeCount = 0;
+        const Node* ancestor = current;
+        while (ancestor != nullptr) // Ascend the tree counting black nodes.
+        {
+            if (ancestor->color == Node::RBColor::Black)
+                blackNodeCount++;
+            ancestor = ancestor->parent;
+        }
+        if (mainCount == -1)
+            mainCount = blackNodeCount;
+        else if (blackNodeCount != mainCount)
+            return false;     // iteration stops
+    }
+	return true;
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+RBTree<T, Augmentation> RBTree<T, Augmentation>::Intersect(const U& other) const
+{
+    RBTree<T, Augmentation> intersectionTree;
+    Vine vine;
+    SortedRange::ForEachCommonBlocked(*this, other, [&vine](const T& item)
+    {
+        vine.Append(new Node(item));
+        return true;
+    });
+    intersectionTree.BuildFromVine(vine);
+    return intersectionTree;
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+RBTree<T, Augmentation> RBTree<T, Augmentation>::IntersectUnsorted(const U& other) const
+{
+    RBTree<T, Augmentation> intersectionTree;
+    Vine vine;
+    SortedRange::ForEachCommonUnsorted(*this, other, [&vine](const T& item)
+    {
+        vine.Append(new Node(item));
+        return true;
+    });
+    intersectionTree.BuildFromVine(vine);
+    return intersectionTree;
+}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation> RBTree<T, Augmentation>::IntersectAll(std::initializer_list<const RBTree<T, Augmentation>*> trees)
+{
+    RBTree<T, Augmentation> intersectionTree;
+    size_t count = trees.size();
+    if (count == 0)
+        return intersectionTree;
+
+    // Order the trees from smallest to largest. There are only a handful, so insertion sort is fine.
+    const RBTree<T, Augmentation>** sorted = new const RBTree<T, Augmentation>*[count];
+    Node** cursors = new Node*[count];
+    size_t sortedCount = 0;
+    for (const RBTree<T, Augmentation>* tree : trees)
+    {
+        size_t i = sortedCount++;
+        while (i > 0 && tree->size < sorted[i - 1]->size)
+        {
+            sorted[i] = sorted[i - 1];
+            i--;
+        }
+        sorted[i] = tree;
+    }
+
+    Vine vine;
+    bool exhausted = false;
+    for (size_t i = 0; i < count; i++)
+    {
+        cursors[i] = sorted[i]->begin().current;
+        if (cursors[i] == nullptr)
+            exhausted = true;
+    }
+
+    while (!exhausted)
+    {
+        const T& candidate = cursors[0]->item;
+        size_t i = 1;
+        for (; i < count; i++)
+        {
+            cursors[i] = Node::Seek(cursors[i], candidate);
+            if (cursors[i] == nullptr)
+                exhausted = true;
+            if (exhausted || candidate < cursors[i]->item)
+                break; // leapt past the candidate, so it can't be in the intersection
+        }
+        if (exhausted)
+            break;
+
+        if (i == count)
+        {
+            // Every tree contains the candidate.
+            vine.Append(new Node(candidate));
+            ConstIterator next;
+            next.current = cursors[0];
+            ++next;
+            cursors[0] = next.current;
+        }
+        else
+            cursors[0] = Node::Seek(cursors[0], cursors[i]->item);
+
+        exhausted = cursors[0] == nullptr;
+    }
+
+    delete[] cursors;
+    delete[] sorted;
+    intersectionTree.BuildFromVine(vine);
+    return intersectionTree;
+}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::Vine::Vine()
+    : head(nullptr), tail(nullptr), count(0)
+{}
+
+
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::Vine::Append(Node* node)
+{
+    node->left = nullptr;
+    node->right = nullptr;
+    node->parent = tail;
+    if (tail != nullptr)
+        tail->right = node;
+    else
+        head = node;
+    tail = node;
+    count++;
+}
+
+
+template<class T, class Augmentation>
+typename RBTree<T, Augmentation>::Node* RBTree<T, Augmentation>::TreeToVine(Node* root)
+{
+    Node* head = root;
+    Node** link = &head;
+    while (*link != nullptr)
+    {
+        Node* node = *link;
+        if (node->left != nullptr)
+        {
+            // Rotate right, lifting the left child into the vine.
+            Node* left = node->left;
+            node->left = left->right;
+            left->right = node;
+            *link = left;
+        }
+        else
+            link = &node->right;
+    }
+    return head;
+}
+
+
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::Compress(Node** link, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        Node* child = *link;
+        Node* grandchild = child->right;
+        *link = grandchild;
+        grandchild->parent = child->parent;
+        child->right = grandchild->left;
+        if (child->right != nullptr)
+            child->right->parent = child;
+        grandchild->left = child;
+        child->parent = grandchild;
+        link = &grandchild->right;
+    }
+}
+
+
+template<class T, class Augmentation>
+template<typename Visitor>
+void RBTree<T, Augmentation>::ForEachNodePostorder(Node* root, Visitor visitor)
+{
+    if (root == nullptr)
+        return;
+
+    Node* current = root;
+    size_t depth = 0;
+    while (current->left != nullptr || current->right != nullptr) // descend to the first node in postorder
+    {
+        current = current->left != nullptr ? current->left : current->right;
+        depth++;
+    }
+
+    while (1)
+    {
+        visitor(current, depth);
+        if (current == root)
+            break;
+
+        Node* parent = current->parent;
+        if (parent->left == current && parent->right != nullptr)
+        {
+            current = parent->right;
+            while (current->left != nullptr || current->right != nullptr)
+            {
+                current = current->left != nullptr ? current->left : current->right;
+                depth++;
+            }
+        }
+        else
+        {
+            current = parent;
+            depth--;
+        }
+    }
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+void RBTree<T, Augmentation>::InsertSorted(const U& sortedRange)
+{
+    size_t rangeSize = SortedRange::Size(sortedRange);
+    if (rangeSize == 0)
+        return;
+    if (rangeSize != SortedRange::UnknownSize)
+    {
+        size_t depth = 1; // approximately log2 of size, the cost of an Insert()
+        for (size_t remaining = size; remaining > 1; remaining /= 2)
+            depth++;
+        if (rangeSize * depth < size)
+        {
+            for (SortedRangeIterator<U> itr = SortedRange::Begin(sortedRange); itr != SortedRange::End(sortedRange); ++itr)
+                Insert(*itr);
+            return;
+        }
+    }
+
+    Node* existing = TreeToVine(root);
+    root = nullptr;
+    size = 0;
+    Vine merged;
+    SortedRangeIterator<U> itr = SortedRange::Begin(sortedRange);
+    SortedRangeIterator<U> end = SortedRange::End(sortedRange);
+    while (existing != nullptr || itr != end)
+    {
+        if (itr != end && (existing == nullptr || *itr < existing->item))
+        {
+            if (merged.tail == nullptr || merged.tail->item < *itr) // skips duplicates
+                merged.Append(new Node(*itr));
+            ++itr;
+        }
+        else
+        {
+            if (itr != end && *itr == existing->item)
+                ++itr; // already in the tree
+            Node* next = existing->right;
+            merged.Append(existing);
+            existing = next;
+        }
+    }
+    BuildFromVine(merged);
+}
+
+
+template<class T, class Augmentation>
+void RBTree<T, Augmentation>::BuildFromVine(const Vine& vine)
+{
+    root = vine.head;
+    size = vine.count;
+    if (root == nullptr)
+        return;
+
+    /* The first pass of rotations moves the nodes which don't fit in a
+       perfect tree down to the bottom level. Each pass after that halves
+       the length of the vine. */
+    size_t perfect = 1; // largest 2^k - 1 which doesn't exceed size
+    size_t perfectHeight = 1;
+    while (perfect * 2 + 1 <= size)
+    {
+        perfect = perfect * 2 + 1;
+        perfectHeight++;
+    }
+    Compress(&root, size - perfect);
+    for (size_t count = perfect / 2; count > 0; count /= 2)
+        Compress(&root, count);
+
+    /* Every level of the perfect tree is black. Any nodes hanging below it
+       on a partial bottom level are red. Each path from the root then has
+       the same number of black nodes, and no red node has a red child. */
+    ForEachNodePostorder(root, [perfectHeight](Node* node, size_t depth)
+    {
+        node->color = depth < perfectHeight ? Node::RBColor::Black : Node::RBColor::Red;
+        UpdateAggregate(node);
+    });
+}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::NodeHandle::NodeHandle()
+    : node(nullptr)
+{}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::NodeHandle::NodeHandle(Node* node_)
+    : node(node_)
+{}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::NodeHandle::NodeHandle(NodeHandle&& other)
+    : node(other.node)
+{
+    other.node = nullptr;
+}
+
+
+template<class T, class Augmentation>
+typename RBTree<T, Augmentation>::NodeHandle& RBTree<T, Augmentation>::NodeHandle::operator=(NodeHandle&& other)
+{
+    if (this != &other)
+    {
+        delete node;
+        node = other.node;
+        other.node = nullptr;
+    }
+    return *this;
+}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::NodeHandle::~NodeHandle()
+{
+    delete node;
+}
+
+
+template<class T, class Augmentation>
+bool RBTree<T, Augmentation>::NodeHandle::Empty() const
+{
+    return node == nullptr;
+}
+
+
+template<class T, class Augmentation>
+T& RBTree<T, Augmentation>::NodeHandle::Item() const
+{
+    return node->item;
+}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::ConstIterator::ConstIterator() : current(nullptr)
+{}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::ConstIterator::ConstIterator(Node* current_) 
+    : current(current_)
+{
+    if (current_ == nullptr)
+        return;
+
+    while (current->left != nullptr)
+        current = current->left;
+}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::ConstIterator::~ConstIterator()
+{}
+
+
+template<class T, class Augmentation>
+typename RBTree<T, Augmentation>::ConstIterator& RBTree<T, Augmentation>::ConstIterator::operator++()
+{
+    if (current->right != nullptr)
+    {
+        current = current->right;
+        while (current->left != nullptr)
+            current = current->left;
+    }
+    else
+    {
+        while (current->parent != nullptr && current->parent->right == current)
+            current = current->parent;
+
+        current = current->parent;
+    }
+        
+    return *this;
+}
+
+
+template<class T, class Augmentation>
+bool RBTree<T, Augmentation>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return current != other.current;
+}
+
+
+template<class T, class Augmentation>
+const T& RBTree<T, Augmentation>::ConstIterator::operator*() const
+{
+    return current->item;
+}
+
+
+template<class T, class Augmentation>
+template<typename U>
+typename RBTree<T, Augmentation>::ConstIterator& RBTree<T, Augmentation>::ConstIterator::Seek(const U& item)
+{
+    current = Node::Seek(current, item);
+    return *this;
+}
+
+
+template<class T, class Augmentation>
+const typename RBTree<T, Augmentation>::Node* RBTree<T, Augmentation>::ConstIterator::GetNode() const
+{
+    return current;
+}
+
+
+template<class T, class Augmentation>
+typename RBTree<T, Augmentation>::ConstIterator RBTree<T, Augmentation>::begin() const
+{
+    return ConstIterator(root);
+}
+
+
+template<class T, class Augmentation>
+typename RBTree<T, Augmentation>::ConstIterator RBTree<T, Augmentation>::end() const
+{    
+    return ConstIterator(nullptr);
+}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::ConstPostorder::ConstPostorder(const RBTree<T, Augmentation>& tree)
+    : _tree(tree) 
+{}
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::ConstPostorder::~ConstPostorder() {}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::ConstPostorder::Iterator::Iterator()
+    : current(nullptr), next(nullptr), downwardPhase(true)
+{}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::ConstPostorder::Iterator::~Iterator()
+{}
+
+
+template<class T, class Augmentation>
+RBTree<T, Augmentation>::ConstPostorder::Iterator::Iterator(Node* current_)
+    : current(nullptr), next(current_), downwardPhase(true)
+{
+    if (current_ == nullptr)
+        return;
+
+    while (next->left != nullptr) // descend leftward as far as possible
+        next = next->left;
+
+    operator++();
+}
+
+
+template<class T, class Augmentation>
+typename RBTree<T, Augmentation>::ConstPostorder::Iterator& RBTree<T, Augmentation>::ConstPostorder::Iterator::operator++()
+{
+    if (next == nullptr)        
+        current = nullptr; // We're at the end.
+
+    while (next != nullptr)
+    {
+        if (downwardPhase)
+        {
+            if (next->right != nullptr)
+            {
+                next = next->right;
+                while (next->left != nullptr)
+                    next = next->left;
+            }
+            else
+            {
+                downwardPhase = false;
+            }
+        }
+        else
+        {
+            if (next->parent != nullptr && next->parent->right == next)
+            {
+                // stay in the upward phase
+            }
+            else
+            {
+                downwardPhase = true;
+            }
+
+            // visit
+            current = next;
+            next = next->parent;
+            break;
+        }
+    }
+    return *this;
+}
+
+
+template<class T, class Augmentation>
+bool RBTree<T, Augmentation>::ConstPostorder::Iterator::operator!=(const Iterator& other) const
+{
+    return !(current == other.current && next == other.next && downwardPhase == other.downwardPhase);
+}
+
+
+template<class T, class Augmentation>
+const T& RBTree<T, Augmentation>::ConstPostorder::Iterator::operator*() const
+{
+    return current->item;
+}
+
+
+template<class T, class Augmentation>
+const typename RBTree<T, Augmentation>::Node* RBTree<T, Augmentation>::ConstPostorder::Iterator::GetNode() const
+{
+    return current;
+}
+
+
+template<class T, class Augmentation>
+typename RBTree<T, Augmentation>::ConstPostorder::Iterator RBTree<T, Augmentation>::ConstPostorder::begin() const
+{
+    return Iterator(_tree.root);
+}
+
+
+template<class T, class Augmentation>
+typename RBTree<T, Augmentation>::ConstPostorder::Iterator RBTree<T, Augmentation>::ConstPostorder::end() const
+{
+    return Iterator(nullptr);
+}
+
+
+#if 0
+/* This is an archival reprsentation of the traversal algorithm. It is provided
+   purely as a reference for comparison with the iterator implementations. The
+   implementations should be functionally identical.
+
+   Recursion and stack are not allowed. Recursion is forbidden to preclude
+   the possibility of a stack smash, and the stack is forbidden for the sake
+   of memory efficiency. */
+template<class T, class Augmentation>
+template<typename FunctorA, typename FunctorB>
+void RBTree<T, Augmentation>::ForEachNode(FunctorA sortOrderVisitor, FunctorB bottomUpVisitor) const
+{
+    Node* current = root;
+    if (current == nullptr)
+        return;
+
+    while (current->left != nullptr) // descend leftward as far as possible
+        current = current->left;
+
+    while (current != nullptr)
+    {
+        if (!sortOrderVisitor(current))
+            return;
+
+        if (current->right != nullptr) // descend rightward one step
+        {
+            current = current->right;
+            while (current->left != nullptr) // descend leftward as far as possible
+                current = current->left;
+        }
+        else
+        {
+            // ascend, skipping any previously visited nodes
+            //Node* bottomUpNode = current;
+
+            while (current->parent != nullptr && current->parent->right == current)
+            {
+                if (!bottomUpVisitor(current))
+                    return;
+                current = current->parent;
+                //if (!bottomUpVisitor(current))
+                //    return;
+                //bottomUpNode = current;
+            }
+            if (!bottomUpVisitor(current))
+                return;
+
+            current = current->parent;
+            //if (!bottomUpVisitor(bottomUpNode))
+            //    return;
+        }
+    }
+}
+#endif
+
+
+template class RBTree<int>; // To force compilation of the template, for validation.
+template class RBTree<int, SumAugmentation<int>>;
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
 #endif
\ No newline at end of file
@@ -0,0 +1,1066 @@
+#ifndef _ROARINGSET_H_
+#define _ROARINGSET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "setops.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROARINGSET_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/* RoaringSet
+
+   Bob Burrough, 2021
+
+   A compressed set of 32-bit integers, after Roaring bitmaps (Chambi,
+   Lemire, Kaser et al.). Values are grouped by their high 16 bits, and
+   each group of low 16 bits is stored in whichever of three containers is
+   smallest for it:
+
+   - Array: a sorted array of up to 4096 values, 2 bytes each.
+   - Bitmap: 65536 bits, 8KB, for groups of more than 4096 values.
+   - Run: sorted runs of consecutive values, 4 bytes per run. Optimize()
+     converts containers to runs where that's smaller.
+
+   Intersect(), Union() and Difference() work container by container:
+   bitmaps a word at a time (two words at a time with SSE2), arrays by
+   merging. A set of a million dense values takes about 128KB, and
+   intersecting two takes a few thousand word operations.
+
+   RoaringSet<T> accepts any 32-bit integral T; signed values are biased so
+   that iteration is in ascending order of T. The iterators make it a
+   sorted range, so the trees' Intersect() and InsertSorted() accept it, and
+   RoaringSet::InsertSorted() accepts a tree. */
+
+template<class T = uint32_t>
+class RoaringSet
+{
+    static_assert(std::is_integral<T>::value && sizeof(T) == 4, "RoaringSet holds 32-bit integers.");
+
+public:
+    RoaringSet();
+
+    // Place an item in the set. O(log C + 4096) worst case for C containers, usually O(log C).
+    void Insert(T item);
+
+    // Remove item from the set.
+    void Remove(T item);
+
+    // Retrieve item from the set. O(log C + log 4096)
+    bool Search(T item) const;
+
+    // Returns the number of items in the set. O(1)
+    size_t Size() const;
+
+    void Clear();
+
+    // Insert every item of a range sorted in ascending order, e.g. a tree. Appends in O(1) per item.
+    template<typename U>
+    void InsertSorted(const U& sortedRange);
+
+    RoaringSet<T> Intersect(const RoaringSet<T>& other) const;
+    RoaringSet<T> Union(const RoaringSet<T>& other) const;
+    RoaringSet<T> Difference(const RoaringSet<T>& other) const; // Items of this set which aren't in other.
+
+    // Convert containers to runs wherever that takes less memory.
+    void Optimize();
+
+    // Bytes used by the containers' contents, for comparing representations.
+    size_t ContentBytes() const;
+
+    /* Consistency check. Returns true if the set
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+protected:
+private:
+    static const uint32_t Bias = std::is_signed<T>::value ? 0x80000000u : 0; // Maps T's order onto unsigned order.
+    static const size_t ArrayMaximum = 4096; // An array of more values takes more memory than a bitmap.
+    static const size_t BitmapWords = 1024;
+
+    enum class Kind { Array, Bitmap, Run };
+
+    class Container
+    {
+    public:
+        Container(uint16_t key_);
+
+        bool Contains(uint16_t low) const;
+        bool Add(uint16_t low); // Returns false if already present.
+        bool Erase(uint16_t low); // Returns false if absent.
+
+        void ToBitmap();
+        void ToArrayOrBitmap(); // Normalizes a run container, or a bitmap with too few values.
+        std::vector<uint64_t> BitmapWordsOf() const; // The contents as a bitmap, whatever the kind.
+        size_t FindRun(uint32_t low) const; // Run: position in values of the first run which ends at or after low. O(log runs)
+        size_t RunCount() const; // Number of runs the contents would take.
+        void ToRuns();
+        size_t ContentBytes() const;
+        bool IsValid() const;
+
+        uint16_t key; // The high 16 bits shared by every value in the container.
+        Kind kind;
+        uint32_t cardinality;
+        std::vector<uint16_t> values; // Array: sorted values. Run: (start, length - 1) pairs.
+        std::vector<uint64_t> words; // Bitmap: BitmapWords words.
+    };
+
+    static uint32_t Encode(T item) { return static_cast<uint32_t>(item) ^ Bias; }
+    static T Decode(uint32_t value) { return static_cast<T>(value ^ Bias); }
+    static int CountTrailingZeros(uint64_t word);
+    static uint32_t PopCount(uint64_t word);
+
+    enum class Operation { And, Or, AndNot };
+    static void Combine(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, Operation operation);
+    static bool CombineContainers(const Container& lhs, const Container& rhs, Operation operation, Container& result);
+
+    size_t FindContainer(uint16_t key) const; // Index of the first container whose key is not less than key.
+    Container& ContainerFor(uint16_t key); // Finds or creates the container for key.
+
+    std::vector<Container> containers; // Sorted by key.
+    size_t size;
+
+    // Iterator declarations
+public:
+    class ConstIterator
+    {
+    public:
+        ConstIterator(const RoaringSet<T>& set_, size_t container_); // Positioned at the first value of the container.
+        ConstIterator& operator++();
+        bool operator==(const ConstIterator& other) const;
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+        // Advance to the first item which is not less than the given item. O(log C + log 4096)
+        ConstIterator& Seek(T item);
+
+    protected:
+    private:
+        void SettleAt(uint32_t low); // Moves to the first value not less than low in the current container, or on to the next container.
+        void Load(); // Sets current from the position.
+
+        const RoaringSet<T>* set;
+        size_t container;
+        size_t index; // Array: value index. Run: run index.
+        uint32_t low; // Bitmap and run: the current low 16 bits.
+        T current;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+
+template<class T>
+RoaringSet<T>::RoaringSet()
+    : size(0)
+{}
+
+
+template<class T>
+void RoaringSet<T>::Insert(T item)
+{
+    uint32_t value = Encode(item);
+    if (ContainerFor(static_cast<uint16_t>(value >> 16)).Add(static_cast<uint16_t>(value)))
+        size++;
+}
+
+
+template<class T>
+void RoaringSet<T>::Remove(T item)
+{
+    uint32_t value = Encode(item);
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    size_t index = FindContainer(key);
+    if (index == containers.size() || containers[index].key != key)
+        return; // The set doesn't contain the specified item.
+    if (!containers[index].Erase(static_cast<uint16_t>(value)))
+        return;
+    size--;
+    if (containers[index].cardinality == 0)
+        containers.erase(containers.begin() + index);
+}
+
+
+template<class T>
+bool RoaringSet<T>::Search(T item) const
+{
+    uint32_t value = Encode(item);
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    size_t index = FindContainer(key);
+    return index < containers.size() && containers[index].key == key && containers[index].Contains(static_cast<uint16_t>(value));
+}
+
+
+template<class T>
+size_t RoaringSet<T>::Size() const
+{
+    return size;
+}
+
+
+template<class T>
+void RoaringSet<T>::Clear()
+{
+    containers.clear();
+    size = 0;
+}
+
+
+template<class T>
+template<typename U>
+void RoaringSet<T>::InsertSorted(const U& sortedRange)
+{
+    // In ascending order, every item lands in the last container, usually at its end.
+    for (SortedRangeIterator<U> itr = SortedRange::Begin(sortedRange); itr != SortedRange::End(sortedRange); ++itr)
+        Insert(static_cast<T>(*itr));
+}
+
+
+template<class T>
+size_t RoaringSet<T>::FindContainer(uint16_t key) const
+{
+    size_t first = 0;
+    size_t count = containers.size();
+    while (count > 0)
+    {
+        size_t half = count / 2;
+        if (containers[first + half].key < key)
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+    return first;
+}
+
+
+template<class T>
+typename RoaringSet<T>::Container& RoaringSet<T>::ContainerFor(uint16_t key)
+{
+    if (!containers.empty() && containers.back().key == key)
+        return containers.back(); // The common case when inserting in order.
+    size_t index = containers.empty() || containers.back().key < key ? containers.size() : FindContainer(key);
+    if (index == containers.size() || containers[index].key != key)
+        containers.insert(containers.begin() + index, Container(key));
+    return containers[index];
+}
+
+
+template<class T>
+RoaringSet<T> RoaringSet<T>::Intersect(const RoaringSet<T>& other) const
+{
+    RoaringSet<T> result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() && j < other.containers.size())
+    {
+        if (containers[i].key < other.containers[j].key)
+            i++;
+        else if (other.containers[j].key < containers[i].key)
+            j++;
+        else
+        {
+            Container combined(containers[i].key);
+            if (CombineContainers(containers[i], other.containers[j], Operation::And, combined))
+            {
+                result.size += combined.cardinality;
+                result.containers.push_back(std::move(combined));
+            }
+            i++;
+            j++;
+        }
+    }
+    return result;
+}
+
+
+template<class T>
+RoaringSet<T> RoaringSet<T>::Union(const RoaringSet<T>& other) const
+{
+    RoaringSet<T> result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() || j < other.containers.size())
+    {
+        if (j == other.containers.size() || (i < containers.size() && containers[i].key < other.containers[j].key))
+            result.containers.push_back(containers[i++]);
+        else if (i == containers.size() || other.containers[j].key < containers[i].key)
+            result.containers.push_back(other.containers[j++]);
+        else
+        {
+            Container combined(containers[i].key);
+            CombineContainers(containers[i], other.containers[j], Operation::Or, combined);
+            result.containers.push_back(std::move(combined));
+            i++;
+            j++;
+        }
+        result.size += result.containers.back().cardinality;
+    }
+    return result;
+}
+
+
+template<class T>
+RoaringSet<T> RoaringSet<T>::Difference(const RoaringSet<T>& other) const
+{
+    RoaringSet<T> result;
+    size_t j = 0;
+    for (size_t i = 0; i < containers.size(); i++)
+    {
+        while (j < other.containers.size() && other.containers[j].key < containers[i].key)
+            j++;
+        if (j == other.containers.size() || containers[i].key < other.containers[j].key)
+        {
+            result.containers.push_back(containers[i]);
+            result.size += containers[i].cardinality;
+            continue;
+        }
+        Container combined(containers[i].key);
+        if (CombineContainers(containers[i], other.containers[j], Operation::AndNot, combined))
+        {
+            result.size += combined.cardinality;
+            result.containers.push_back(std::move(combined));
+        }
+    }
+    return result;
+}
+
+
+/* Combine two containers with the same key into result. Returns false if
+   the result is empty. Two arrays are merged directly; an array is
+   intersected with a bitmap by testing its values. Anything else is done
+   on bitmaps, a word at a time, and the result converted back to an array
+   if it's small enough. */
+template<class T>
+bool RoaringSet<T>::CombineContainers(const Container& lhs, const Container& rhs, Operation operation, Container& result)
+{
+    if (lhs.kind == Kind::Array && rhs.kind == Kind::Array)
+    {
+        const std::vector<uint16_t>& a = lhs.values;
+        const std::vector<uint16_t>& b = rhs.values;
+        std::vector<uint16_t>& out = result.values;
+        size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size())
+        {
+            if (a[i] < b[j])
+            {
+                if (operation != Operation::And)
+                    out.push_back(a[i]);
+                i++;
+            }
+            else if (b[j] < a[i])
+            {
+                if (operation == Operation::Or)
+                    out.push_back(b[j]);
+                j++;
+            }
+            else
+            {
+                if (operation != Operation::AndNot)
+                    out.push_back(a[i]);
+                i++;
+                j++;
+            }
+        }
+        if (operation != Operation::And)
+            out.insert(out.end(), a.begin() + i, a.end());
+        if (operation == Operation::Or)
+            out.insert(out.end(), b.begin() + j, b.end());
+        result.kind = Kind::Array;
+        result.cardinality = static_cast<uint32_t>(out.size());
+        if (result.cardinality > ArrayMaximum)
+            result.ToBitmap();
+        return result.cardinality > 0;
+    }
+
+    if (operation == Operation::And && (lhs.kind == Kind::Array || rhs.kind == Kind::Array) && lhs.kind != Kind::Run && rhs.kind != Kind::Run)
+    {
+        const Container& array = lhs.kind == Kind::Array ? lhs : rhs;
+        const Container& bitmap = lhs.kind == Kind::Array ? rhs : lhs;
+        for (uint16_t low : array.values)
+        {
+            if (bitmap.words[low >> 6] & (uint64_t(1) << (low & 63)))
+                result.values.push_back(low);
+        }
+        result.kind = Kind::Array;
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+        return result.cardinality > 0;
+    }
+
+    // Bitmaps are combined where they are. Only arrays and runs are converted.
+    std::vector<uint64_t> lhsWords;
+    std::vector<uint64_t> rhsWords;
+    if (lhs.kind != Kind::Bitmap)
+        lhsWords = lhs.BitmapWordsOf();
+    if (rhs.kind != Kind::Bitmap)
+        rhsWords = rhs.BitmapWordsOf();
+    result.words.resize(BitmapWords);
+    Combine(result.words.data(), lhs.kind == Kind::Bitmap ? lhs.words.data() : lhsWords.data(),
+        rhs.kind == Kind::Bitmap ? rhs.words.data() : rhsWords.data(), operation);
+    result.kind = Kind::Bitmap;
+    result.cardinality = 0;
+    for (uint64_t word : result.words)
+        result.cardinality += PopCount(word);
+    result.ToArrayOrBitmap();
+    return result.cardinality > 0;
+}
+
+
+template<class T>
+void RoaringSet<T>::Combine(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, Operation operation)
+{
+#ifdef ROARINGSET_SSE2
+    for (size_t i = 0; i < BitmapWords; i += 2)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+        __m128i c;
+        if (operation == Operation::And)
+            c = _mm_and_si128(a, b);
+        else if (operation == Operation::Or)
+            c = _mm_or_si128(a, b);
+        else
+            c = _mm_andnot_si128(b, a); // a & ~b
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), c);
+    }
+#else
+    for (size_t i = 0; i < BitmapWords; i++)
+    {
+        if (operation == Operation::And)
+            result[i] = lhs[i] & rhs[i];
+        else if (operation == Operation::Or)
+            result[i] = lhs[i] | rhs[i];
+        else
+            result[i] = lhs[i] & ~rhs[i];
+    }
+#endif
+}
+
+
+template<class T>
+void RoaringSet<T>::Optimize()
+{
+    for (Container& container : containers)
+    {
+        if (container.kind == Kind::Run)
+            continue;
+        size_t runBytes = container.RunCount() * 4;
+        if (runBytes < container.ContentBytes())
+            container.ToRuns();
+    }
+}
+
+
+template<class T>
+size_t RoaringSet<T>::ContentBytes() const
+{
+    size_t bytes = 0;
+    for (const Container& container : containers)
+        bytes += container.ContentBytes();
+    return bytes;
+}
+
+
+template<class T>
+int RoaringSet<T>::CountTrailingZeros(uint64_t word)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int count = 0;
+    while ((word & 1) == 0)
+    {
+        word >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+
+template<class T>
+uint32_t RoaringSet<T>::PopCount(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_popcountll(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<uint32_t>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+
+template<class T>
+RoaringSet<T>::Container::Container(uint16_t key_)
+    : key(key_), kind(Kind::Array), cardinality(0)
+{}
+
+
+template<class T>
+bool RoaringSet<T>::Container::Contains(uint16_t low) const
+{
+    switch (kind)
+    {
+    case Kind::Bitmap:
+        return (words[low >> 6] & (uint64_t(1) << (low & 63))) != 0;
+    case Kind::Run:
+        {
+            size_t run = FindRun(low);
+            return run < values.size() && values[run] <= low;
+        }
+    default:
+        {
+            size_t first = 0;
+            size_t count = values.size();
+            while (count > 0)
+            {
+                size_t half = count / 2;
+                if (values[first + half] < low)
+                {
+                    first += half + 1;
+                    count -= half + 1;
+                }
+                else
+                {
+                    count = half;
+                }
+            }
+            return first < values.size() && values[first] == low;
+        }
+    }
+}
+
+
+template<class T>
+bool RoaringSet<T>::Container::Add(uint16_t low)
+{
+    if (kind == Kind::Run)
+        ToArrayOrBitmap();
+    if (kind == Kind::Bitmap)
+    {
+        uint64_t bit = uint64_t(1) << (low & 63);
+        if (words[low >> 6] & bit)
+            return false;
+        words[low >> 6] |= bit;
+        cardinality++;
+        return true;
+    }
+
+    if (values.empty() || values.back() < low)
+        values.push_back(low); // Appending in order.
+    else
+    {
+        std::vector<uint16_t>::iterator position = std::lower_bound(values.begin(), values.end(), low);
+        if (*position == low)
+            return false;
+        values.insert(position, low);
+    }
+    cardinality++;
+    if (cardinality > ArrayMaximum)
+        ToBitmap();
+    return true;
+}
+
+
+template<class T>
+bool RoaringSet<T>::Container::Erase(uint16_t low)
+{
+    if (kind == Kind::Run)
+        ToArrayOrBitmap();
+    if (kind == Kind::Bitmap)
+    {
+        uint64_t bit = uint64_t(1) << (low & 63);
+        if ((words[low >> 6] & bit) == 0)
+            return false;
+        words[low >> 6] &= ~bit;
+        cardinality--;
+        ToArrayOrBitmap();
+        return true;
+    }
+
+    std::vector<uint16_t>::iterator position = std::lower_bound(values.begin(), values.end(), low);
+    if (position == values.end() || *position != low)
+        return false;
+    values.erase(position);
+    cardinality--;
+    return true;
+}
+
+
+template<class T>
+std::vector<uint64_t> RoaringSet<T>::Container::BitmapWordsOf() const
+{
+    if (kind == Kind::Bitmap)
+        return words;
+    std::vector<uint64_t> bitmap(BitmapWords, 0);
+    if (kind == Kind::Array)
+    {
+        for (uint16_t low : values)
+            bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+        return bitmap;
+    }
+    for (size_t i = 0; i < values.size(); i += 2)
+    {
+        uint32_t last = uint32_t(values[i]) + values[i + 1];
+        for (uint32_t low = values[i]; low <= last; low++)
+            bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+    return bitmap;
+}
+
+
+template<class T>
+size_t RoaringSet<T>::Container::FindRun(uint32_t low) const
+{
+    // Runs are sorted and disjoint, so their last values ascend too.
+    size_t first = 0;
+    size_t count = values.size() / 2;
+    while (count > 0)
+    {
+        size_t half = count / 2;
+        size_t run = (first + half) * 2;
+        if (uint32_t(values[run]) + values[run + 1] < low)
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+    return first * 2;
+}
+
+
+template<class T>
+void RoaringSet<T>::Container::ToBitmap()
+{
+    words = BitmapWordsOf();
+    values.clear();
+    values.shrink_to_fit();
+    kind = Kind::Bitmap;
+}
+
+
+template<class T>
+void RoaringSet<T>::Container::ToArrayOrBitmap()
+{
+    if (kind == Kind::Array || (kind == Kind::Bitmap && cardinality > ArrayMaximum))
+        return;
+    if (cardinality > ArrayMaximum)
+    {
+        ToBitmap(); // From runs.
+        return;
+    }
+
+    std::vector<uint16_t> array;
+    array.reserve(cardinality);
+    if (kind == Kind::Bitmap)
+    {
+        for (size_t i = 0; i < BitmapWords; i++)
+        {
+            for (uint64_t word = words[i]; word != 0; word &= word - 1)
+                array.push_back(static_cast<uint16_t>(i * 64 + CountTrailingZeros(word)));
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < values.size(); i += 2)
+        {
+            uint32_t last = uint32_t(values[i]) + values[i + 1];
+            for (uint32_t low = values[i]; low <= last; low++)
+                array.push_back(static_cast<uint16_t>(low));
+        }
+    }
+    values = std::move(array);
+    words.clear();
+    words.shrink_to_fit();
+    kind = Kind::Array;
+}
+
+
+template<class T>
+size_t RoaringSet<T>::Container::RunCount() const
+{
+    size_t runs = 0;
+    if (kind == Kind::Bitmap)
+    {
+        // A run starts at every set bit whose predecessor is clear.
+        uint64_t carry = 0;
+        for (size_t i = 0; i < BitmapWords; i++)
+        {
+            uint64_t starts = words[i] & ~((words[i] << 1) | carry);
+            runs += PopCount(starts);
+            carry = words[i] >> 63;
+        }
+        return runs;
+    }
+    if (kind == Kind::Run)
+        return values.size() / 2;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (i == 0 || values[i] != values[i - 1] + 1)
+            runs++;
+    }
+    return runs;
+}
+
+
+template<class T>
+void RoaringSet<T>::Container::ToRuns()
+{
+    ToArrayOrBitmap();
+    std::vector<uint16_t> runs;
+    bool inRun = false;
+    uint32_t start = 0;
+    uint32_t previous = 0;
+    auto visit = [&](uint32_t low)
+    {
+        if (inRun && low == previous + 1)
+        {
+            previous = low;
+            return;
+        }
+        if (inRun)
+        {
+            runs.push_back(static_cast<uint16_t>(start));
+            runs.push_back(static_cast<uint16_t>(previous - start));
+        }
+        inRun = true;
+        start = previous = low;
+    };
+    if (kind == Kind::Bitmap)
+    {
+        for (size_t i = 0; i < BitmapWords; i++)
+        {
+            for (uint64_t word = words[i]; word != 0; word &= word - 1)
+                visit(static_cast<uint32_t>(i * 64 + CountTrailingZeros(word)));
+        }
+    }
+    else
+    {
+        for (uint16_t low : values)
+            visit(low);
+    }
+    if (inRun)
+    {
+        runs.push_back(static_cast<uint16_t>(start));
+        runs.push_back(static_cast<uint16_t>(previous - start));
+    }
+    values = std::move(runs);
+    values.shrink_to_fit();
+    words.clear();
+    words.shrink_to_fit();
+    kind = Kind::Run;
+}
+
+
+template<class T>
+size_t RoaringSet<T>::Container::ContentBytes() const
+{
+    return kind == Kind::Bitmap ? BitmapWords * 8 : values.size() * 2;
+}
+
+
+template<class T>
+bool RoaringSet<T>::Container::IsValid() const
+{
+    size_t count = 0;
+    switch (kind)
+    {
+    case Kind::Bitmap:
+        if (words.size() != BitmapWords || cardinality <= ArrayMaximum)
+            return false;
+        for (uint64_t word : words)
+            count += PopCount(word);
+        break;
+    case Kind::Run:
+        if (values.size() % 2 != 0)
+            return false;
+        for (size_t i = 0; i < values.size(); i += 2)
+        {
+            uint32_t last = uint32_t(values[i]) + values[i + 1];
+            if (last > 0xffff)
+                return false;
+            if (i > 0 && values[i] <= uint32_t(values[i - 2]) + values[i - 1] + 1)
+                return false; // Runs must be ordered, and separated by at least one absent value.
+            count += values[i + 1] + 1;
+        }
+        break;
+    default:
+        if (cardinality > ArrayMaximum)
+            return false;
+        for (size_t i = 1; i < values.size(); i++)
+        {
+            if (!(values[i - 1] < values[i]))
+                return false;
+        }
+        count = values.size();
+        break;
+    }
+    return count == cardinality && cardinality > 0;
+}
+
+
+template<class T>
+bool RoaringSet<T>::IsValid() const
+{
+    size_t total = 0;
+    for (size_t i = 0; i < containers.size(); i++)
+    {
+        if (i > 0 && !(containers[i - 1].key < containers[i].key))
+            return false;
+        if (!containers[i].IsValid())
+            return false;
+        total += containers[i].cardinality;
+    }
+    return total == size;
+}
+
+
+template<class T>
+RoaringSet<T>::ConstIterator::ConstIterator(const RoaringSet<T>& set_, size_t container_)
+    : set(&set_), container(container_), index(0), low(0), current(0)
+{
+    if (container < set->containers.size())
+        SettleAt(0);
+}
+
+
+template<class T>
+void RoaringSet<T>::ConstIterator::SettleAt(uint32_t target)
+{
+    while (container < set->containers.size())
+    {
+        const Container& c = set->containers[container];
+        if (target <= 0xffff)
+        {
+            switch (c.kind)
+            {
+            case Kind::Array:
+                index = std::lower_bound(c.values.begin(), c.values.end(), target) - c.values.begin();
+                if (index < c.values.size())
+                {
+                    Load();
+                    return;
+                }
+                break;
+            case Kind::Bitmap:
+                {
+                    size_t word = target >> 6;
+                    uint64_t bits = c.words[word] & (~uint64_t(0) << (target & 63));
+                    while (bits == 0 && ++word < BitmapWords)
+                        bits = c.words[word];
+                    if (bits != 0)
+                    {
+                        low = static_cast<uint32_t>(word * 64 + CountTrailingZeros(bits));
+                        Load();
+                        return;
+                    }
+                }
+                break;
+            case Kind::Run:
+                index = c.FindRun(target);
+                if (index < c.values.size())
+                {
+                    low = target > c.values[index] ? target : c.values[index];
+                    Load();
+                    return;
+                }
+                break;
+            }
+        }
+        container++;
+        target = 0;
+    }
+}
+
+
+template<class T>
+void RoaringSet<T>::ConstIterator::Load()
+{
+    const Container& c = set->containers[container];
+    uint32_t value = c.kind == Kind::Array ? c.values[index] : low;
+    current = Decode((uint32_t(c.key) << 16) | value);
+}
+
+
+template<class T>
+typename RoaringSet<T>::ConstIterator& RoaringSet<T>::ConstIterator::operator++()
+{
+    const Container& c = set->containers[container];
+    switch (c.kind)
+    {
+    case Kind::Array:
+        if (++index < c.values.size())
+        {
+            Load();
+            return *this;
+        }
+        break;
+    case Kind::Run:
+        if (low < uint32_t(c.values[index]) + c.values[index + 1])
+        {
+            low++;
+            Load();
+            return *this;
+        }
+        index += 2;
+        if (index < c.values.size())
+        {
+            low = c.values[index];
+            Load();
+            return *this;
+        }
+        break;
+    case Kind::Bitmap:
+        SettleAt(low + 1);
+        return *this;
+    }
+    container++;
+    SettleAt(0);
+    return *this;
+}
+
+
+template<class T>
+typename RoaringSet<T>::ConstIterator& RoaringSet<T>::ConstIterator::Seek(T item)
+{
+    if (container == set->containers.size() || !(current < item))
+        return *this;
+    uint32_t value = Encode(item);
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    if (set->containers[container].key < key)
+    {
+        // Skip whole containers by binary search over those that remain.
+        size_t first = container + 1;
+        size_t count = set->containers.size() - first;
+        while (count > 0)
+        {
+            size_t half = count / 2;
+            if (set->containers[first + half].key < key)
+            {
+                first += half + 1;
+                count -= half + 1;
+            }
+            else
+            {
+                count = half;
+            }
+        }
+        container = first;
+        if (container == set->containers.size() || key < set->containers[container].key)
+        {
+            SettleAt(0);
+            return *this;
+        }
+    }
+    SettleAt(value & 0xffff);
+    return *this;
+}
+
+
+template<class T>
+bool RoaringSet<T>::ConstIterator::operator==(const ConstIterator& other) const
+{
+    if (container != other.container)
+        return false;
+    if (container == set->containers.size())
+        return true;
+    return current == other.current; // SettleAt() sets only the index or low that the kind uses; the other may be stale.
+}
+
+
+template<class T>
+bool RoaringSet<T>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return !(*this == other);
+}
+
+
+template<class T>
+const T& RoaringSet<T>::ConstIterator::operator*() const
+{
+    return current;
+}
+
+
+template<class T>
+typename RoaringSet<T>::ConstIterator RoaringSet<T>::begin() const
+{
+    return ConstIterator(*this, 0);
+}
+
+
+template<class T>
+typename RoaringSet<T>::ConstIterator RoaringSet<T>::end() const
+{
+    return ConstIterator(*this, containers.size());
+}
+
+
+template class RoaringSet<uint32_t>; // To force compilation of the template, for compile-time validation.
+template class RoaringSet<int>;
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -0,0 +1,1296 @@
+#ifndef _SETOPS_H_
+#define _SETOPS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SETOPS_SSE2
+#endif
+
+/* Set operations
+
+   Bob Burrough, 2021
+
+   Operations over sorted sequences, such as the inorder iterators of AVLTree
+   and RBTree. The views below are lazy: they wrap a pair of iterators from
+   each input and produce results on demand during iteration. They allocate
+   no memory, and abandoning an iteration part way through (e.g. with break
+   in a range-based for loop) costs nothing beyond the elements visited.
+
+   Both inputs must be sorted in ascending order according to operator<(),
+   and elements are matched using operator==(). Any sorted range may be used:
+   the trees, List, C arrays, or anything else with begin() and end(). */
+
+
+/* Uniform access to sorted ranges. This is a class rather than a namespace
+   only to keep the helper overloads below out of the caller's way. */
+class SortedRange
+{
+public:
+    static const size_t UnknownSize = static_cast<size_t>(-1);
+
+    // Ratio of the larger input to the smaller at which Intersect() stops merging and starts seeking.
+    static const size_t GallopRatio = 16;
+
+    template<class R>
+    static auto Begin(const R& range) -> decltype(range.begin()) { return range.begin(); }
+    template<class E, size_t N>
+    static const E* Begin(const E (&range)[N]) { return range; }
+
+    template<class R>
+    static auto End(const R& range) -> decltype(range.end()) { return range.end(); }
+    template<class E, size_t N>
+    static const E* End(const E (&range)[N]) { return range + N; }
+
+    // Number of elements in the range, or UnknownSize if it can't be determined in O(1).
+    template<class R>
+    static size_t Size(const R& range) { return SizeOf(range, Preferred()); }
+
+    /* Advance itr to the first element which is not less than item. Tree
+       iterators use their own Seek() (a finger search), random access
+       iterators use an exponential (galloping) search, and anything else
+       steps forward one element at a time. Cost is O(log d) for the first
+       two, where d is the distance travelled, and O(d) for the last. */
+    template<class I, class U>
+    static void Seek(I& itr, const I& end, const U& item) { SeekImpl(itr, end, item, Preferred()); }
+
+    /* Calls visitor(x) for each element x of left which also appears in
+       right, in ascending order. Iteration stops early if the visitor
+       returns false. When one range is much smaller than the other, the
+       smaller is walked and the larger is searched with Seek(), for
+       O(m log(n/m)) rather than O(n + m). */
+    template<class L, class R, class Visitor>
+    static void ForEachCommon(const L& left, const R& right, Visitor visitor);
+
+    // As ForEachCommon(), but calls visitor(l, r) with the matching elements of both ranges.
+    template<class L, class R, class Visitor>
+    static void ForEachMatch(const L& left, const R& right, Visitor visitor);
+
+    /* As ForEachCommon(), for a left range which holds no duplicates, such
+       as a tree. When both ranges hold the same arithmetic type and are of
+       comparable size, BlockSize elements at a time are gathered from each
+       into buffers on the stack, and each pair of buffers is intersected
+       with IntersectBlocks(). Chasing the iterators' pointers and comparing
+       elements then happen in separate tight loops, rather than one
+       comparison per pair of iterator steps. Otherwise this is
+       ForEachCommon(). */
+    template<class L, class R, class Visitor>
+    static void ForEachCommonBlocked(const L& left, const R& right, Visitor visitor);
+
+    static const size_t BlockSize = 64;
+
+    // Copy up to capacity elements into buffer, advancing itr past them. Returns the number copied.
+    template<class I, class E>
+    static size_t Gather(I& itr, const I& end, E* buffer, size_t capacity);
+
+    /* Write each element of a which also appears in b to out, in ascending
+       order, and return the number written. Both must be sorted, a must
+       hold no duplicates, and out must have room for aSize elements. With
+       SSE2, blocks of int, unsigned or float are compared four against
+       four: each four of a is compared with the four of b in every
+       rotation, so one pass finds all the matches between them. Other
+       types are merged. */
+    template<class E>
+    static size_t IntersectBlocks(const E* a, size_t aSize, const E* b, size_t bSize, E* out);
+
+    /* Calls visitor(l, r) for every element l of left, in ascending order,
+       where r points to the matching element of right, or is nullptr. When
+       right is much larger than left, right is searched with Seek(). */
+    template<class L, class R, class Visitor>
+    static void ForEachLeft(const L& left, const R& right, Visitor visitor);
+
+    /* Calls visitor(x) for each element x of sorted which also appears in
+       unsorted, in ascending order and without repetition. Sorted must be a
+       tree (or anything else providing Size() and LowerBound()), and both
+       must hold the same element type, which must be hashable with
+       std::hash. The strategy is chosen from the sizes of the inputs:
+
+       - If unsorted is small, each of its elements is looked up in sorted,
+         and the hits are sorted. O(M log N)
+       - Otherwise a temporary open-addressed hash set is built over the
+         smaller of the two, the other is probed against it, and sorted is
+         walked in order to report the matches. O(N + M) */
+    template<class S, class R, class Visitor>
+    static void ForEachCommonUnsorted(const S& sorted, const R& unsorted, Visitor visitor);
+
+protected:
+private:
+    SortedRange() = delete;
+
+    // Overload ranking, so that the best applicable helper is chosen.
+    struct Fallback {};
+    struct Acceptable : Fallback {};
+    struct Preferred : Acceptable {};
+
+    template<class R>
+    static auto SizeOf(const R& range, Preferred) -> decltype(static_cast<size_t>(range.Size())) { return range.Size(); }
+    template<class R>
+    static auto SizeOf(const R& range, Acceptable) -> decltype(static_cast<size_t>(End(range) - Begin(range))) { return End(range) - Begin(range); }
+    template<class R>
+    static size_t SizeOf(const R&, Fallback) { return UnknownSize; }
+
+    template<class I, class U>
+    static auto SeekImpl(I& itr, const I& end, const U& item, Preferred) -> decltype(itr.Seek(item), void());
+    template<class I, class U>
+    static auto SeekImpl(I& itr, const I& end, const U& item, Acceptable) -> decltype(end - itr, itr + 1, void());
+    template<class I, class U>
+    static void SeekImpl(I& itr, const I& end, const U& item, Fallback);
+
+    template<class L, class R, class Visitor>
+    static void ForEachCommonBlockedImpl(const L& left, const R& right, Visitor& visitor, std::true_type);
+    template<class L, class R, class Visitor>
+    static void ForEachCommonBlockedImpl(const L& left, const R& right, Visitor& visitor, std::false_type);
+
+    // Move the elements of buffer which are greater than limit to its front. Returns how many there are.
+    template<class E>
+    static size_t Retain(E* buffer, size_t size, const E& limit);
+
+#ifdef SETOPS_SSE2
+    // Bit k is set if a[k] equals any of b[0, 4).
+    static unsigned MatchMask(const int* a, const int* b);
+    static unsigned MatchMask(const unsigned* a, const unsigned* b);
+    static unsigned MatchMask(const float* a, const float* b);
+#endif
+
+    template<class E>
+    static auto IntersectBlocksImpl(const E* a, size_t aSize, const E* b, size_t bSize, E* out, Preferred) -> decltype(MatchMask(a, b), size_t());
+    template<class E>
+    static size_t IntersectBlocksImpl(const E* a, size_t aSize, const E* b, size_t bSize, E* out, Fallback);
+
+    // The merge behind IntersectBlocks(). Bit k of found marks a[k] (k < 4) as already known to be common.
+    template<class E>
+    static size_t MergeBlocks(const E* a, size_t aSize, const E* b, size_t bSize, unsigned found, E* out);
+};
+
+
+// The iterator type produced by SortedRange::Begin() for a range of type R.
+template<class R>
+using SortedRangeIterator = decltype(SortedRange::Begin(std::declval<const R&>()));
+
+
+/* Insert-only hash set of pointers to items owned by someone else, using
+   open addressing with linear probing. It is meant to live only as long as
+   a single operation, e.g. SortedRange::ForEachCommonUnsorted(). Each slot
+   can be marked, so that probes can be recorded against the set. */
+template<class T, class Hash = std::hash<T>>
+class TemporaryHashSet
+{
+public:
+    TemporaryHashSet(size_t expectedCount);
+    virtual ~TemporaryHashSet();
+
+    // Add an item. Returns false, and leaves the set unchanged, if an equal item is already present.
+    bool Insert(const T* item);
+
+    // Returns the slot holding an item equal to the given one, or NotFound.
+    size_t Find(const T& item) const;
+
+    void Mark(size_t slot);
+    bool IsMarked(size_t slot) const;
+
+    static const size_t NotFound = static_cast<size_t>(-1);
+
+protected:
+private:
+    TemporaryHashSet() = delete;
+    size_t Slot(size_t hash) const; // Scrambles the hash, since e.g. std::hash<int> is the identity.
+    TemporaryHashSet(const TemporaryHashSet&) = delete;
+    TemporaryHashSet& operator=(const TemporaryHashSet&) = delete;
+    const T** slots;
+    bool* marks;
+    size_t mask; // capacity - 1, where capacity is a power of two
+};
+
+
+/* Set predicates. These answer questions about two sorted ranges without
+   building anything, and stop as soon as the answer is known. Each range
+   is assumed to hold no duplicates. */
+
+// Returns |left ∩ right|.
+template<class L, class R>
+size_t IntersectionSize(const L& left, const R& right);
+
+// Returns true if every element of right also appears in left (right ⊆ left).
+template<class L, class R>
+bool Includes(const L& left, const R& right);
+
+// Returns true if left and right have no elements in common. Stops at the first common element.
+template<class L, class R>
+bool IsDisjoint(const L& left, const R& right);
+
+// Returns true if left and right hold the same elements.
+template<class L, class R>
+bool Equals(const L& left, const R& right);
+
+
+/* Relational joins over maps, i.e. sorted ranges of Pairs such as AVLMap,
+   RBMap, or a sorted array of Pairs. Keys are matched in one pass over both
+   inputs, and a much larger input is searched with Seek() rather than
+   walked. Each map is assumed to hold unique keys. */
+
+// Calls callback(key, leftValue, rightValue) for each key which appears in both maps, in ascending order.
+template<class L, class R, class Callback>
+void MergeJoin(const L& left, const R& right, Callback callback);
+
+/* Calls callback(key, leftValue, rightValue) for each key of left, in
+   ascending order. rightValue points to the value stored under the key in
+   right, or is nullptr if right has no such key. */
+template<class L, class R, class Callback>
+void LeftOuterJoin(const L& left, const R& right, Callback callback);
+
+// Calls callback(key, leftValue) for each key of left which does not appear in right, in ascending order.
+template<class L, class R, class Callback>
+void AntiJoin(const L& left, const R& right, Callback callback);
+
+
+/* Elements which appear in both sequences. Elements are reported from the
+   left sequence. */
+template<class LeftIterator, class RightIterator>
+class IntersectView
+{
+public:
+    IntersectView(const LeftIterator& leftBegin, const LeftIterator& leftEnd, const RightIterator& rightBegin, const RightIterator& rightEnd);
+
+    class Iterator
+    {
+    public:
+        typedef decltype(*std::declval<const LeftIterator&>()) Reference;
+
+        Iterator(const LeftIterator& left, const LeftIterator& leftEnd, const RightIterator& right, const RightIterator& rightEnd);
+        Iterator& operator++();
+        bool operator!=(const Iterator& other) const;
+        Reference operator*() const;
+
+    protected:
+    private:
+        Iterator() = delete;
+        bool AtEnd() const;
+        void Settle(); // advances both sides until they rest on a common element, or one side is exhausted
+        LeftIterator left;
+        LeftIterator leftEnd;
+        RightIterator right;
+        RightIterator rightEnd;
+    };
+    Iterator begin() const;
+    Iterator end() const;
+
+protected:
+private:
+    IntersectView() = delete;
+    LeftIterator leftBegin;
+    LeftIterator leftEnd;
+    RightIterator rightBegin;
+    RightIterator rightEnd;
+};
+
+
+/* Elements which appear in either sequence. An element which appears in
+   both sequences is reported once, from the left sequence. Both sequences
+   must hold the same element type. */
+template<class LeftIterator, class RightIterator>
+class UnionView
+{
+public:
+    UnionView(const LeftIterator& leftBegin, const LeftIterator& leftEnd, const RightIterator& rightBegin, const RightIterator& rightEnd);
+
+    class Iterator
+    {
+    public:
+        typedef decltype(*std::declval<const LeftIterator&>()) Reference;
+
+        static_assert(std::is_same<typename std::decay<Reference>::type, typename std::decay<decltype(*std::declval<const RightIterator&>())>::type>::value,
+            "UnionView reports elements from both sequences, so both must hold the same element type.");
+
+        Iterator(const LeftIterator& left, const LeftIterator& leftEnd, const RightIterator& right, const RightIterator& rightEnd);
+        Iterator& operator++();
+        bool operator!=(const Iterator& other) const;
+        Reference operator*() const;
+
+    protected:
+    private:
+        Iterator() = delete;
+        bool AtEnd() const;
+        void Settle(); // decides which side holds the next element
+        LeftIterator left;
+        LeftIterator leftEnd;
+        RightIterator right;
+        RightIterator rightEnd;
+        bool fromLeft; // whether the current element is taken from the left sequence
+        bool both; // whether the current element also appears in the right sequence
+    };
+    Iterator begin() const;
+    Iterator end() const;
+
+protected:
+private:
+    UnionView() = delete;
+    LeftIterator leftBegin;
+    LeftIterator leftEnd;
+    RightIterator rightBegin;
+    RightIterator rightEnd;
+};
+
+
+// Elements of the left sequence which do not appear in the right sequence.
+template<class LeftIterator, class RightIterator>
+class DifferenceView
+{
+public:
+    DifferenceView(const LeftIterator& leftBegin, const LeftIterator& leftEnd, const RightIterator& rightBegin, const RightIterator& rightEnd);
+
+    class Iterator
+    {
+    public:
+        typedef decltype(*std::declval<const LeftIterator&>()) Reference;
+
+        Iterator(const LeftIterator& left, const LeftIterator& leftEnd, const RightIterator& right, const RightIterator& rightEnd);
+        Iterator& operator++();
+        bool operator!=(const Iterator& other) const;
+        Reference operator*() const;
+
+    protected:
+    private:
+        Iterator() = delete;
+        bool AtEnd() const;
+        void Settle(); // advances the left side past any elements found in the right side
+        LeftIterator left;
+        LeftIterator leftEnd;
+        RightIterator right;
+        RightIterator rightEnd;
+    };
+    Iterator begin() const;
+    Iterator end() const;
+
+protected:
+private:
+    DifferenceView() = delete;
+    LeftIterator leftBegin;
+    LeftIterator leftEnd;
+    RightIterator rightBegin;
+    RightIterator rightEnd;
+};
+
+
+/* Convenience functions for viewing two sorted ranges, e.g.
+
+       for (const int& x : MakeIntersectView(avlTree, rbTree))
+           ...
+*/
+template<class L, class R>
+IntersectView<SortedRangeIterator<L>, SortedRangeIterator<R>> MakeIntersectView(const L& left, const R& right);
+
+template<class L, class R>
+UnionView<SortedRangeIterator<L>, SortedRangeIterator<R>> MakeUnionView(const L& left, const R& right);
+
+template<class L, class R>
+DifferenceView<SortedRangeIterator<L>, SortedRangeIterator<R>> MakeDifferenceView(const L& left, const R& right);
+
+
+template<class I, class U>
+auto SortedRange::SeekImpl(I& itr, const I& end, const U& item, Preferred) -> decltype(itr.Seek(item), void())
+{
+    if (itr != end)
+        itr.Seek(item);
+}
+
+
+template<class I, class U>
+auto SortedRange::SeekImpl(I& itr, const I& end, const U& item, Acceptable) -> decltype(end - itr, itr + 1, void())
+{
+    if (!(itr != end) || !(*itr < item))
+        return;
+
+    // Gallop forward until we overshoot, then binary search the last step.
+    size_t remaining = end - itr;
+    size_t low = 0; // *(itr + low) < item
+    size_t step = 1;
+    while (step < remaining && *(itr + step) < item)
+    {
+        low = step;
+        step *= 2;
+    }
+    size_t high = step < remaining ? step : remaining; // *(itr + high) is not less than item, or high is the end
+    while (high - low > 1)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (*(itr + middle) < item)
+            low = middle;
+        else
+            high = middle;
+    }
+    itr = itr + high;
+}
+
+
+template<class I, class U>
+void SortedRange::SeekImpl(I& itr, const I& end, const U& item, Fallback)
+{
+    while (itr != end && *itr < item)
+        ++itr;
+}
+
+
+template<class L, class R, class Visitor>
+void SortedRange::ForEachCommon(const L& left, const R& right, Visitor visitor)
+{
+    typedef decltype(*Begin(left)) LeftReference;
+    typedef decltype(*Begin(right)) RightReference;
+    ForEachMatch(left, right, [&visitor](LeftReference l, RightReference) { return visitor(l); });
+}
+
+
+template<class L, class R, class Visitor>
+void SortedRange::ForEachMatch(const L& left, const R& right, Visitor visitor)
+{
+    SortedRangeIterator<L> l = Begin(left);
+    SortedRangeIterator<L> lEnd = End(left);
+    SortedRangeIterator<R> r = Begin(right);
+    SortedRangeIterator<R> rEnd = End(right);
+
+    size_t leftSize = Size(left);
+    size_t rightSize = Size(right);
+    bool sizesKnown = leftSize != UnknownSize && rightSize != UnknownSize;
+
+    if (sizesKnown && leftSize / GallopRatio > rightSize)
+    {
+        // Left is much larger. Walk right, and seek through left.
+        for (; r != rEnd && l != lEnd; ++r)
+        {
+            Seek(l, lEnd, *r);
+            if (l != lEnd && *l == *r)
+            {
+                if (!visitor(*l, *r))
+                    return;
+                ++l;
+            }
+        }
+    }
+    else if (sizesKnown && rightSize / GallopRatio > leftSize)
+    {
+        // Right is much larger. Walk left, and seek through right.
+        for (; l != lEnd && r != rEnd; ++l)
+        {
+            Seek(r, rEnd, *l);
+            if (r != rEnd && *l == *r)
+            {
+                if (!visitor(*l, *r))
+                    return;
+                ++r;
+            }
+        }
+    }
+    else
+    {
+        // Comparable sizes. A lock-step merge is cheapest.
+        while (l != lEnd && r != rEnd)
+        {
+            if (*l == *r)
+            {
+                if (!visitor(*l, *r))
+                    return;
+                ++l;
+                ++r;
+            }
+            else if (*l < *r)
+                ++l;
+            else
+                ++r;
+        }
+    }
+}
+
+
+template<class L, class R, class Visitor>
+void SortedRange::ForEachCommonBlocked(const L& left, const R& right, Visitor visitor)
+{
+    typedef typename std::decay<decltype(*Begin(left))>::type LeftElement;
+    typedef typename std::decay<decltype(*Begin(right))>::type RightElement;
+    ForEachCommonBlockedImpl(left, right, visitor,
+        std::integral_constant<bool, std::is_arithmetic<LeftElement>::value && std::is_same<LeftElement, RightElement>::value>());
+}
+
+
+template<class L, class R, class Visitor>
+void SortedRange::ForEachCommonBlockedImpl(const L& left, const R& right, Visitor& visitor, std::false_type)
+{
+    ForEachCommon(left, right, visitor);
+}
+
+
+template<class L, class R, class Visitor>
+void SortedRange::ForEachCommonBlockedImpl(const L& left, const R& right, Visitor& visitor, std::true_type)
+{
+    size_t leftSize = Size(left);
+    size_t rightSize = Size(right);
+    if (leftSize != UnknownSize && rightSize != UnknownSize && (leftSize / GallopRatio > rightSize || rightSize / GallopRatio > leftSize))
+    {
+        ForEachCommon(left, right, visitor); // Seeking beats walking either range in full.
+        return;
+    }
+
+    typedef typename std::decay<decltype(*Begin(left))>::type Element;
+    SortedRangeIterator<L> l = Begin(left);
+    SortedRangeIterator<L> lEnd = End(left);
+    SortedRangeIterator<R> r = Begin(right);
+    SortedRangeIterator<R> rEnd = End(right);
+    Element a[BlockSize];
+    Element b[BlockSize];
+    Element common[BlockSize];
+    size_t aSize = 0;
+    size_t bSize = 0;
+    for (;;)
+    {
+        aSize += Gather(l, lEnd, a + aSize, BlockSize - aSize);
+        bSize += Gather(r, rEnd, b + bSize, BlockSize - bSize);
+        if (aSize == 0 || bSize == 0)
+            return;
+
+        size_t count = IntersectBlocks(a, aSize, b, bSize, common);
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!visitor(common[i]))
+                return;
+        }
+
+        /* The buffer with the smaller last element is used up. The other may
+           hold elements beyond the end of it, which could match elements not
+           yet gathered, so those are kept. */
+        Element aLast = a[aSize - 1];
+        Element bLast = b[bSize - 1];
+        aSize = Retain(a, aSize, bLast);
+        bSize = Retain(b, bSize, aLast);
+    }
+}
+
+
+template<class I, class E>
+size_t SortedRange::Gather(I& itr, const I& end, E* buffer, size_t capacity)
+{
+    size_t count = 0;
+    for (; count < capacity && itr != end; ++itr)
+        buffer[count++] = *itr;
+    return count;
+}
+
+
+template<class E>
+size_t SortedRange::Retain(E* buffer, size_t size, const E& limit)
+{
+    size_t first = size;
+    while (first > 0 && limit < buffer[first - 1])
+        first--;
+    std::copy(buffer + first, buffer + size, buffer);
+    return size - first;
+}
+
+
+template<class E>
+size_t SortedRange::IntersectBlocks(const E* a, size_t aSize, const E* b, size_t bSize, E* out)
+{
+    return IntersectBlocksImpl(a, aSize, b, bSize, out, Preferred());
+}
+
+
+template<class E>
+auto SortedRange::IntersectBlocksImpl(const E* a, size_t aSize, const E* b, size_t bSize, E* out, Preferred) -> decltype(MatchMask(a, b), size_t())
+{
+    size_t i = 0;
+    size_t j = 0;
+    size_t count = 0;
+    unsigned found = 0; // Matches found so far for a[i, i + 4).
+    while (i + 4 <= aSize && j + 4 <= bSize)
+    {
+        found |= MatchMask(a + i, b + j);
+        E aLast = a[i + 3];
+        E bLast = b[j + 3];
+        if (!(bLast < aLast))
+        {
+            // No later four of b can match these four of a.
+            for (unsigned k = 0; k < 4; k++)
+            {
+                if (found & (1u << k))
+                    out[count++] = a[i + k];
+            }
+            found = 0;
+            i += 4;
+        }
+        if (!(aLast < bLast))
+            j += 4;
+    }
+    return count + MergeBlocks(a + i, aSize - i, b + j, bSize - j, found, out + count);
+}
+
+
+template<class E>
+size_t SortedRange::IntersectBlocksImpl(const E* a, size_t aSize, const E* b, size_t bSize, E* out, Fallback)
+{
+    return MergeBlocks(a, aSize, b, bSize, 0, out);
+}
+
+
+template<class E>
+size_t SortedRange::MergeBlocks(const E* a, size_t aSize, const E* b, size_t bSize, unsigned found, E* out)
+{
+    size_t count = 0;
+    size_t j = 0;
+    for (size_t i = 0; i < aSize; i++)
+    {
+        while (j < bSize && b[j] < a[i])
+            j++;
+        bool alreadyFound = i < 4 && (found & (1u << i)) != 0;
+        if (alreadyFound || (j < bSize && b[j] == a[i]))
+            out[count++] = a[i];
+        else if (j == bSize && (i >= 4 || (found >> i) == 0))
+            break;
+    }
+    return count;
+}
+
+
+#ifdef SETOPS_SSE2
+inline unsigned SortedRange::MatchMask(const int* a, const int* b)
+{
+    __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+    __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+    __m128i matches = _mm_cmpeq_epi32(left, right);
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi32(left, _mm_shuffle_epi32(right, _MM_SHUFFLE(0, 3, 2, 1))));
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi32(left, _mm_shuffle_epi32(right, _MM_SHUFFLE(1, 0, 3, 2))));
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi32(left, _mm_shuffle_epi32(right, _MM_SHUFFLE(2, 1, 0, 3))));
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(matches)));
+}
+
+
+inline unsigned SortedRange::MatchMask(const unsigned* a, const unsigned* b)
+{
+    return MatchMask(reinterpret_cast<const int*>(a), reinterpret_cast<const int*>(b)); // Equality doesn't care about sign.
+}
+
+
+inline unsigned SortedRange::MatchMask(const float* a, const float* b)
+{
+    __m128 left = _mm_loadu_ps(a);
+    __m128 right = _mm_loadu_ps(b);
+    __m128 matches = _mm_cmpeq_ps(left, right);
+    matches = _mm_or_ps(matches, _mm_cmpeq_ps(left, _mm_shuffle_ps(right, right, _MM_SHUFFLE(0, 3, 2, 1))));
+    matches = _mm_or_ps(matches, _mm_cmpeq_ps(left, _mm_shuffle_ps(right, right, _MM_SHUFFLE(1, 0, 3, 2))));
+    matches = _mm_or_ps(matches, _mm_cmpeq_ps(left, _mm_shuffle_ps(right, right, _MM_SHUFFLE(2, 1, 0, 3))));
+    return static_cast<unsigned>(_mm_movemask_ps(matches));
+}
+#endif
+
+
+template<class L, class R, class Visitor>
+void SortedRange::ForEachLeft(const L& left, const R& right, Visitor visitor)
+{
+    SortedRangeIterator<L> l = Begin(left);
+    SortedRangeIterator<L> lEnd = End(left);
+    SortedRangeIterator<R> r = Begin(right);
+    SortedRangeIterator<R> rEnd = End(right);
+    typedef typename std::remove_reference<decltype(*r)>::type RightElement;
+
+    size_t leftSize = Size(left);
+    size_t rightSize = Size(right);
+    bool seek = leftSize != UnknownSize && rightSize != UnknownSize && rightSize / GallopRatio > leftSize;
+
+    for (; l != lEnd; ++l)
+    {
+        if (seek)
+            Seek(r, rEnd, *l);
+        else
+        {
+            while (r != rEnd && *r < *l)
+                ++r;
+        }
+
+        if (r != rEnd && *l == *r)
+        {
+            visitor(*l, &*r);
+            ++r;
+        }
+        else
+            visitor(*l, static_cast<RightElement*>(nullptr));
+    }
+}
+
+
+template<class LeftIterator, class RightIterator>
+IntersectView<LeftIterator, RightIterator>::IntersectView(const LeftIterator& leftBegin_, const LeftIterator& leftEnd_, const RightIterator& rightBegin_, const RightIterator& rightEnd_)
+    : leftBegin(leftBegin_), leftEnd(leftEnd_), rightBegin(rightBegin_), rightEnd(rightEnd_)
+{}
+
+
+template<class LeftIterator, class RightIterator>
+typename IntersectView<LeftIterator, RightIterator>::Iterator IntersectView<LeftIterator, RightIterator>::begin() const
+{
+    return Iterator(leftBegin, leftEnd, rightBegin, rightEnd);
+}
+
+
+template<class LeftIterator, class RightIterator>
+typename IntersectView<LeftIterator, RightIterator>::Iterator IntersectView<LeftIterator, RightIterator>::end() const
+{
+    return Iterator(leftEnd, leftEnd, rightEnd, rightEnd);
+}
+
+
+template<class LeftIterator, class RightIterator>
+IntersectView<LeftIterator, RightIterator>::Iterator::Iterator(const LeftIterator& left_, const LeftIterator& leftEnd_, const RightIterator& right_, const RightIterator& rightEnd_)
+    : left(left_), leftEnd(leftEnd_), right(right_), rightEnd(rightEnd_)
+{
+    Settle();
+}
+
+
+template<class LeftIterator, class RightIterator>
+bool IntersectView<LeftIterator, RightIterator>::Iterator::AtEnd() const
+{
+    return !(left != leftEnd) || !(right != rightEnd);
+}
+
+
+template<class LeftIterator, class RightIterator>
+void IntersectView<LeftIterator, RightIterator>::Iterator::Settle()
+{
+    /* Step once, and seek if that wasn't enough. Dense inputs advance a
+       single element at a time, while sparse inputs skip ahead quickly. */
+    while (left != leftEnd && right != rightEnd)
+    {
+        if (*left == *right)
+            break;
+        else if (*left < *right)
+        {
+            ++left;
+            if (left != leftEnd && *left < *right)
+                SortedRange::Seek(left, leftEnd, *right);
+        }
+        else
+        {
+            ++right;
+            if (right != rightEnd && *right < *left)
+                SortedRange::Seek(right, rightEnd, *left);
+        }
+    }
+}
+
+
+template<class LeftIterator, class RightIterator>
+typename IntersectView<LeftIterator, RightIterator>::Iterator& IntersectView<LeftIterator, RightIterator>::Iterator::operator++()
+{
+    ++left;
+    ++right;
+    Settle();
+    return *this;
+}
+
+
+template<class LeftIterator, class RightIterator>
+bool IntersectView<LeftIterator, RightIterator>::Iterator::operator!=(const Iterator& other) const
+{
+    /* Once either side is exhausted the iteration is over, regardless of
+       where the other side happens to be resting. */
+    bool atEnd = AtEnd();
+    bool otherAtEnd = other.AtEnd();
+    if (atEnd || otherAtEnd)
+        return atEnd != otherAtEnd;
+    return left != other.left || right != other.right;
+}
+
+
+template<class LeftIterator, class RightIterator>
+typename IntersectView<LeftIterator, RightIterator>::Iterator::Reference IntersectView<LeftIterator, RightIterator>::Iterator::operator*() const
+{
+    return *left;
+}
+
+
+template<class LeftIterator, class RightIterator>
+UnionView<LeftIterator, RightIterator>::UnionView(const LeftIterator& leftBegin_, const LeftIterator& leftEnd_, const RightIterator& rightBegin_, const RightIterator& rightEnd_)
+    : leftBegin(leftBegin_), leftEnd(leftEnd_), rightBegin(rightBegin_), rightEnd(rightEnd_)
+{}
+
+
+template<class LeftIterator, class RightIterator>
+typename UnionView<LeftIterator, RightIterator>::Iterator UnionView<LeftIterator, RightIterator>::begin() const
+{
+    return Iterator(leftBegin, leftEnd, rightBegin, rightEnd);
+}
+
+
+template<class LeftIterator, class RightIterator>
+typename UnionView<LeftIterator, RightIterator>::Iterator UnionView<LeftIterator, RightIterator>::end() const
+{
+    return Iterator(leftEnd, leftEnd, rightEnd, rightEnd);
+}
+
+
+template<class LeftIterator, class RightIterator>
+UnionView<LeftIterator, RightIterator>::Iterator::Iterator(const LeftIterator& left_, const LeftIterator& leftEnd_, const RightIterator& right_, const RightIterator& rightEnd_)
+    : left(left_), leftEnd(leftEnd_), right(right_), rightEnd(rightEnd_), fromLeft(true), both(false)
+{
+    Settle();
+}
+
+
+template<class LeftIterator, class RightIterator>
+bool UnionView<LeftIterator, RightIterator>::Iterator::AtEnd() const
+{
+    return !(left != leftEnd) && !(right != rightEnd);
+}
+
+
+template<class LeftIterator, class RightIterator>
+void UnionView<LeftIterator, RightIterator>::Iterator::Settle()
+{
+    if (!(left != leftEnd))
+    {
+        fromLeft = false;
+        both = false;
+    }
+    else if (!(right != rightEnd))
+    {
+        fromLeft = true;
+        both = false;
+    }
+    else
+    {
+        both = *left == *right;
+        fromLeft = both || *left < *right;
+    }
+}
+
+
+template<class LeftIterator, class RightIterator>
+typename UnionView<LeftIterator, RightIterator>::Iterator& UnionView<LeftIterator, RightIterator>::Iterator::operator++()
+{
+    if (fromLeft)
+    {
+        ++left;
+        if (both)
+            ++right;
+    }
+    else
+        ++right;
+    Settle();
+    return *this;
+}
+
+
+template<class LeftIterator, class RightIterator>
+bool UnionView<LeftIterator, RightIterator>::Iterator::operator!=(const Iterator& other) const
+{
+    bool atEnd = AtEnd();
+    bool otherAtEnd = other.AtEnd();
+    if (atEnd || otherAtEnd)
+        return atEnd != otherAtEnd;
+    return left != other.left || right != other.right;
+}
+
+
+template<class LeftIterator, class RightIterator>
+typename UnionView<LeftIterator, RightIterator>::Iterator::Reference UnionView<LeftIterator, RightIterator>::Iterator::operator*() const
+{
+    if (fromLeft)
+        return *left;
+    return *right;
+}
+
+
+template<class LeftIterator, class RightIterator>
+DifferenceView<LeftIterator, RightIterator>::DifferenceView(const LeftIterator& leftBegin_, const LeftIterator& leftEnd_, const RightIterator& rightBegin_, const RightIterator& rightEnd_)
+    : leftBegin(leftBegin_), leftEnd(leftEnd_), rightBegin(rightBegin_), rightEnd(rightEnd_)
+{}
+
+
+template<class LeftIterator, class RightIterator>
+typename DifferenceView<LeftIterator, RightIterator>::Iterator DifferenceView<LeftIterator, RightIterator>::begin() const
+{
+    return Iterator(leftBegin, leftEnd, rightBegin, rightEnd);
+}
+
+
+template<class LeftIterator, class RightIterator>
+typename DifferenceView<LeftIterator, RightIterator>::Iterator DifferenceView<LeftIterator, RightIterator>::end() const
+{
+    return Iterator(leftEnd, leftEnd, rightEnd, rightEnd);
+}
+
+
+template<class LeftIterator, class RightIterator>
+DifferenceView<LeftIterator, RightIterator>::Iterator::Iterator(const LeftIterator& left_, const LeftIterator& leftEnd_, const RightIterator& right_, const RightIterator& rightEnd_)
+    : left(left_), leftEnd(leftEnd_), right(right_), rightEnd(rightEnd_)
+{
+    Settle();
+}
+
+
+template<class LeftIterator, class RightIterator>
+bool DifferenceView<LeftIterator, RightIterator>::Iterator::AtEnd() const
+{
+    return !(left != leftEnd);
+}
+
+
+template<class LeftIterator, class RightIterator>
+void DifferenceView<LeftIterator, RightIterator>::Iterator::Settle()
+{
+    while (left != leftEnd)
+    {
+        if (right != rightEnd && *right < *left)
+            SortedRange::Seek(right, rightEnd, *left);
+
+        if (right != rightEnd && *left == *right)
+            ++left; // present on both sides, so it isn't part of the difference
+        else
+            break;
+    }
+}
+
+
+template<class LeftIterator, class RightIterator>
+typename DifferenceView<LeftIterator, RightIterator>::Iterator& DifferenceView<LeftIterator, RightIterator>::Iterator::operator++()
+{
+    ++left;
+    Settle();
+    return *this;
+}
+
+
+template<class LeftIterator, class RightIterator>
+bool DifferenceView<LeftIterator, RightIterator>::Iterator::operator!=(const Iterator& other) const
+{
+    bool atEnd = AtEnd();
+    bool otherAtEnd = other.AtEnd();
+    if (atEnd || otherAtEnd)
+        return atEnd != otherAtEnd;
+    return left != other.left;
+}
+
+
+template<class LeftIterator, class RightIterator>
+typename DifferenceView<LeftIterator, RightIterator>::Iterator::Reference DifferenceView<LeftIterator, RightIterator>::Iterator::operator*() const
+{
+    return *left;
+}
+
+
+template<class S, class R, class Visitor>
+void SortedRange::ForEachCommonUnsorted(const S& sorted, const R& unsorted, Visitor visitor)
+{
+    typedef typename std::decay<decltype(*Begin(sorted))>::type Element;
+    static_assert(std::is_same<Element, typename std::decay<decltype(*Begin(unsorted))>::type>::value,
+        "Unsorted intersection hashes elements from both sides, so both must hold the same element type.");
+
+    size_t sortedSize = sorted.Size();
+    size_t unsortedSize = Size(unsorted);
+    if (unsortedSize == UnknownSize)
+    {
+        unsortedSize = 0;
+        for (SortedRangeIterator<R> u = Begin(unsorted); u != End(unsorted); ++u)
+            unsortedSize++;
+    }
+    if (sortedSize == 0 || unsortedSize == 0)
+        return;
+
+    size_t depth = 1; // approximately log2 of sortedSize, the cost of a lookup
+    for (size_t remaining = sortedSize; remaining > 1; remaining /= 2)
+        depth++;
+
+    if (unsortedSize * depth < sortedSize)
+    {
+        // Look up each element, then put the hits in order. Equal hits refer to the same element of sorted.
+        const Element** hits = new const Element*[unsortedSize];
+        size_t hitCount = 0;
+        for (SortedRangeIterator<R> u = Begin(unsorted); u != End(unsorted); ++u)
+        {
+            auto found = sorted.LowerBound(*u);
+            if (found != sorted.end() && *found == *u)
+                hits[hitCount++] = &*found;
+        }
+        std::sort(hits, hits + hitCount, [](const Element* a, const Element* b) { return *a < *b; });
+        for (size_t i = 0; i < hitCount; i++)
+        {
+            if (i > 0 && hits[i] == hits[i - 1])
+                continue;
+            if (!visitor(*hits[i]))
+                break;
+        }
+        delete[] hits;
+    }
+    else if (sortedSize <= unsortedSize)
+    {
+        // Hash sorted, mark whatever unsorted hits, then report the marks in order.
+        TemporaryHashSet<Element> set(sortedSize);
+        for (SortedRangeIterator<S> s = Begin(sorted); s != End(sorted); ++s)
+            set.Insert(&*s);
+        for (SortedRangeIterator<R> u = Begin(unsorted); u != End(unsorted); ++u)
+        {
+            size_t slot = set.Find(*u);
+            if (slot != set.NotFound)
+                set.Mark(slot);
+        }
+        for (SortedRangeIterator<S> s = Begin(sorted); s != End(sorted); ++s)
+        {
+            if (set.IsMarked(set.Find(*s)) && !visitor(*s))
+                break;
+        }
+    }
+    else
+    {
+        // Hash unsorted, then walk sorted in order and report whatever the set contains.
+        TemporaryHashSet<Element> set(unsortedSize);
+        for (SortedRangeIterator<R> u = Begin(unsorted); u != End(unsorted); ++u)
+            set.Insert(&*u);
+        for (SortedRangeIterator<S> s = Begin(sorted); s != End(sorted); ++s)
+        {
+            if (set.Find(*s) != set.NotFound && !visitor(*s))
+                break;
+        }
+    }
+}
+
+
+template<class T, class Hash>
+TemporaryHashSet<T, Hash>::TemporaryHashSet(size_t expectedCount)
+    : slots(nullptr), marks(nullptr), mask(0)
+{
+    size_t capacity = 8;
+    while (capacity < expectedCount * 2) // keep the load factor at or below one half
+        capacity *= 2;
+    slots = new const T*[capacity];
+    marks = new bool[capacity];
+    for (size_t i = 0; i < capacity; i++)
+    {
+        slots[i] = nullptr;
+        marks[i] = false;
+    }
+    mask = capacity - 1;
+}
+
+
+template<class T, class Hash>
+TemporaryHashSet<T, Hash>::~TemporaryHashSet()
+{
+    delete[] slots;
+    delete[] marks;
+}
+
+
+template<class T, class Hash>
+bool TemporaryHashSet<T, Hash>::Insert(const T* item)
+{
+    size_t slot = Slot(Hash()(*item));
+    while (slots[slot] != nullptr)
+    {
+        if (*slots[slot] == *item)
+            return false;
+        slot = (slot + 1) & mask;
+    }
+    slots[slot] = item;
+    return true;
+}
+
+
+template<class T, class Hash>
+size_t TemporaryHashSet<T, Hash>::Find(const T& item) const
+{
+    size_t slot = Slot(Hash()(item));
+    while (slots[slot] != nullptr)
+    {
+        if (*slots[slot] == item)
+            return slot;
+        slot = (slot + 1) & mask;
+    }
+    return NotFound;
+}
+
+
+template<class T, class Hash>
+size_t TemporaryHashSet<T, Hash>::Slot(size_t hash) const
+{
+    hash ^= hash >> 16;
+    hash *= 0x7feb352d;
+    hash ^= hash >> 15;
+    return hash & mask;
+}
+
+
+template<class T, class Hash>
+void TemporaryHashSet<T, Hash>::Mark(size_t slot)
+{
+    marks[slot] = true;
+}
+
+
+template<class T, class Hash>
+bool TemporaryHashSet<T, Hash>::IsMarked(size_t slot) const
+{
+    return slot != NotFound && marks[slot];
+}
+
+
+template<class L, class R>
+size_t IntersectionSize(const L& left, const R& right)
+{
+    size_t count = 0;
+    SortedRange::ForEachCommon(left, right, [&count](const auto&)
+    {
+        count++;
+        return true;
+    });
+    return count;
+}
+
+
+template<class L, class R>
+bool Includes(const L& left, const R& right)
+{
+    size_t leftSize = SortedRange::Size(left);
+    size_t rightSize = SortedRange::Size(right);
+    if (leftSize != SortedRange::UnknownSize && rightSize != SortedRange::UnknownSize && rightSize > leftSize)
+        return false; // right can't fit inside left
+
+    SortedRangeIterator<L> l = SortedRange::Begin(left);
+    SortedRangeIterator<L> lEnd = SortedRange::End(left);
+    for (SortedRangeIterator<R> r = SortedRange::Begin(right); r != SortedRange::End(right); ++r)
+    {
+        SortedRange::Seek(l, lEnd, *r);
+        if (!(l != lEnd) || !(*l == *r))
+            return false;
+        ++l;
+    }
+    return true;
+}
+
+
+template<class L, class R>
+bool IsDisjoint(const L& left, const R& right)
+{
+    bool disjoint = true;
+    SortedRange::ForEachCommon(left, right, [&disjoint](const auto&)
+    {
+        disjoint = false;
+        return false; // one common element is enough
+    });
+    return disjoint;
+}
+
+
+template<class L, class R>
+bool Equals(const L& left, const R& right)
+{
+    size_t leftSize = SortedRange::Size(left);
+    size_t rightSize = SortedRange::Size(right);
+    if (leftSize != SortedRange::UnknownSize && rightSize != SortedRange::UnknownSize && leftSize != rightSize)
+        return false;
+
+    SortedRangeIterator<L> l = SortedRange::Begin(left);
+    SortedRangeIterator<R> r = SortedRange::Begin(right);
+    for (; l != SortedRange::End(left) && r != SortedRange::End(right); ++l, ++r)
+    {
+        if (!(*l == *r))
+            return false;
+    }
+    return !(l != SortedRange::End(left)) && !(r != SortedRange::End(right));
+}
+
+
+template<class L, class R, class Callback>
+void MergeJoin(const L& left, const R& right, Callback callback)
+{
+    SortedRange::ForEachMatch(left, right, [&callback](const auto& l, const auto& r)
+    {
+        callback(l.key, l.value, r.value);
+        return true;
+    });
+}
+
+
+template<class L, class R, class Callback>
+void LeftOuterJoin(const L& left, const R& right, Callback callback)
+{
+    SortedRange::ForEachLeft(left, right, [&callback](const auto& l, const auto* r)
+    {
+        callback(l.key, l.value, r != nullptr ? &r->value : nullptr);
+    });
+}
+
+
+template<class L, class R, class Callback>
+void AntiJoin(const L& left, const R& right, Callback callback)
+{
+    SortedRange::ForEachLeft(left, right, [&callback](const auto& l, const auto* r)
+    {
+        if (r == nullptr)
+            callback(l.key, l.value);
+    });
+}
+
+
+template<class L, class R>
+IntersectView<SortedRangeIterator<L>, SortedRangeIterator<R>> MakeIntersectView(const L& left, const R& right)
+{
+    return IntersectView<SortedRangeIterator<L>, SortedRangeIterator<R>>(SortedRange::Begin(left), SortedRange::End(left), SortedRange::Begin(right), SortedRange::End(right));
+}
+
+
+template<class L, class R>
+UnionView<SortedRangeIterator<L>, SortedRangeIterator<R>> MakeUnionView(const L& left, const R& right)
+{
+    return UnionView<SortedRangeIterator<L>, SortedRangeIterator<R>>(SortedRange::Begin(left), SortedRange::End(left), SortedRange::Begin(right), SortedRange::End(right));
+}
+
+
+template<class L, class R>
+DifferenceView<SortedRangeIterator<L>, SortedRangeIterator<R>> MakeDifferenceView(const L& left, const R& right)
+{
+    return DifferenceView<SortedRangeIterator<L>, SortedRangeIterator<R>>(SortedRange::Begin(left), SortedRange::End(left), SortedRange::Begin(right), SortedRange::End(right));
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
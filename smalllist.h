@@ -0,0 +1,697 @@
+#ifndef _SMALLLIST_H_
+#define _SMALLLIST_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <utility>
+#include "list.h"
+
+/* SmallList
+
+   Bob Burrough, 2021
+
+   A List<T> with a small-buffer optimization. Up to N items are stored in
+   an array inside the SmallList object itself, so a list which never grows
+   past N items never allocates. When an insertion would exceed N items,
+   the items move into an ordinary List<T>, and the list stays there until
+   it's cleared. The interface is that of List<T>, except that Splice(),
+   SpliceFront() and SplitAfter() take and return SmallLists. Operations
+   which link nodes behave the same in both representations; splicing
+   spills both lists unless the result fits inline.
+
+   The tree equivalent is SmallAVLTree<T, N>; see adaptiveset.h. */
+
+
+template<class T, size_t N = 8>
+class SmallList
+{
+public:
+    class ConstIterator;
+
+    SmallList();
+    SmallList(std::initializer_list<T> l); // initialize SmallList with a static array of values
+    virtual ~SmallList(); // custom destructor (rule of 5)
+    SmallList(const SmallList& other); // copy constructor (rule of 5)
+    SmallList<T, N>& operator=(const SmallList& other); // copy assignment operator (rule of 5)
+    SmallList(SmallList<T, N>&& other); // move constructor (rule of 5)
+    SmallList<T, N>& operator=(SmallList&& other); // move assignment operator (rule of 5)
+
+    // Insert an item at the front of the list. O(N) while inline, O(1) after.
+    void Insert(const T& item);
+
+    // Append an item to the end of the list. O(1)
+    void Append(const T& item);
+
+    /* Insert an item after position, and return an iterator to it. If
+       position is end(), the item is inserted at the front. O(N) while
+       inline, O(1) after. */
+    ConstIterator InsertAfter(const ConstIterator& position, const T& item);
+
+    /* Remove the item after position, and return an iterator to the item
+       which followed it. If position is end(), the front item is removed.
+       O(N) while inline, O(1) after. */
+    ConstIterator EraseAfter(const ConstIterator& position);
+
+    // Remove the item at the front of the list, if there is one. O(N) while inline, O(1) after.
+    void PopFront();
+
+    // The first and last items. The list must not be empty. O(1)
+    T& Front();
+    const T& Front() const;
+    T& Back();
+    const T& Back() const;
+
+    // See List<T>::SetSpareNodeLimit(). Applies once the list has spilled into nodes.
+    void SetSpareNodeLimit(size_t limit);
+
+    // Moves every item of other to the end of this list, leaving other empty. O(1) once spilled.
+    void Splice(SmallList<T, N>&& other);
+
+    // Moves every item of other to the front of this list, leaving other empty. O(1) once spilled.
+    void SpliceFront(SmallList<T, N>&& other);
+
+    // Moves the items after position into a new list, which is returned. See List<T>::SplitAfter().
+    SmallList<T, N> SplitAfter(const ConstIterator& position);
+
+    // Reverses the list. O(n)
+    void Reverse();
+
+    // Sorts the list in ascending order. Stable. An insertion sort while inline; see List<T>::Sort() after.
+    void Sort();
+
+    // As above, ordered by compare(lhs, rhs), which returns true if lhs belongs before rhs.
+    template<class Compare>
+    void Sort(Compare compare);
+
+    // Removes all but the first of each run of equal items. O(n)
+    void Unique();
+
+    // returns true if the list contains no elements
+    bool IsEmpty() const;
+
+    // returns the number of elements contained in the list
+    size_t Size() const;
+
+    // returns true if the items are stored inside the SmallList object
+    bool IsInline() const;
+
+    // empties the list of all elements, returning it to inline storage
+    void Clear();
+
+    /* Consistency check. Returns true if the list
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+protected:
+private:
+    T* InlineItems();
+    const T* InlineItems() const;
+    void CopyFrom(const SmallList& other);
+    void MoveFrom(SmallList& other);
+    void Spill(); // Moves the inline items into nodes.
+    void Splice(SmallList<T, N>& other, bool front);
+
+    size_t inlineSize;
+    alignas(T) unsigned char inlineStorage[sizeof(T) * N];
+    bool spilled;
+    List<T> nodes;
+
+    // Iterator declarations
+public:
+    class ConstIterator
+    {
+    public:
+        ConstIterator(const T* pointer_); // Over the inline items.
+        ConstIterator(const typename List<T>::ConstIterator& nodeItr_); // Over the nodes.
+        ConstIterator& operator++();
+        bool operator==(const ConstIterator& other) const;
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+        friend class SmallList<T, N>;
+
+    protected:
+    private:
+        const T* pointer; // nullptr when iterating over nodes
+        typename List<T>::ConstIterator nodeItr;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+
+template<class T, size_t N>
+SmallList<T, N>::SmallList()
+    : inlineSize(0), spilled(false)
+{}
+
+
+template<class T, size_t N>
+SmallList<T, N>::SmallList(std::initializer_list<T> l)
+    : inlineSize(0), spilled(false)
+{
+    for (const auto& x : l)
+        Append(x);
+}
+
+
+template<class T, size_t N>
+SmallList<T, N>::~SmallList()
+{
+    Clear();
+}
+
+
+template<class T, size_t N>
+SmallList<T, N>::SmallList(const SmallList<T, N>& other) // copy constructor
+    : inlineSize(0), spilled(false)
+{
+    CopyFrom(other);
+}
+
+
+template<class T, size_t N>
+SmallList<T, N>& SmallList<T, N>::operator=(const SmallList& other) // copy assignment operator
+{
+    if (this == &other)
+        return *this;
+    Clear();
+    CopyFrom(other);
+    return *this;
+}
+
+
+template<class T, size_t N>
+SmallList<T, N>::SmallList(SmallList<T, N>&& other) // move constructor
+    : inlineSize(0), spilled(false)
+{
+    MoveFrom(other);
+}
+
+
+template<class T, size_t N>
+SmallList<T, N>& SmallList<T, N>::operator=(SmallList&& other) // move assignment operator
+{
+    if (this == &other)
+        return *this;
+    Clear();
+    MoveFrom(other);
+    return *this;
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::CopyFrom(const SmallList& other)
+{
+    spilled = other.spilled;
+    nodes = other.nodes;
+    for (size_t i = 0; i < other.inlineSize; i++)
+        new (InlineItems() + i) T(other.InlineItems()[i]);
+    inlineSize = other.inlineSize;
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::MoveFrom(SmallList& other)
+{
+    spilled = other.spilled;
+    nodes = std::move(other.nodes);
+    for (size_t i = 0; i < other.inlineSize; i++)
+        new (InlineItems() + i) T(std::move(other.InlineItems()[i]));
+    inlineSize = other.inlineSize;
+    other.Clear();
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::Insert(const T& item)
+{
+    if (!spilled && inlineSize == N)
+        Spill();
+    if (spilled)
+    {
+        nodes.Insert(item);
+        return;
+    }
+
+    T* items = InlineItems();
+    if (inlineSize == 0)
+    {
+        new (items) T(item);
+    }
+    else
+    {
+        T copy(item); // item may refer into this list.
+        new (items + inlineSize) T(std::move(items[inlineSize - 1]));
+        for (size_t i = inlineSize - 1; i > 0; i--)
+            items[i] = std::move(items[i - 1]);
+        items[0] = std::move(copy);
+    }
+    inlineSize++;
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::Append(const T& item)
+{
+    if (!spilled && inlineSize == N)
+        Spill();
+    if (spilled)
+    {
+        nodes.Append(item);
+        return;
+    }
+    new (InlineItems() + inlineSize) T(item);
+    inlineSize++;
+}
+
+
+template<class T, size_t N>
+typename SmallList<T, N>::ConstIterator SmallList<T, N>::InsertAfter(const ConstIterator& position, const T& item)
+{
+    if (spilled)
+        return ConstIterator(nodes.InsertAfter(position.nodeItr, item));
+
+    bool front = !(position != end());
+
+    size_t index = front ? 0 : position.pointer - InlineItems() + 1; // Where the item goes.
+    if (inlineSize == N)
+    {
+        Spill();
+        typename List<T>::ConstIterator previous = nodes.end();
+        if (index > 0)
+        {
+            previous = nodes.begin();
+            for (size_t i = 1; i < index; i++)
+                ++previous;
+        }
+        return ConstIterator(nodes.InsertAfter(previous, item));
+    }
+
+    T* items = InlineItems();
+    T copy(item); // item may refer into this list.
+    if (index == inlineSize)
+    {
+        new (items + inlineSize) T(std::move(copy));
+    }
+    else
+    {
+        new (items + inlineSize) T(std::move(items[inlineSize - 1]));
+        for (size_t i = inlineSize - 1; i > index; i--)
+            items[i] = std::move(items[i - 1]);
+        items[index] = std::move(copy);
+    }
+    inlineSize++;
+    return ConstIterator(items + index);
+}
+
+
+template<class T, size_t N>
+typename SmallList<T, N>::ConstIterator SmallList<T, N>::EraseAfter(const ConstIterator& position)
+{
+    if (spilled)
+        return ConstIterator(nodes.EraseAfter(position.nodeItr));
+
+    bool front = !(position != end());
+
+    size_t index = front ? 0 : position.pointer - InlineItems() + 1; // The item to remove.
+    T* items = InlineItems();
+    if (index >= inlineSize)
+        return end();
+    for (size_t i = index; i + 1 < inlineSize; i++)
+        items[i] = std::move(items[i + 1]);
+    items[--inlineSize].~T();
+    return ConstIterator(items + index);
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::PopFront()
+{
+    EraseAfter(end());
+}
+
+
+template<class T, size_t N>
+T& SmallList<T, N>::Front()
+{
+    return spilled ? nodes.Front() : InlineItems()[0];
+}
+
+
+template<class T, size_t N>
+const T& SmallList<T, N>::Front() const
+{
+    return spilled ? nodes.Front() : InlineItems()[0];
+}
+
+
+template<class T, size_t N>
+T& SmallList<T, N>::Back()
+{
+    return spilled ? nodes.Back() : InlineItems()[inlineSize - 1];
+}
+
+
+template<class T, size_t N>
+const T& SmallList<T, N>::Back() const
+{
+    return spilled ? nodes.Back() : InlineItems()[inlineSize - 1];
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::SetSpareNodeLimit(size_t limit)
+{
+    nodes.SetSpareNodeLimit(limit);
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::Splice(SmallList<T, N>&& other)
+{
+    Splice(other, false);
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::SpliceFront(SmallList<T, N>&& other)
+{
+    Splice(other, true);
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::Splice(SmallList<T, N>& other, bool front)
+{
+    if (this == &other || other.IsEmpty())
+        return;
+    if (!spilled && !other.spilled && inlineSize + other.inlineSize <= N)
+    {
+        // The result fits inline. Move the items across.
+        T* items = InlineItems();
+        T* otherItems = other.InlineItems();
+        if (front)
+        {
+            for (size_t i = inlineSize; i > 0; i--)
+            {
+                new (items + i - 1 + other.inlineSize) T(std::move(items[i - 1]));
+                items[i - 1].~T();
+            }
+            for (size_t i = 0; i < other.inlineSize; i++)
+                new (items + i) T(std::move(otherItems[i]));
+        }
+        else
+        {
+            for (size_t i = 0; i < other.inlineSize; i++)
+                new (items + inlineSize + i) T(std::move(otherItems[i]));
+        }
+        inlineSize += other.inlineSize;
+        other.Clear();
+        return;
+    }
+
+    if (!spilled)
+        Spill();
+    if (!other.spilled)
+        other.Spill();
+    if (front)
+        nodes.SpliceFront(std::move(other.nodes));
+    else
+        nodes.Splice(std::move(other.nodes));
+    other.Clear();
+}
+
+
+template<class T, size_t N>
+SmallList<T, N> SmallList<T, N>::SplitAfter(const ConstIterator& position)
+{
+    SmallList<T, N> rest;
+    if (!(position != end()))
+        return rest;
+    if (spilled)
+    {
+        rest.nodes = nodes.SplitAfter(position.nodeItr);
+        rest.spilled = !rest.nodes.IsEmpty();
+        return rest;
+    }
+
+    T* items = InlineItems();
+    size_t first = position.pointer - items + 1;
+    for (size_t i = first; i < inlineSize; i++)
+    {
+        new (rest.InlineItems() + rest.inlineSize++) T(std::move(items[i]));
+        items[i].~T();
+    }
+    inlineSize = first;
+    return rest;
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::Spill()
+{
+    T* items = InlineItems();
+    for (size_t i = 0; i < inlineSize; i++)
+    {
+        nodes.Append(items[i]);
+        items[i].~T();
+    }
+    inlineSize = 0;
+    spilled = true;
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::Reverse()
+{
+    if (spilled)
+    {
+        nodes.Reverse();
+        return;
+    }
+    T* items = InlineItems();
+    for (size_t i = 0, j = inlineSize; i + 1 < j; i++, j--)
+    {
+        using std::swap;
+        swap(items[i], items[j - 1]);
+    }
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::Sort()
+{
+    Sort([](const T& lhs, const T& rhs) { return lhs < rhs; });
+}
+
+
+template<class T, size_t N>
+template<class Compare>
+void SmallList<T, N>::Sort(Compare compare)
+{
+    if (spilled)
+    {
+        nodes.Sort(compare);
+        return;
+    }
+    T* items = InlineItems();
+    for (size_t i = 1; i < inlineSize; i++)
+    {
+        T item(std::move(items[i]));
+        size_t j = i;
+        for (; j > 0 && compare(item, items[j - 1]); j--)
+            items[j] = std::move(items[j - 1]);
+        items[j] = std::move(item);
+    }
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::Unique()
+{
+    if (spilled)
+    {
+        nodes.Unique();
+        return;
+    }
+    T* items = InlineItems();
+    if (inlineSize == 0)
+        return;
+    size_t kept = 1;
+    for (size_t i = 1; i < inlineSize; i++)
+    {
+        if (!(items[i] == items[kept - 1]))
+        {
+            if (i != kept)
+                items[kept] = std::move(items[i]);
+            kept++;
+        }
+    }
+    for (size_t i = kept; i < inlineSize; i++)
+        items[i].~T();
+    inlineSize = kept;
+}
+
+
+template<class T, size_t N>
+bool SmallList<T, N>::IsEmpty() const
+{
+    return Size() == 0;
+}
+
+
+template<class T, size_t N>
+size_t SmallList<T, N>::Size() const
+{
+    return spilled ? nodes.Size() : inlineSize;
+}
+
+
+template<class T, size_t N>
+bool SmallList<T, N>::IsInline() const
+{
+    return !spilled;
+}
+
+
+template<class T, size_t N>
+void SmallList<T, N>::Clear()
+{
+    T* items = InlineItems();
+    for (size_t i = 0; i < inlineSize; i++)
+        items[i].~T();
+    inlineSize = 0;
+    nodes.Clear();
+    spilled = false;
+}
+
+
+template<class T, size_t N>
+T* SmallList<T, N>::InlineItems()
+{
+    return reinterpret_cast<T*>(inlineStorage);
+}
+
+
+template<class T, size_t N>
+const T* SmallList<T, N>::InlineItems() const
+{
+    return reinterpret_cast<const T*>(inlineStorage);
+}
+
+
+template<class T, size_t N>
+SmallList<T, N>::ConstIterator::ConstIterator(const T* pointer_)
+    : pointer(pointer_), nodeItr()
+{}
+
+
+template<class T, size_t N>
+SmallList<T, N>::ConstIterator::ConstIterator(const typename List<T>::ConstIterator& nodeItr_)
+    : pointer(nullptr), nodeItr(nodeItr_)
+{}
+
+
+template<class T, size_t N>
+typename SmallList<T, N>::ConstIterator& SmallList<T, N>::ConstIterator::operator++()
+{
+    if (pointer != nullptr)
+        ++pointer;
+    else
+        ++nodeItr;
+    return *this;
+}
+
+
+template<class T, size_t N>
+bool SmallList<T, N>::ConstIterator::operator==(const ConstIterator& other) const
+{
+    return pointer == other.pointer && nodeItr == other.nodeItr;
+}
+
+
+template<class T, size_t N>
+bool SmallList<T, N>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return !(*this == other);
+}
+
+
+template<class T, size_t N>
+const T& SmallList<T, N>::ConstIterator::operator*() const
+{
+    return pointer != nullptr ? *pointer : *nodeItr;
+}
+
+
+template<class T, size_t N>
+typename SmallList<T, N>::ConstIterator SmallList<T, N>::begin() const
+{
+    return spilled ? ConstIterator(nodes.begin()) : ConstIterator(InlineItems());
+}
+
+
+template<class T, size_t N>
+typename SmallList<T, N>::ConstIterator SmallList<T, N>::end() const
+{
+    return spilled ? ConstIterator(nodes.end()) : ConstIterator(InlineItems() + inlineSize);
+}
+
+
+template<class T, size_t N>
+bool SmallList<T, N>::IsValid() const
+{
+    if (spilled)
+        return inlineSize == 0 && nodes.IsValid();
+    return inlineSize <= N && nodes.IsEmpty();
+}
+
+
+template class SmallList<int>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif
@@ -0,0 +1,458 @@
+#ifndef _UNROLLEDLIST_H_
+#define _UNROLLEDLIST_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+/* UnrolledList
+
+   Bob Burrough, 2021
+
+   Implementation of an unrolled singly-linked list. Each node holds up to K
+   items in a contiguous block, so iteration walks through memory instead of
+   chasing a pointer per item, and the per-item overhead of the next pointer
+   and allocation header is divided by K. The interface matches List<T>.
+
+   Items occupy the range [first, last) of their node's block. Append fills
+   the tail node forward from the start of its block, and Insert fills the
+   head node backward from the end of its block, so both are O(1). */
+
+
+template<class T, size_t K = 16>
+class UnrolledList
+{
+    static_assert(K > 0, "UnrolledList requires at least one item per node.");
+
+public:
+    UnrolledList();
+    UnrolledList(std::initializer_list<T> l); // initialize UnrolledList with a static array of values
+    virtual ~UnrolledList(); // custom destructor (rule of 5)
+    UnrolledList(const UnrolledList& other); // copy constructor (rule of 5)
+    UnrolledList<T, K>& operator=(const UnrolledList& other); // copy assignment operator (rule of 5)
+    UnrolledList(UnrolledList<T, K>&& other); // move constructor (rule of 5)
+    UnrolledList<T, K>& operator=(UnrolledList&& other); // move assignment operator (rule of 5)
+
+    // Insert an item at the front of the list. O(1)
+    void Insert(const T& item);
+
+    // Append an item to the end of the list. O(1)
+    void Append(const T& item);
+
+    // Append count items from an array to the end of the list, a block at a time. O(count)
+    void Append(const T* items, size_t count);
+
+    // Reverses the list. O(n)
+    void Reverse();
+
+    // returns true if the list contains no elements
+    bool IsEmpty() const;
+
+    // returns the number of elements contained in the list
+    size_t Size() const;
+
+    // empties the list of all elements
+    void Clear();
+
+    /* Consistency check. Returns true if the list
+       is internally consistent. Otherwise, false. */
+    bool IsValid() const;
+
+protected:
+private:
+    class Node
+    {
+    public:
+        Node(size_t start);
+
+        friend class UnrolledList<T, K>;
+
+    protected:
+    private:
+        Node() = delete; // A starting position is required to instantiate a node.
+        T* Items();
+        const T* Items() const;
+
+        Node* next;
+        size_t first; // Index of the first item in the block.
+        size_t last; // One past the index of the last item in the block.
+        alignas(T) unsigned char block[sizeof(T) * K];
+    };
+
+    void DestroyNode(Node* node);
+    void AppendNode(Node* node);
+
+    Node* head;
+    Node* tail;
+    size_t size;
+
+    // Iterator declarations
+public:
+    class ConstIterator
+    {
+    public:
+        ConstIterator();
+        ConstIterator(Node* start);
+        ConstIterator& operator++();
+        bool operator==(const ConstIterator& other) const;
+        bool operator!=(const ConstIterator& other) const;
+        const T& operator*() const;
+
+    protected:
+    private:
+        Node* current;
+        size_t index;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+
+template<class T, size_t K>
+UnrolledList<T, K>::UnrolledList()
+    : head(nullptr), tail(nullptr), size(0)
+{}
+
+
+template<class T, size_t K>
+UnrolledList<T, K>::UnrolledList(std::initializer_list<T> l)
+    : head(nullptr), tail(nullptr), size(0)
+{
+    Append(l.begin(), l.size());
+}
+
+
+template<class T, size_t K>
+UnrolledList<T, K>::~UnrolledList()
+{
+    Clear();
+}
+
+
+template<class T, size_t K>
+void UnrolledList<T, K>::Clear()
+{
+    Node* current = head;
+    while (current != nullptr)
+    {
+        Node* next = current->next;
+        DestroyNode(current);
+        current = next;
+    }
+    head = nullptr;
+    tail = nullptr;
+    size = 0;
+}
+
+
+template<class T, size_t K>
+UnrolledList<T, K>::UnrolledList(const UnrolledList<T, K>& other) // copy constructor
+    : head(nullptr), tail(nullptr), size(0)
+{
+    for (const Node* current = other.head; current != nullptr; current = current->next)
+        Append(current->Items() + current->first, current->last - current->first);
+}
+
+
+template<class T, size_t K>
+UnrolledList<T, K>& UnrolledList<T, K>::operator=(const UnrolledList& other) // copy assignment operator
+{
+    if (this == &other)
+        return *this;
+    Clear();
+    for (const Node* current = other.head; current != nullptr; current = current->next)
+        Append(current->Items() + current->first, current->last - current->first);
+    return *this;
+}
+
+
+template<class T, size_t K>
+UnrolledList<T, K>::UnrolledList(UnrolledList<T, K>&& other) // move constructor
+    : head(other.head), tail(other.tail), size(other.size)
+{
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+}
+
+
+template<class T, size_t K>
+UnrolledList<T, K>& UnrolledList<T, K>::operator=(UnrolledList&& other) // move assignment operator
+{
+    Clear();
+    head = other.head;
+    tail = other.tail;
+    size = other.size;
+
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+
+    return *this;
+}
+
+
+template<class T, size_t K>
+void UnrolledList<T, K>::Insert(const T& item)
+{
+    if (head == nullptr || head->first == 0)
+    {
+        Node* node = new Node(K); // Fill backward from the end of the block.
+        node->next = head;
+        head = node;
+        if (tail == nullptr)
+            tail = node;
+    }
+    new (head->Items() + head->first - 1) T(item);
+    head->first--;
+    size++;
+}
+
+
+template<class T, size_t K>
+void UnrolledList<T, K>::Append(const T& item)
+{
+    if (tail == nullptr || tail->last == K)
+        AppendNode(new Node(0));
+    new (tail->Items() + tail->last) T(item);
+    tail->last++;
+    size++;
+}
+
+
+template<class T, size_t K>
+void UnrolledList<T, K>::Append(const T* items, size_t count)
+{
+    while (count > 0)
+    {
+        if (tail == nullptr || tail->last == K)
+            AppendNode(new Node(0));
+        size_t room = K - tail->last;
+        size_t copies = count < room ? count : room;
+        T* destination = tail->Items() + tail->last;
+        for (size_t i = 0; i < copies; i++)
+            new (destination + i) T(items[i]);
+        tail->last += copies;
+        size += copies;
+        items += copies;
+        count -= copies;
+    }
+}
+
+
+template<class T, size_t K>
+void UnrolledList<T, K>::AppendNode(Node* node)
+{
+    if (head == nullptr)
+        head = node;
+    if (tail != nullptr)
+        tail->next = node;
+    tail = node;
+}
+
+
+template<class T, size_t K>
+void UnrolledList<T, K>::Reverse()
+{
+    Node* current = head;
+    Node* previous = nullptr;
+    Node* next = nullptr;
+    while (current != nullptr)
+    {
+        // Reverse the items within the block, then the links between blocks.
+        T* items = current->Items();
+        for (size_t i = current->first, j = current->last - 1; i < j; i++, j--)
+        {
+            using std::swap;
+            swap(items[i], items[j]);
+        }
+
+        next = current->next;
+        current->next = previous;
+
+        previous = current;
+        current = next;
+    }
+    Node* temp = head;
+    head = tail;
+    tail = temp;
+}
+
+
+template<class T, size_t K>
+bool UnrolledList<T, K>::IsEmpty() const
+{
+    return size == 0;
+}
+
+
+template<class T, size_t K>
+size_t UnrolledList<T, K>::Size() const
+{
+    return size;
+}
+
+
+template<class T, size_t K>
+void UnrolledList<T, K>::DestroyNode(Node* node)
+{
+    T* items = node->Items();
+    for (size_t i = node->first; i < node->last; i++)
+        items[i].~T();
+    delete node;
+}
+
+
+template<class T, size_t K>
+UnrolledList<T, K>::Node::Node(size_t start)
+    : next(nullptr), first(start), last(start)
+{}
+
+
+template<class T, size_t K>
+T* UnrolledList<T, K>::Node::Items()
+{
+    return reinterpret_cast<T*>(block);
+}
+
+
+template<class T, size_t K>
+const T* UnrolledList<T, K>::Node::Items() const
+{
+    return reinterpret_cast<const T*>(block);
+}
+
+
+template<class T, size_t K>
+UnrolledList<T, K>::ConstIterator::ConstIterator() // This also happens to be equivalent to UnrolledList<T, K>::end()
+    : current(nullptr), index(0)
+{}
+
+
+template<class T, size_t K>
+UnrolledList<T, K>::ConstIterator::ConstIterator(Node* start)
+    : current(start), index(start != nullptr ? start->first : 0)
+{}
+
+
+template<class T, size_t K>
+typename UnrolledList<T, K>::ConstIterator& UnrolledList<T, K>::ConstIterator::operator++()
+{
+    index++;
+    if (index == current->last)
+    {
+        current = current->next;
+        index = current != nullptr ? current->first : 0;
+    }
+    return *this;
+}
+
+
+template<class T, size_t K>
+bool UnrolledList<T, K>::ConstIterator::operator==(const ConstIterator& other) const
+{
+    return (current == other.current && index == other.index);
+}
+
+
+template<class T, size_t K>
+bool UnrolledList<T, K>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return !(current == other.current && index == other.index);
+}
+
+
+template<class T, size_t K>
+const T& UnrolledList<T, K>::ConstIterator::operator*() const
+{
+    return current->Items()[index];
+}
+
+
+template<class T, size_t K>
+typename UnrolledList<T, K>::ConstIterator UnrolledList<T, K>::begin() const
+{
+    return ConstIterator(head);
+}
+
+
+template<class T, size_t K>
+typename UnrolledList<T, K>::ConstIterator UnrolledList<T, K>::end() const
+{
+    return ConstIterator(nullptr);
+}
+
+
+template<class T, size_t K>
+bool UnrolledList<T, K>::IsValid() const
+{
+    if (head != nullptr && tail == nullptr)
+        return false;
+    if (head == nullptr && tail != nullptr)
+        return false;
+
+    size_t elementCount(0);
+    Node* current = head;
+    while (current != nullptr)
+    {
+        if (current->first >= current->last || current->last > K)
+            return false; // Every node holds at least one item.
+        elementCount += current->last - current->first;
+        if (current->next == nullptr && tail != current)
+            return false;
+        current = current->next;
+    }
+    if (Size() != elementCount)
+        return false;
+
+    return true;
+}
+
+
+template class UnrolledList<int>; // To force compilation of the template, for compile-time validation.
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2021 Bobby G. Burrough
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+#endif